@@ -0,0 +1,492 @@
+/** ************************************************************* *
+ * @file        API_actuator.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "API_actuator.h"
+#include "API_motion.h"
+#include "API_trace.h"
+#include "API_health.h"
+#include "API_latency.h"
+#include "freeRtos.h"
+#include "task.h"
+#include "gpio.h"
+#include "tim.h"
+#include "queue.h"
+
+#include "MS1_config.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* task notification bits */
+#define ACTUATOR_EVENT_CMD      (1u << 0)   /* new command in the queue */
+#define ACTUATOR_EVENT_END      (1u << 1)   /* end stop reached */
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* List of the motor channels */
+typedef enum
+{
+    E_ACTUATOR_M1,
+    E_ACTUATOR_M2,
+    E_ACTUATOR_NB
+}ENUM_ACTUATOR_CHANNEL_t;
+
+/* hardware of a motor channel */
+typedef struct
+{
+    GPIO_TypeDef*           dir_port;
+    uint16_t                dir_pin;
+    GPIO_PinState           dir_open;       /* direction level to open */
+    GPIO_TypeDef*           en_port;
+    uint16_t                en_pin;
+    TIM_HandleTypeDef*      htim;
+    uint32_t                tim_channel;
+    ENUM_MOTION_CHANNEL_t   motion;         /* ramp profile channel */
+    GPIO_TypeDef*           end_port;
+    uint16_t                end_open;       /* end stops pins (active low) */
+    uint16_t                end_close;
+}STRUCT_ACTUATOR_CHANNEL_t;
+
+/* state of a motor channel, shared with the end stops interrupt */
+typedef struct
+{
+    ENUM_ACTUATOR_CMD_t     motion;         /* motion in progress */
+    ENUM_ACTUATOR_STATUS_t  end;            /* end stop seen by the interrupt */
+}STRUCT_ACTUATOR_STATE_t;
+
+/* command sent to the task */
+typedef struct
+{
+    ENUM_ACTUATOR_USER_t    user;
+    ENUM_ACTUATOR_CMD_t     cmd;
+}STRUCT_ACTUATOR_REQUEST_t;
+
+/* ------------------------------------------------------------- --
+   handles
+-- ------------------------------------------------------------- */
+TaskHandle_t TaskHandle_actuator;
+QueueHandle_t QueueHandle_actuator_cmd;
+QueueHandle_t QueueHandle_actuator_mntr[E_ACTUATOR_USER_NB];
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+/* Both motors drive the same mechanism, the open (resp. close) 
+ * point is reached as soon as one of its end stops is pressed */
+static const STRUCT_ACTUATOR_CHANNEL_t actuator_channel[E_ACTUATOR_NB] =
+{
+    [E_ACTUATOR_M1] =
+    {
+        .dir_port  = DIR_M1_GPIO_Port,  .dir_pin = DIR_M1_Pin,  .dir_open = GPIO_PIN_SET,
+        .en_port   = EN_M1_GPIO_Port,   .en_pin  = EN_M1_Pin,
+        .htim      = &htim2,            .tim_channel = TIM_CHANNEL_1,
+        .motion    = E_MOTION_M1,
+        .end_port  = END_11_GPIO_Port,
+        .end_open  = END_11_Pin | END_12_Pin,
+        .end_close = END_21_Pin | END_22_Pin
+    },
+    [E_ACTUATOR_M2] =
+    {
+        .dir_port  = DIR_M2_GPIO_Port,  .dir_pin = DIR_M2_Pin,  .dir_open = GPIO_PIN_SET,
+        .en_port   = EN_M2_GPIO_Port,   .en_pin  = EN_M2_Pin,
+        .htim      = &htim3,            .tim_channel = TIM_CHANNEL_3,
+        .motion    = E_MOTION_M2,
+        .end_port  = END_11_GPIO_Port,
+        .end_open  = END_11_Pin | END_12_Pin,
+        .end_close = END_21_Pin | END_22_Pin
+    }
+};
+
+static volatile STRUCT_ACTUATOR_STATE_t actuator_state[E_ACTUATOR_NB] = {0};
+
+/* user owning the motors while a motion is in progress */
+static ENUM_ACTUATOR_USER_t actuator_owner = E_ACTUATOR_USER_PAYLOAD;
+
+static STRUCT_ACTUATOR_MNTR_t actuator_mntr[E_ACTUATOR_USER_NB] = {0};
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static void handler_actuator(void* parameters);
+
+static void process_request(STRUCT_ACTUATOR_REQUEST_t request);
+static void check_position(void);
+static bool is_running(void);
+static void start_channel(ENUM_ACTUATOR_CHANNEL_t channel, ENUM_ACTUATOR_CMD_t cmd);
+static void stop_channel(ENUM_ACTUATOR_CHANNEL_t channel);
+static void stop_all(void);
+static void publish(ENUM_ACTUATOR_USER_t user);
+
+/* ============================================================= ==
+   tasks functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       This task drives the motors shared by the recovery
+ *              and the payload systems. The commands of the users
+ *              are arbitrated by priority (ENUM_ACTUATOR_USER_t).
+ *              The motors are stopped by the end stops interrupt,
+ *              the task only waits for notifications.
+ * 
+ * @param       parameters 
+ * ************************************************************* **/
+static void handler_actuator(void* parameters)
+{
+    STRUCT_ACTUATOR_REQUEST_t request;
+    uint32_t events;
+
+    /* publish the initial position */
+    check_position();
+
+    while(1)
+    {
+        /* wait for a command or an end stop */
+        xTaskNotifyWait(0, UINT32_MAX, &events, portMAX_DELAY);
+
+        /* check for new command */
+        if(events & ACTUATOR_EVENT_CMD)
+        {
+            while(xQueueReceive(QueueHandle_actuator_cmd, &request, (TickType_t)0)) 
+            {
+                process_request(request);
+            }
+        }
+
+        /* check if the system has reach the end */
+        if(events & ACTUATOR_EVENT_END)
+        {
+            check_position();
+        }
+    }
+}
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       arbitrate and execute a command of a user
+ * 
+ * @param       request 
+ * ************************************************************* **/
+static void process_request(STRUCT_ACTUATOR_REQUEST_t request)
+{
+    if(request.user >= E_ACTUATOR_USER_NB || request.cmd == E_CMD_ACT_NONE) return;
+
+    API_TRACE_MARK(E_TRACE_ACTUATOR_CMD, ((uint32_t)request.user << 8) | request.cmd);
+
+    /* deploy chain */
+    if(request.user == E_ACTUATOR_USER_RECOVERY && request.cmd == E_CMD_ACT_OPEN)
+    {
+        API_LATENCY_MARK(E_LATENCY_ACTUATOR_DEQUEUE);
+    }
+
+    if(is_running() == true && request.user != actuator_owner)
+    {
+        /* a lower user can't take the motors */
+        if(request.user < actuator_owner)
+        {
+            publish(request.user);
+            return;
+        }
+
+        /* a higher user preempts the motion in progress */
+        stop_all();
+        actuator_mntr[actuator_owner].status = E_STATUS_ACT_STOP;
+        publish(actuator_owner);
+    }
+
+    switch(request.cmd)
+    {
+        case E_CMD_ACT_OPEN :
+        case E_CMD_ACT_CLOSE :
+            for(uint8_t i = 0; i < E_ACTUATOR_NB; i++)
+            {
+                start_channel((ENUM_ACTUATOR_CHANNEL_t)i, request.cmd);
+            }
+            if(request.user == E_ACTUATOR_USER_RECOVERY && request.cmd == E_CMD_ACT_OPEN)
+            {
+                API_LATENCY_MARK(E_LATENCY_MOTOR_ENABLE);
+            }
+            actuator_owner = request.user;
+            actuator_mntr[request.user].status = E_STATUS_ACT_RUNNING;
+            break;
+
+        case E_CMD_ACT_STOP :
+            stop_all();
+            actuator_mntr[request.user].status = E_STATUS_ACT_STOP;
+            break;
+
+        default :
+            break;
+    }
+
+    /* update monitoring queue */
+    actuator_mntr[request.user].last_cmd = request.cmd;
+    publish(request.user);
+
+    /* the end stop may already be reached (no edge) */
+    check_position();
+}
+
+/** ************************************************************* *
+ * @brief       read the end stops, stop the channels which have 
+ *              reached the end of their motion and publish the 
+ *              position to every user when all are stopped
+ * 
+ * ************************************************************* **/
+static void check_position(void)
+{
+    ENUM_ACTUATOR_STATUS_t position = E_STATUS_ACT_NONE;
+
+    for(uint8_t i = 0; i < E_ACTUATOR_NB; i++)
+    {
+        const STRUCT_ACTUATOR_CHANNEL_t* hw = &actuator_channel[i];
+        volatile STRUCT_ACTUATOR_STATE_t* state = &actuator_state[i];
+        ENUM_ACTUATOR_STATUS_t end = E_STATUS_ACT_NONE;
+        uint32_t pins = hw->end_port->IDR;
+
+        /* one end stop pressed (low) is enough */
+        if((pins & hw->end_open)  != hw->end_open)  end = E_STATUS_ACT_OPEN;
+        if((pins & hw->end_close) != hw->end_close) end = E_STATUS_ACT_CLOSE;
+
+        /* end stop seen by the interrupt (the switch may bounce) */
+        if(end == E_STATUS_ACT_NONE)
+        {
+            end = state->end;
+        }
+        state->end = E_STATUS_ACT_NONE;
+
+        taskENTER_CRITICAL();
+        if((state->motion == E_CMD_ACT_OPEN  && end == E_STATUS_ACT_OPEN)
+        || (state->motion == E_CMD_ACT_CLOSE && end == E_STATUS_ACT_CLOSE))
+        {
+            stop_channel((ENUM_ACTUATOR_CHANNEL_t)i);
+        }
+        taskEXIT_CRITICAL();
+
+        if(end != E_STATUS_ACT_NONE) position = end;
+    }
+
+    /* update system structure when not running */
+    if(is_running() == false && position != E_STATUS_ACT_NONE)
+    {
+        for(uint8_t i = 0; i < E_ACTUATOR_USER_NB; i++)
+        {
+            actuator_mntr[i].status = position;
+            publish((ENUM_ACTUATOR_USER_t)i);
+        }
+    }
+}
+
+/** ************************************************************* *
+ * @brief       check if a channel is in motion
+ * 
+ * @return      true    at least one channel is running 
+ * @return      false   all the channels are stopped 
+ * ************************************************************* **/
+static bool is_running(void)
+{
+    for(uint8_t i = 0; i < E_ACTUATOR_NB; i++)
+    {
+        if(actuator_state[i].motion != E_CMD_ACT_NONE) return true;
+    }
+    return false;
+}
+
+/** ************************************************************* *
+ * @brief       set the direction and start the ramp of a channel
+ * 
+ * @param       channel 
+ * @param       cmd     E_CMD_ACT_OPEN or E_CMD_ACT_CLOSE 
+ * ************************************************************* **/
+static void start_channel(ENUM_ACTUATOR_CHANNEL_t channel, ENUM_ACTUATOR_CMD_t cmd)
+{
+    const STRUCT_ACTUATOR_CHANNEL_t* hw = &actuator_channel[channel];
+    GPIO_PinState dir = hw->dir_open;
+
+    if(cmd == E_CMD_ACT_CLOSE)
+    {
+        dir = (dir == GPIO_PIN_SET) ? GPIO_PIN_RESET : GPIO_PIN_SET;
+    }
+
+    /* set the direction */
+    HAL_GPIO_WritePin(hw->dir_port, hw->dir_pin, dir);
+    actuator_state[channel].end    = E_STATUS_ACT_NONE;
+    actuator_state[channel].motion = cmd;
+
+    /* enable the pwm with the ramp profile */
+    API_MOTION_RUN(hw->motion);
+    HAL_TIM_PWM_Start(hw->htim, hw->tim_channel);
+
+    /* enable the motor */
+    HAL_GPIO_WritePin(hw->en_port, hw->en_pin, GPIO_PIN_SET);
+}
+
+/** ************************************************************* *
+ * @brief       stop the motor and the pwm of a channel.
+ *              Can be called from the end stops interrupt.
+ * 
+ * @param       channel 
+ * ************************************************************* **/
+static void stop_channel(ENUM_ACTUATOR_CHANNEL_t channel)
+{
+    const STRUCT_ACTUATOR_CHANNEL_t* hw = &actuator_channel[channel];
+
+    /* disable the motor */
+    HAL_GPIO_WritePin(hw->en_port, hw->en_pin, GPIO_PIN_RESET);
+
+    /* disable the pwm */
+    API_MOTION_STOP(hw->motion);
+    HAL_TIM_PWM_Stop(hw->htim, hw->tim_channel);
+
+    actuator_state[channel].motion = E_CMD_ACT_NONE;
+}
+
+/** ************************************************************* *
+ * @brief       stop all the channels
+ * 
+ * ************************************************************* **/
+static void stop_all(void)
+{
+    taskENTER_CRITICAL();
+    for(uint8_t i = 0; i < E_ACTUATOR_NB; i++)
+    {
+        stop_channel((ENUM_ACTUATOR_CHANNEL_t)i);
+    }
+    taskEXIT_CRITICAL();
+}
+
+/** ************************************************************* *
+ * @brief       update the monitoring queue of a user, the mailbox
+ *              keeps the last status
+ * 
+ * @param       user 
+ * ************************************************************* **/
+static void publish(ENUM_ACTUATOR_USER_t user)
+{
+    xQueueOverwrite(QueueHandle_actuator_mntr[user], &actuator_mntr[user]);
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       init and start the actuator task and the motion 
+ *              profile of the motors
+ * 
+ * ************************************************************* **/
+void API_ACTUATOR_START(void)
+{
+    BaseType_t status;
+
+    /* init the monitoring structures */
+    for(uint8_t i = 0; i < E_ACTUATOR_USER_NB; i++)
+    {
+        actuator_mntr[i].last_cmd = E_CMD_ACT_NONE;
+        actuator_mntr[i].status   = E_STATUS_ACT_NONE;
+    }
+
+    /* init the ramp profile of the motors */
+    API_MOTION_START();
+
+    /* create the queues, one command slot per user */
+    QueueHandle_actuator_cmd = xQueueCreate(E_ACTUATOR_USER_NB, sizeof(STRUCT_ACTUATOR_REQUEST_t));
+    API_HEALTH_ADD_QUEUE(QueueHandle_actuator_cmd);
+    for(uint8_t i = 0; i < E_ACTUATOR_USER_NB; i++)
+    {
+        QueueHandle_actuator_mntr[i] = xQueueCreate(1, sizeof(STRUCT_ACTUATOR_MNTR_t));
+    }
+
+    /* create the task */
+    status = xTaskCreate(handler_actuator, "task_actuator", TASK_STACK_ACTUATOR, NULL, TASK_PRIORITY_ACTUATOR, &TaskHandle_actuator);
+    configASSERT(status == pdPASS);
+}
+
+/** ************************************************************* *
+ * @brief       send a command of a user to the actuator task
+ * 
+ * @param       user 
+ * @param       command 
+ * ************************************************************* **/
+void API_ACTUATOR_SEND_CMD(ENUM_ACTUATOR_USER_t user, ENUM_ACTUATOR_CMD_t command)
+{
+    STRUCT_ACTUATOR_REQUEST_t request = {.user = user, .cmd = command};
+
+    xQueueSend(QueueHandle_actuator_cmd, &request, (TickType_t)0);
+    xTaskNotify(TaskHandle_actuator, ACTUATOR_EVENT_CMD, eSetBits);
+}
+
+/** ************************************************************* *
+ * @brief       get the status seen by a user
+ * 
+ * @param       user 
+ * @param       monitoring 
+ * @return      true    new status received 
+ * @return      false   nothing received 
+ * ************************************************************* **/
+bool API_ACTUATOR_GET_MNTR(ENUM_ACTUATOR_USER_t user, STRUCT_ACTUATOR_MNTR_t* monitoring)
+{
+    if(user >= E_ACTUATOR_USER_NB) return false;
+
+    return (xQueueReceive(QueueHandle_actuator_mntr[user], monitoring, (TickType_t)0)) ? true : false;
+}
+
+/** ************************************************************* *
+ * @brief       This function must be called by the EXTI callback.
+ *              Each channel is stopped as soon as the end stop of 
+ *              its motion is reached, then the task is notified to
+ *              publish the new status.
+ * 
+ * @param       GPIO_Pin 
+ * ************************************************************* **/
+void API_ACTUATOR_CALLBACK_ISR(uint16_t GPIO_Pin)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    bool notify = false;
+
+    for(uint8_t i = 0; i < E_ACTUATOR_NB; i++)
+    {
+        const STRUCT_ACTUATOR_CHANNEL_t* hw = &actuator_channel[i];
+        volatile STRUCT_ACTUATOR_STATE_t* state = &actuator_state[i];
+        ENUM_ACTUATOR_STATUS_t end = E_STATUS_ACT_NONE;
+
+        if((GPIO_Pin & hw->end_open) && state->motion == E_CMD_ACT_OPEN)
+        {
+            end = E_STATUS_ACT_OPEN;
+        }
+        else if((GPIO_Pin & hw->end_close) && state->motion == E_CMD_ACT_CLOSE)
+        {
+            end = E_STATUS_ACT_CLOSE;
+        }
+
+        if(end != E_STATUS_ACT_NONE)
+        {
+            stop_channel((ENUM_ACTUATOR_CHANNEL_t)i);
+            state->end = end;
+            notify     = true;
+        }
+    }
+
+    if(notify == true)
+    {
+        API_TRACE_MARK(E_TRACE_ACTUATOR_END, GPIO_Pin);
+        xTaskNotifyFromISR(TaskHandle_actuator, ACTUATOR_EVENT_END, eSetBits, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    }
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
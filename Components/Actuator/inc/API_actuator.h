@@ -0,0 +1,74 @@
+/** ************************************************************* *
+ * @file        API_actuator.h
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef ACTUATOR_INC_API_ACTUATOR_H_
+#define ACTUATOR_INC_API_ACTUATOR_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* List of the systems sharing the motors, sorted by priority.
+ * A command of a user preempts the motion of a lower user and
+ * a command of a lower user is rejected while a higher one runs */
+typedef enum
+{
+    E_ACTUATOR_USER_PAYLOAD,
+    E_ACTUATOR_USER_RECOVERY,
+    E_ACTUATOR_USER_NB
+}ENUM_ACTUATOR_USER_t;
+
+/* List of commands available for this API. 
+ * -> Stop command      : will stop the motors 
+ * -> Open/Close command: will run the motors until reach the end */
+typedef enum
+{
+    E_CMD_ACT_NONE,
+    E_CMD_ACT_STOP,
+    E_CMD_ACT_OPEN,
+    E_CMD_ACT_CLOSE
+}ENUM_ACTUATOR_CMD_t;
+
+/* List of system status */
+typedef enum
+{
+    E_STATUS_ACT_NONE,          /* default state */
+    E_STATUS_ACT_STOP,          /* state when the system is stop */
+    E_STATUS_ACT_RUNNING,       /* state when the system is running */
+    E_STATUS_ACT_OPEN,          /* state when the system is opened */
+    E_STATUS_ACT_CLOSE          /* state when the system is closed */
+}ENUM_ACTUATOR_STATUS_t;
+
+/* monitoring structure of a user */
+typedef struct
+{
+    ENUM_ACTUATOR_CMD_t last_cmd;       /* last command accepted */
+    ENUM_ACTUATOR_STATUS_t status;      /* current status of the system */
+}STRUCT_ACTUATOR_MNTR_t;
+
+/* ------------------------------------------------------------- --
+   function propotypes
+-- ------------------------------------------------------------- */
+void API_ACTUATOR_START(void);
+void API_ACTUATOR_SEND_CMD(ENUM_ACTUATOR_USER_t user, ENUM_ACTUATOR_CMD_t command);
+bool API_ACTUATOR_GET_MNTR(ENUM_ACTUATOR_USER_t user, STRUCT_ACTUATOR_MNTR_t* monitoring);
+void API_ACTUATOR_CALLBACK_ISR(uint16_t GPIO_Pin);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* ACTUATOR_INC_API_ACTUATOR_H_ */
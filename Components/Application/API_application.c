@@ -18,71 +18,127 @@
 
 #include "FreeRTOS.h"
 #include "task.h"
-#include "timers.h"
 #include "gpio.h"
 
 #include "MS1_config.h"
 
 #include "API_application.h"
+#include "flight_fsm.h"
+#include "apogee_vote.h"
 #include "API_recovery.h"
 #include "API_payload.h"
 #include "API_buzzer.h"
 #include "API_HMI.h"
 #include "API_battery.h"
 #include "API_sensors.h"
+#include "API_gnss.h"
+#include "API_radio.h"
+#include "API_datalogger.h"
+#include "API_trace.h"
+#include "API_periodic.h"
+#include "API_latency.h"
+
+#include "payload_builder.h"
 
 /* ------------------------------------------------------------- --
    defines
 -- ------------------------------------------------------------- */
-/* buzzer settings */
-#define BUZZER_WAIT_PERIOD          1000u   /* [ms] */
-#define BUZZER_WAIT_DUTYCYCLE       0.5f    /* ratio */
-#define BUZZER_ASCEND_PERIOD        100u    /* [ms] */
-#define BUZZER_ASCEND_DUTYCYCLE     0.1f    /* ratio */
-#define BUZZER_DESCEND_PERIOD       1000u   /* [ms] */
-#define BUZZER_DESCEND_DUTYCYCLE    0.5f    /* ratio */
-
-/* windows settings */
-#define WINDOW_IN_TIME              6000u   /* [ms] */
-#define WINDOW_OUT_TIME             10000u  /* [ms] */
-
 /* include functions */
-#define APPLICATION_INC_FLAG_AEROC      1
-#define APPLICATION_INC_FLAG_WININ      1
-#define APPLICATION_INC_FLAG_WINOUT     1
-
 #define APPLICATION_INC_DATA_MPU6050    1
 #define APPLICATION_INC_DATA_BMP280     1
+#define APPLICATION_INC_DATA_GNSS       1
 
-#define APPLICATION_INC_MNTR_RECOV      0
-#define APPLICATION_INC_MNTR_PAYLOAD    0
-#define APPLICATION_INC_MNTR_BATTERY    0
+#define APPLICATION_INC_MNTR_RECOV      1
+#define APPLICATION_INC_MNTR_PAYLOAD    1
+#define APPLICATION_INC_MNTR_BATTERY    1
 
-#define APPLICATION_INC_LOG_DATALOG     0
-#define APPLICATION_INC_LOG_RADIO       0
+#define APPLICATION_INC_LOG_DATALOG     1
+#define APPLICATION_INC_LOG_RADIO       1
 
 #define APPLICATION_INC_USER_BTN        1
+#define APPLICATION_INC_UPLINK          1
+
+/* uplink commands */
+#define APPLICATION_ARMED_DEFAULT       true    /* aerocontact enabled at start */
+
+/* interrupt events */
+#define APPLICATION_EVENT_SIZE          16u     /* power of 2 */
+#define APPLICATION_EVENT_DEBOUNCE      20u     /* [ms] same event ignored */
+
+/* radio telemetry */
+#define APPLICATION_RADIO_ANGLE         100.0f  /* [0.01 deg / deg] */
+#define APPLICATION_RADIO_ALTITUDE      10.0f   /* [dm / m] */
+#define APPLICATION_RADIO_VOLT          1000.0f /* [mV / V] */
+
+/* decimated streams of the sensors */
+#define APPLICATION_STREAM_ANGLE        100     /* [0.01 deg / deg] */
+#define APPLICATION_STREAM_PRESSURE     10      /* [0.1 Pa / Pa] */
+
+/* flight log */
+#define APPLICATION_LOG_ANGLE           100.0f  /* [0.01 deg / deg] */
+#define APPLICATION_LOG_ALTITUDE        100.0f  /* [cm / m] */
+#define APPLICATION_LOG_TEMP            100.0f  /* [0.01 degC / degC] */
+#define APPLICATION_LOG_ANOMALY         2.5f    /* [g] shock on the pad : full rate log */
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* event sent by the interrupt callback */
+typedef struct
+{
+    ENUM_APP_ISR_ID_t ID;
+    uint32_t stamp;                             /* [cycle] interrupt time */
+}STRUCT_APP_EVENT_t;
 
 /* ------------------------------------------------------------- --
    handles
 -- ------------------------------------------------------------- */
 TaskHandle_t TaskHandle_application;
-
-TimerHandle_t TimerHandle_window_in;
-TimerHandle_t TimerHandle_window_out;
+TaskHandle_t TaskHandle_tlm_hmi;
+TaskHandle_t TaskHandle_tlm_radio;
 
 /* ------------------------------------------------------------- --
    variables
 -- ------------------------------------------------------------- */
-volatile bool flagAeroc;
-volatile bool flagWinIn;
-volatile bool flagWinOut;
-volatile bool flagDeploy;
-
-volatile ENUM_APP_ISR_ID_t userBtn;
+/* flight phase, the windows are timed from the liftoff */
+static STRUCT_FLIGHT_t flight;
+
+/* apogee vote during the coast : any two detectors, one of them of
+ * the barometer (tilt and free fall fire early in the coast) */
+static const STRUCT_APOGEE_CONFIG_t apogee_config = {
+    .weight = {
+        [E_APOGEE_BARO]     = 30,
+        [E_APOGEE_VELOCITY] = 30,
+        [E_APOGEE_TILT]     = 25,
+        [E_APOGEE_FREEFALL] = 25,
+    },
+    .quorum   = 50,
+    .required = (1u << E_APOGEE_BARO) | (1u << E_APOGEE_VELOCITY),
+};
+static STRUCT_APOGEE_t apogee;
+
+/* pre-trigger ring of the log committed (liftoff or anomaly) */
+static bool log_triggered = false;
+
+/* Single producer / single consumer ring of the interrupt events.
+ * The producers are the EXTI callbacks which share one priority 
+ * level, they can't preempt each other. */
+static STRUCT_APP_EVENT_t app_events[APPLICATION_EVENT_SIZE];
+static volatile uint32_t app_event_head = 0;    /* written by the interrupt */
+static volatile uint32_t app_event_tail = 0;    /* written by the task */
+static volatile uint32_t app_event_lost = 0;    /* ring full */
+
+/* [cycle] interrupt time of the last aerocontact event, start of the
+ * deploy chain if the liftoff is accepted */
+static uint32_t aeroc_stamp = 0;
 
 static STRUCT_SENSORS_MPU6050_t mpu6050;
 static STRUCT_SENSORS_BMP280_t bmp280;
+static STRUCT_GNSS_GPS_t gps;
+
+/* pressure at the ground, reference of the altitude */
+static float ground_pressure = 0.0f;
+static float altitude = 0.0f;                   /* [m] above the ground */
 
 static STRUCT_RECOV_MNTR_t mntr_recov;
 static STRUCT_PAYLOAD_MNTR_t mntr_payload;
@@ -93,57 +149,60 @@ static STRUCT_BATTERY_MNTR_t mntr_battery;
 -- ------------------------------------------------------------- */
 /* tasks handlers */
 static void handler_application(void* parameters);
+static void handler_tlm_hmi(void* parameters);
+#if APPLICATION_INC_LOG_RADIO
+static void handler_tlm_radio(void* parameters);
+#endif
 
 /* monitoring */
-static void process_deploy(void);
+static void process_flight(ENUM_FLIGHT_EVENT_t event);
+static void send_apogee(uint32_t time);
+static float get_altitude(float pressure);
 static void process_mntr_recov(STRUCT_RECOV_MNTR_t MNTR_RECOV);
 static void process_mntr_payload(STRUCT_PAYLOAD_MNTR_t MNTR_PAYLOAD);
 static void process_mntr_battery(STRUCT_BATTERY_MNTR_t MNTR_battery);
 
+static void process_events(void);
 static void process_user_btn(ENUM_APP_ISR_ID_t ID);
-
-/* callbacks */
-static void callback_timer_window_in(TimerHandle_t xTimer);
-static void callback_timer_window_out(TimerHandle_t xTimer);
+static void process_uplink(STRUCT_HMI_CMD_t CMD);
 
 /* ------------------------------------------------------------- --
    functions
 -- ------------------------------------------------------------- */
 static void handler_application(void* parameters)
 {
-    TickType_t xLastWakeTime;
-    xLastWakeTime = xTaskGetTickCount();
-
-    API_BUZZER_SEND_PARAMETER(BUZZER_WAIT_PERIOD, BUZZER_WAIT_DUTYCYCLE);
-    API_HMI_SEND_DATA(HMI_ID_APP_PHASE, "WAIT");
+    API_BUZZER_SET_PATTERN(E_BUZZER_PATTERN_WAIT);
     API_HMI_SEND_DATA(HMI_ID_APP_AEROC, "WAIT");
 
     /* delay until start */
     vTaskDelay(pdMS_TO_TICKS(1000));
+    API_HMI_SEND_DATA(HMI_ID_APP_PHASE, "%s", flight_fsm_name(flight.phase));
+    API_PERIODIC_INIT(E_PERIODIC_APPLICATION, TASK_PERIOD_APPLICATION);
 
     while(1)
     {
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
-#if APPLICATION_INC_FLAG_AEROC
-        /* This section is used to scan the flagAero variable.
-           The variable is set to true by the IT callback when the aerocontact is triggered.
-           The purpose is to initialize set the start by starting the window timers */
-        if(flagAeroc == true)
-        {
-            /* user indicators */
-            API_BUZZER_SEND_PARAMETER(BUZZER_ASCEND_PERIOD, BUZZER_ASCEND_DUTYCYCLE);
-            API_HMI_SEND_DATA(HMI_ID_APP_AEROC, "GO");
+        /* This section is used to read the events of the interrupt callback 
+           (aerocontact and user buttons) */
+        process_events();
 
-            /* start the window timers */
-            xTimerStart(TimerHandle_window_in, 0);
-            xTimerStart(TimerHandle_window_out, 0);
-
-            /* reset flag */
-            flagAeroc = false;
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if APPLICATION_INC_UPLINK
+        /* This section is used to read the commands sent by the ground station
+           (arm, manual recovery and payload, telemetry rate, flight log) */
+        STRUCT_HMI_CMD_t cmd;
+        while(API_HMI_GET_CMD(&cmd) == true)
+        {
+            process_uplink(cmd);
         }
 #endif
 
+        /* new data from the sensors, full rate. The decimated streams
+           are sent by the telemetry tasks */
+        bool imu = false;
+        bool baro = false;
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 #if APPLICATION_INC_DATA_MPU6050
         /* This section is used to get the values from the 
@@ -151,13 +210,12 @@ static void handler_application(void* parameters)
            The data gathered are the acceleration, angular speed, temperature and the degrees */
         if(API_SENSORS_GET_MPU6050(&mpu6050) == true)
         {
-            API_HMI_SEND_DATA(HMI_ID_SENS_IMU_X_KALMAN, "%d", mpu6050.data.KalmanAngleX);
-            API_HMI_SEND_DATA(HMI_ID_SENS_IMU_Y_KALMAN, "%d", mpu6050.data.KalmanAngleY);
-        }
-        else
-        {
-            API_HMI_SEND_DATA(HMI_ID_SENS_IMU_X_KALMAN, "ERROR");
-            API_HMI_SEND_DATA(HMI_ID_SENS_IMU_Y_KALMAN, "ERROR");
+            imu = true;
+            if(flight.phase == E_FLIGHT_COAST)
+            {
+                apogee_vote_imu(&apogee, mpu6050.data.Ax, mpu6050.data.Ay, mpu6050.data.Az, 
+                                mpu6050.data.KalmanAngleX, mpu6050.data.KalmanAngleY);
+            }
         }
 #endif
 
@@ -168,115 +226,365 @@ static void handler_application(void* parameters)
            The data gathered are the pressure and temperature */
         if(API_SENSORS_GET_BMP280(&bmp280) == true)
         {
-            API_HMI_SEND_DATA(HMI_ID_SENS_BARO_PRESS, "%d", bmp280.data.pressure);
+            baro = true;
+            if(ground_pressure == 0.0f) ground_pressure = bmp280.data.pressure;
+            altitude = get_altitude(bmp280.data.pressure);
+            if(flight.phase == E_FLIGHT_BOOST || flight.phase == E_FLIGHT_COAST)
+            {
+                apogee_vote_baro(&apogee, altitude, xTaskGetTickCount() * portTICK_PERIOD_MS);
+            }
         }
-        else
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+        /* This section runs the flight phase state machine with the last 
+           data of the sensors. Only the guards of the current phase are 
+           evaluated (burnout, apogee vote or end of window, landing) */
+        process_flight(E_FLIGHT_EVT_TICK);
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if APPLICATION_INC_MNTR_RECOV
+        /* This section is used to get the status of the recovery : sent 
+           to the HMI, kept for the actuators field of the radio frame */
+        if(API_RECOVERY_GET_MNTR(&mntr_recov) == true)
         {
-            API_HMI_SEND_DATA(HMI_ID_SENS_BARO_ERROR, "ERROR");
+            process_mntr_recov(mntr_recov);
         }
 #endif
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
-#if APPLICATION_INC_FLAG_WINOUT
-        /* This section is use to deploy the parachute if the sensors haven't detected the apogee.
-           It may enter in this condition if the variable flagWinOut == true.
-           flagWinOut is set to true by the software timer started by the aerocontact */
-        if(flagWinOut == true)
+#if APPLICATION_INC_MNTR_PAYLOAD
+        /* This section is used to get the status of the payload : sent 
+           to the HMI, kept for the actuators field of the radio frame */
+        if(API_PAYLOAD_GET_MNTR(&mntr_payload) == true)
         {
-            if(flagDeploy == false)
-            {
-                process_deploy();
-            }
+            process_mntr_payload(mntr_payload);
+        }
+#endif
 
-            /* reset flag */
-            flagWinIn = false;
-            flagWinOut = false;
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+#if APPLICATION_INC_MNTR_BATTERY
+        /* This section is used to monitor the batteries : status sent to the
+           HMI and, on the pad, the battery low pattern of the buzzer */
+        if(API_BATTERY_GET_MNTR(&mntr_battery) == true)
+        {
+            process_mntr_battery(mntr_battery);
         }
 #endif
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
-#if APPLICATION_INC_FLAG_WININ
-        /* This section is use to scan when deploy the parachute and deploy it.
-           To do that, the angles are used to determine if the rocket has 
-           reach an angle. At the apogee, the rocket must have a specific angle
-           that can be determined in the simulations. */
-        if(flagWinIn == true)
+#if APPLICATION_INC_LOG_DATALOG
+        /* This section is used to log the sensors in flash from the arming,
+           the phase changes are logged by process_flight. On the pad the 
+           datalogger keeps the last seconds at full rate and decimates
+           the rest, a shock commits them as the liftoff does */
+        if(flight.phase != E_FLIGHT_IDLE)
         {
-            if((fabs(mpu6050.data.KalmanAngleY) >= 70)
-            || (fabs(mpu6050.data.KalmanAngleX) >= 70))
+            if(imu == true)
+            {
+                float g2 = mpu6050.data.Ax * mpu6050.data.Ax + mpu6050.data.Ay * mpu6050.data.Ay + mpu6050.data.Az * mpu6050.data.Az;
+                if(flight.phase == E_FLIGHT_ARMED && log_triggered == false && g2 > APPLICATION_LOG_ANOMALY * APPLICATION_LOG_ANOMALY)
+                {
+                    API_DATALOGGER_SEND_CMD(E_DATALOGGER_CMD_TRIGGER);
+                    log_triggered = true;
+                }
+
+                STRUCT_LOG_IMU_t rec;
+
+                rec.accel[0] = mpu6050.data.Accel_X_RAW;
+                rec.accel[1] = mpu6050.data.Accel_Y_RAW;
+                rec.accel[2] = mpu6050.data.Accel_Z_RAW;
+                rec.gyro[0]  = mpu6050.data.Gyro_X_RAW;
+                rec.gyro[1]  = mpu6050.data.Gyro_Y_RAW;
+                rec.gyro[2]  = mpu6050.data.Gyro_Z_RAW;
+                rec.angle_x  = (int16_t)(mpu6050.data.KalmanAngleX * APPLICATION_LOG_ANGLE);
+                rec.angle_y  = (int16_t)(mpu6050.data.KalmanAngleY * APPLICATION_LOG_ANGLE);
+
+                API_DATALOGGER_WRITE(E_LOG_REC_IMU, &rec, sizeof(rec));
+            }
+
+            if(baro == true)
             {
-                process_deploy();
+                STRUCT_LOG_BARO_t rec;
+
+                rec.pressure    = (int32_t)bmp280.data.pressure;
+                rec.altitude    = (int32_t)(altitude * APPLICATION_LOG_ALTITUDE);
+                rec.temperature = (int16_t)(bmp280.data.temperature * APPLICATION_LOG_TEMP);
+                rec.reserved    = 0;
+
+                API_DATALOGGER_WRITE(E_LOG_REC_BARO, &rec, sizeof(rec));
             }
         }
 #endif
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
-        // if(API_GNSS_GET_GPS(&gps) == true)
-        // {
+    
+    /* wait until next period or an interrupt event */
+    API_PERIODIC_WAIT_NOTIFY(E_PERIODIC_APPLICATION);
+    }
+}
+
+/** ************************************************************* *
+ * @brief       This task sends the telemetry of the sensors to the 
+ *              HMI. It is blocked on the HMI stream, filtered and 
+ *              decimated by the sensors task at the rate asked by 
+ *              the ground station (10 Hz by default).
+ *              payload : kalman angle [0.01 deg] (i32), pressure 
+ *              [0.1 Pa] (i32), gnss : see below
+ * 
+ * @param       parameters 
+ * ************************************************************* **/
+static void handler_tlm_hmi(void* parameters)
+{
+    STRUCT_SENSORS_STREAM_t stream;
+    uint8_t buffer[HMI_PAYLOAD_SIZE];
+    PayloadBuilder pb = pb_start(buffer, sizeof(buffer), NULL);
 
-        // }
+    while(1)
+    {
+        if(API_SENSORS_WAIT_STREAM(E_SENSORS_STREAM_HMI, &stream) == false) continue;
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////
-#if APPLICATION_INC_MNTR_RECOV
-        if(API_RECOVERY_GET_MNTR(&recov) == true)
+        if((stream.valid & SENSORS_VALID_IMU) != 0u)
         {
-            process_mntr_recov(recov);
-        }
-#endif
+            pb_rewind((&pb));
+            pb_i32(&pb, stream.value[E_SENSORS_CH_ANGLE_X]);
+            API_HMI_SEND_BINARY(HMI_ID_SENS_IMU_X_KALMAN, buffer, (uint8_t)pb_length(&pb));
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////
-#if APPLICATION_INC_MNTR_PAYLOAD
-        if(API_PAYLOAD_GET_MNTR(&payload) == true)
+            pb_rewind((&pb));
+            pb_i32(&pb, stream.value[E_SENSORS_CH_ANGLE_Y]);
+            API_HMI_SEND_BINARY(HMI_ID_SENS_IMU_Y_KALMAN, buffer, (uint8_t)pb_length(&pb));
+        }
+        else
         {
-            process_mntr_payload(payload);
+            API_HMI_SEND_DATA(HMI_ID_SENS_IMU_ERROR, "ERROR");
         }
-#endif
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////
-#if APPLICATION_INC_MNTR_BATTERY
-        if(API_BATTERY_GET_MNTR(&battery) == true)
+        if((stream.valid & SENSORS_VALID_BARO) != 0u)
         {
-            process_mntr_battery(battery);
+            pb_rewind((&pb));
+            pb_i32(&pb, stream.value[E_SENSORS_CH_PRESSURE]);
+            API_HMI_SEND_BINARY(HMI_ID_SENS_BARO_PRESS, buffer, (uint8_t)pb_length(&pb));
+        }
+        else
+        {
+            API_HMI_SEND_DATA(HMI_ID_SENS_BARO_ERROR, "ERROR");
         }
-#endif
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////
-#if APPLICATION_INC_LOG_DATALOG
-        //send on SD
+#if APPLICATION_INC_DATA_GNSS
+        /* last fix of the gnss receiver, the mailbox is only read on
+           a telemetry sample : a fix received in between is kept for it.
+           payload : fix (u8), satellites (u8), latitude and longitude 
+           [1e-7 deg] (i32), altitude [mm] (i32) */
+        if(API_GNSS_GET_GPS(&gps) == true)
+        {
+            pb_rewind((&pb));
+            pb_u8(&pb, (uint8_t)gps.fix);
+            pb_u8(&pb, gps.sats);
+            pb_i32(&pb, gps.lat);
+            pb_i32(&pb, gps.lon);
+            pb_i32(&pb, gps.alt);
+            API_HMI_SEND_BINARY(HMI_ID_SENS_GNSS, buffer, (uint8_t)pb_length(&pb));
+        }
 #endif
+    }
+}
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////
 #if APPLICATION_INC_LOG_RADIO
-        //send on radio
+/** ************************************************************* *
+ * @brief       This task gives the last telemetry to the radio, the
+ *              radio task samples it at its own rate. It is blocked 
+ *              on the radio stream, decimated to this rate by the 
+ *              sensors task (no aliasing). The phase, the battery 
+ *              and the actuators are the last values read by the 
+ *              application task (words, read as they are).
+ * 
+ * @param       parameters 
+ * ************************************************************* **/
+static void handler_tlm_radio(void* parameters)
+{
+    STRUCT_SENSORS_STREAM_t stream;
+    STRUCT_RADIO_SAMPLE_t sample;
+
+    while(1)
+    {
+        if(API_SENSORS_WAIT_STREAM(E_SENSORS_STREAM_RADIO, &stream) == false) continue;
+
+        float pressure = (float)stream.value[E_SENSORS_CH_PRESSURE] / APPLICATION_STREAM_PRESSURE;
+
+        sample.field[E_RADIO_FIELD_ANGLE_X]   = stream.value[E_SENSORS_CH_ANGLE_X] * (int32_t)APPLICATION_RADIO_ANGLE / APPLICATION_STREAM_ANGLE;
+        sample.field[E_RADIO_FIELD_ANGLE_Y]   = stream.value[E_SENSORS_CH_ANGLE_Y] * (int32_t)APPLICATION_RADIO_ANGLE / APPLICATION_STREAM_ANGLE;
+        sample.field[E_RADIO_FIELD_ALTITUDE]  = (int32_t)(get_altitude(pressure) * APPLICATION_RADIO_ALTITUDE);
+        sample.field[E_RADIO_FIELD_PHASE]     = (int32_t)flight.phase;
+        sample.field[E_RADIO_FIELD_BATTERY]   = (int32_t)(mntr_battery.BAT_SEQ.volt * APPLICATION_RADIO_VOLT);
+        sample.field[E_RADIO_FIELD_ACTUATORS] = (int32_t)mntr_recov.status | ((int32_t)mntr_payload.status << 4);
+
+        API_RADIO_SET_SAMPLE(&sample);
+    }
+}
 #endif
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////
-#if APPLICATION_INC_USER_BTN
-        /* This section is use to scan when the user button is pressed.
-           It can be use to open or close the payload or recovery system manually */
-        if(userBtn != E_APP_ISR_NONE)
-        {
-            process_user_btn(userBtn);
-            userBtn == E_APP_ISR_NONE;
-        }
+/** ************************************************************* *
+ * @brief       send an event to the flight state machine and 
+ *              execute the action of the transition
+ * 
+ * @param       event 
+ * ************************************************************* **/
+static void process_flight(ENUM_FLIGHT_EVENT_t event)
+{
+    STRUCT_FLIGHT_CTX_t ctx;
+    ENUM_FLIGHT_ACTION_t action;
+
+    ctx.now      = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    ctx.altitude = altitude;
+    ctx.apogee   = apogee.decided;
+
+    action = flight_fsm_dispatch(&flight, event, &ctx);
+    switch(action)
+    {
+        case E_FLIGHT_ACT_NONE :
+            return;
+
+        case E_FLIGHT_ACT_LIFTOFF :
+            API_LATENCY_START(aeroc_stamp);
+            API_LATENCY_MARK(E_LATENCY_APP_PICKUP);
+            apogee_vote_init(&apogee, &apogee_config);
+#if APPLICATION_INC_LOG_DATALOG
+            if(log_triggered == false) API_DATALOGGER_SEND_CMD(E_DATALOGGER_CMD_TRIGGER);
+            log_triggered = true;
 #endif
-//////////////////////////////////////////////////////////////////////////////////////////////////////////
-    
-    /* wait until next period */
-    vTaskDelayUntil(&xLastWakeTime, TASK_PERIOD_APPLICATION);
+            API_BUZZER_SET_PATTERN(E_BUZZER_PATTERN_ASCEND);
+            API_HMI_SEND_DATA(HMI_ID_APP_AEROC, "GO");
+        break;
+
+        case E_FLIGHT_ACT_BURNOUT :
+            apogee_vote_start(&apogee);
+        break;
+
+        /* end of the window without apogee detection */
+        case E_FLIGHT_ACT_DEPLOY_LATE :
+            API_LATENCY_MARK(E_LATENCY_TIMER_EXPIRY);
+            /* fall through */
+        case E_FLIGHT_ACT_DEPLOY :
+            API_LATENCY_MARK(E_LATENCY_DEPLOY);
+            API_TRACE_MARK(E_TRACE_APP_DEPLOY, apogee.evidence);
+            API_RECOVERY_SEND_CMD(E_CMD_RECOV_OPEN);
+            send_apogee(ctx.now - flight.liftoff);
+        break;
+
+        case E_FLIGHT_ACT_DESCENT :
+            API_BUZZER_SET_PATTERN(E_BUZZER_PATTERN_DESCEND);
+        break;
+
+        default : break;
     }
+
+#if APPLICATION_INC_LOG_DATALOG
+    STRUCT_LOG_PHASE_t rec = {.phase = (uint8_t)flight.phase};
+    API_DATALOGGER_WRITE(E_LOG_REC_PHASE, &rec, sizeof(rec));
+
+    /* armed again on the pad : back to the pre-trigger ring */
+    if(flight.phase == E_FLIGHT_ARMED)
+    {
+        API_DATALOGGER_SEND_CMD(E_DATALOGGER_CMD_REARM);
+        log_triggered = false;
+    }
+#endif
+
+    API_HMI_SEND_DATA(HMI_ID_APP_PHASE, "%s", flight_fsm_name(flight.phase));
 }
 
 /** ************************************************************* *
- * @brief       
+ * @brief       send the evidence of the deploy decision.
+ *              payload : detectors which fired (u8, bit = 
+ *              ENUM_APOGEE_DETECTOR_t), score (u8), quorum (u8),
+ *              time from the liftoff [ms] (u32)
+ * 
+ * @param       time    [ms] 
+ * ************************************************************* **/
+static void send_apogee(uint32_t time)
+{
+    TYPE_HMI_SLOT_t slot;
+    uint8_t* buffer = API_HMI_RESERVE(HMI_ID_APP_RECOV_APOGEE, &slot);
+    if(buffer == NULL) return;
+
+    PayloadBuilder pb = pb_start(buffer, HMI_PAYLOAD_SIZE, NULL);
+
+    pb_u8(&pb, apogee.evidence);
+    pb_u8(&pb, apogee.score);
+    pb_u8(&pb, apogee_config.quorum);
+    pb_u32(&pb, time);
+
+    API_HMI_COMMIT(slot, (uint8_t)pb_length(&pb));
+}
+
+/** ************************************************************* *
+ * @brief       altitude above the ground, given by the pressure
+ *              (international barometric formula). The first
+ *              pressure measured is the ground reference.
  * 
+ * @param       pressure    [Pa] 
+ * @return      float       [m] 
  * ************************************************************* **/
-static void process_deploy(void)
+static float get_altitude(float pressure)
 {
-    flagDeploy = true;
-    API_RECOVERY_SEND_CMD(E_CMD_RECOV_OPEN);
-    API_BUZZER_SEND_PARAMETER(BUZZER_DESCEND_PERIOD, BUZZER_DESCEND_DUTYCYCLE);
-    API_HMI_SEND_DATA(HMI_ID_APP_PHASE, "DESCEND");
+    if(ground_pressure <= 0.0f || pressure <= 0.0f) return 0.0f;
+
+    return 44330.0f * (1.0f - powf(pressure / ground_pressure, 0.1903f));
+}
+
+/** ************************************************************* *
+ * @brief       read all the events of the interrupt callback.
+ *              The bounces of a switch (same event within 
+ *              APPLICATION_EVENT_DEBOUNCE) are ignored.
+ * 
+ * ************************************************************* **/
+static void process_events(void)
+{
+    static uint32_t last_stamp[E_APP_ISR_PAYLOAD_CLOSE + 1] = {0};
+    static bool last_valid[E_APP_ISR_PAYLOAD_CLOSE + 1] = {0};
+    uint32_t tail = app_event_tail;
+    STRUCT_APP_EVENT_t event;
+
+    while(tail != app_event_head)
+    {
+        /* read the event before releasing the slot */
+        __DMB();
+        event = app_events[tail & (APPLICATION_EVENT_SIZE - 1u)];
+        __DMB();
+        app_event_tail = ++tail;
+
+        if(event.ID > E_APP_ISR_PAYLOAD_CLOSE) continue;
+
+        /* switch bounce */
+        if(last_valid[event.ID] == true
+        && event.stamp - last_stamp[event.ID] < APPLICATION_EVENT_DEBOUNCE * (SystemCoreClock / 1000u))
+        {
+            continue;
+        }
+        last_stamp[event.ID] = event.stamp;
+        last_valid[event.ID] = true;
+
+        switch(event.ID)
+        {
+            case E_APP_ISR_AEROC :
+                aeroc_stamp = event.stamp;
+                process_flight(E_FLIGHT_EVT_LIFTOFF);
+                break;
+
+#if APPLICATION_INC_USER_BTN
+            /* the user buttons can be use to open or close the payload or recovery system manually */
+            case E_APP_ISR_RECOV_OPEN :
+            case E_APP_ISR_RECOV_CLOSE :
+            case E_APP_ISR_PAYLOAD_OPEN :
+            case E_APP_ISR_PAYLOAD_CLOSE :
+                process_user_btn(event.ID);
+                break;
+#endif
+
+            default :
+                break;
+        }
+    }
 }
 
 /** ************************************************************* *
@@ -338,6 +646,49 @@ static void process_user_btn(ENUM_APP_ISR_ID_t ID)
     }
 }
 
+/** ************************************************************* *
+ * @brief       process a command sent by the ground station
+ * 
+ * @param       CMD 
+ * ************************************************************* **/
+static void process_uplink(STRUCT_HMI_CMD_t CMD)
+{
+    switch(CMD.ID)
+    {
+        /* enable or disable the aerocontact, only on the pad */
+        case E_HMI_CMD_ARM:
+            process_flight((CMD.value != 0u) ? E_FLIGHT_EVT_ARM : E_FLIGHT_EVT_DISARM);
+        break;
+
+        /* manual command of the recovery */
+        case E_HMI_CMD_RECOV:
+            if(CMD.value <= E_CMD_RECOV_CLOSE) API_RECOVERY_SEND_CMD((ENUM_RECOV_CMD_t)CMD.value);
+        break;
+
+        /* manual command of the payload */
+        case E_HMI_CMD_PAYLOAD:
+            if(CMD.value <= E_CMD_PL_CLOSE) API_PAYLOAD_SEND_CMD((ENUM_PAYLOAD_CMD_t)CMD.value);
+        break;
+
+        /* telemetry period of the sensors [ms] */
+        case E_HMI_CMD_TLM_RATE:
+            API_SENSORS_SET_PERIOD(E_SENSORS_STREAM_HMI, CMD.value);
+        break;
+
+        /* flight log, on the ground only : the dump and the erase stall 
+           the datalogger */
+        case E_HMI_CMD_LOG_DUMP:
+            if(flight.phase == E_FLIGHT_IDLE || flight.phase == E_FLIGHT_LANDED) API_DATALOGGER_SEND_CMD(E_DATALOGGER_CMD_DUMP);
+        break;
+
+        case E_HMI_CMD_LOG_ERASE:
+            if(flight.phase == E_FLIGHT_IDLE || flight.phase == E_FLIGHT_LANDED) API_DATALOGGER_SEND_CMD(E_DATALOGGER_CMD_ERASE);
+        break;
+
+        default : break;
+    }
+}
+
 /** ************************************************************* *
  * @brief       process the recovery monitoring to send over HMI
  * 
@@ -374,24 +725,24 @@ static void process_mntr_recov(STRUCT_RECOV_MNTR_t MNTR_RECOV)
  * ************************************************************* **/
 static void process_mntr_payload(STRUCT_PAYLOAD_MNTR_t MNTR_PAYLOAD)
 {
-    /* send to hmi the last cmd received by the recovery */
+    /* send to hmi the last cmd received by the payload */
     switch(MNTR_PAYLOAD.last_cmd)
     {
-        case E_CMD_PL_NONE:  API_HMI_SEND_DATA(HMI_ID_RECOV_LAST_CMD, "NONE");   break;
-        case E_CMD_PL_STOP:  API_HMI_SEND_DATA(HMI_ID_RECOV_LAST_CMD, "STOP");   break;
-        case E_CMD_PL_OPEN:  API_HMI_SEND_DATA(HMI_ID_RECOV_LAST_CMD, "OPEN");   break;
-        case E_CMD_PL_CLOSE: API_HMI_SEND_DATA(HMI_ID_RECOV_LAST_CMD, "CLOSE");  break;
+        case E_CMD_PL_NONE:  API_HMI_SEND_DATA(HMI_ID_PAYLOAD_LAST_CMD, "NONE");   break;
+        case E_CMD_PL_STOP:  API_HMI_SEND_DATA(HMI_ID_PAYLOAD_LAST_CMD, "STOP");   break;
+        case E_CMD_PL_OPEN:  API_HMI_SEND_DATA(HMI_ID_PAYLOAD_LAST_CMD, "OPEN");   break;
+        case E_CMD_PL_CLOSE: API_HMI_SEND_DATA(HMI_ID_PAYLOAD_LAST_CMD, "CLOSE");  break;
         default: break;
     }
 
-    /* send to hmi the status of the recovery */
+    /* send to hmi the status of the payload */
     switch(MNTR_PAYLOAD.status)
     {
-        case E_STATUS_PL_NONE:    API_HMI_SEND_DATA(HMI_ID_RECOV_STATUS, "NONE");    break;
-        case E_STATUS_PL_STOP:    API_HMI_SEND_DATA(HMI_ID_RECOV_STATUS, "STOP");    break;
-        case E_STATUS_PL_RUNNING: API_HMI_SEND_DATA(HMI_ID_RECOV_STATUS, "RUNNING"); break;
-        case E_STATUS_PL_OPEN:    API_HMI_SEND_DATA(HMI_ID_RECOV_STATUS, "OPEN");    break;
-        case E_STATUS_PL_CLOSE:   API_HMI_SEND_DATA(HMI_ID_RECOV_STATUS, "CLOSE");   break;
+        case E_STATUS_PL_NONE:    API_HMI_SEND_DATA(HMI_ID_PAYLOAD_STATUS, "NONE");    break;
+        case E_STATUS_PL_STOP:    API_HMI_SEND_DATA(HMI_ID_PAYLOAD_STATUS, "STOP");    break;
+        case E_STATUS_PL_RUNNING: API_HMI_SEND_DATA(HMI_ID_PAYLOAD_STATUS, "RUNNING"); break;
+        case E_STATUS_PL_OPEN:    API_HMI_SEND_DATA(HMI_ID_PAYLOAD_STATUS, "OPEN");    break;
+        case E_STATUS_PL_CLOSE:   API_HMI_SEND_DATA(HMI_ID_PAYLOAD_STATUS, "CLOSE");   break;
         default: break;
     }
 }
@@ -432,6 +783,15 @@ static void process_mntr_battery(STRUCT_BATTERY_MNTR_t MNTR_battery)
     {
         API_HMI_SEND_DATA(HMI_ID_MNTR_BAT_MOTOR2, "OK");
     }
+
+    /* audible warning on the pad */
+    if((flight.phase == E_FLIGHT_IDLE || flight.phase == E_FLIGHT_ARMED)
+    && (MNTR_battery.BAT_SEQ.status    == E_BATTERY_KO
+     || MNTR_battery.BAT_MOTOR1.status == E_BATTERY_KO
+     || MNTR_battery.BAT_MOTOR2.status == E_BATTERY_KO))
+    {
+        API_BUZZER_SET_PATTERN(E_BUZZER_PATTERN_BATTERY_LOW);
+    }
 }
 
 /** ************************************************************* *
@@ -442,55 +802,51 @@ void API_APPLICATION_START(void)
 {
     BaseType_t status;
 
-    flagAeroc = false;
-    flagWinIn = false;
-    flagWinOut = false;
-    flagDeploy = false;
-    
+    flight_fsm_init(&flight, APPLICATION_ARMED_DEFAULT ? E_FLIGHT_ARMED : E_FLIGHT_IDLE, 0);
+
     /* create the tasks */
-    status = xTaskCreate(handler_application, "task_application", 2*configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY_APPLICATION, &TaskHandle_application);
+    status = xTaskCreate(handler_application, "task_application", TASK_STACK_APPLICATION, NULL, TASK_PRIORITY_APPLICATION, &TaskHandle_application);
     configASSERT(status == pdPASS);
 
-    /* init the temporal window timers */
-    TimerHandle_window_in  = xTimerCreate("timer_window_in", pdMS_TO_TICKS(WINDOW_IN_TIME), pdFALSE, (void*)0, callback_timer_window_in);
-    TimerHandle_window_out = xTimerCreate("timer_window_out", pdMS_TO_TICKS(WINDOW_OUT_TIME), pdFALSE, (void*)0, callback_timer_window_out);
-}
-
-/** ************************************************************* *
- * @brief       
- * 
- * @param       xTimer 
- * ************************************************************* **/
-static void callback_timer_window_in(TimerHandle_t xTimer)
-{
-    flagWinIn = true;
-}
+    /* telemetry of the decimated streams */
+    status = xTaskCreate(handler_tlm_hmi, "task_tlm_hmi", TASK_STACK_TELEMETRY_HMI, NULL, TASK_PRIORITY_TELEMETRY, &TaskHandle_tlm_hmi);
+    configASSERT(status == pdPASS);
 
-/** ************************************************************* *
- * @brief       
- * 
- * @param       xTimer 
- * ************************************************************* **/
-static void callback_timer_window_out(TimerHandle_t xTimer)
-{
-    flagWinOut = true;
+#if APPLICATION_INC_LOG_RADIO
+    status = xTaskCreate(handler_tlm_radio, "task_tlm_radio", TASK_STACK_TELEMETRY_RADIO, NULL, TASK_PRIORITY_TELEMETRY, &TaskHandle_tlm_radio);
+    configASSERT(status == pdPASS);
+#endif
 }
 
 /** ************************************************************* *
- * @brief       
+ * @brief       This function must be called by the EXTI callback.
+ *              The event is timestamped and pushed in the ring, 
+ *              then the application task is woken up.
  * 
+ * @param       ID 
  * ************************************************************* **/
 void API_APPLICATION_CALLBACK_ISR(ENUM_APP_ISR_ID_t ID)
 {
-    switch(ID)
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t head = app_event_head;
+
+    if(ID == E_APP_ISR_NONE) return;
+
+    if(head - app_event_tail < APPLICATION_EVENT_SIZE)
     {
-        case E_APP_ISR_AEROC :          flagAeroc = true; break;
+        app_events[head & (APPLICATION_EVENT_SIZE - 1u)].ID    = ID;
+        app_events[head & (APPLICATION_EVENT_SIZE - 1u)].stamp = portGET_RUN_TIME_COUNTER_VALUE();
 
-        case E_APP_ISR_RECOV_OPEN :     userBtn = ID; break;
-        case E_APP_ISR_RECOV_CLOSE :    userBtn = ID; break;
-        case E_APP_ISR_PAYLOAD_OPEN :   userBtn = ID; break;
-        case E_APP_ISR_PAYLOAD_CLOSE :  userBtn = ID; break;
-        default :  break;
+        /* publish the event after writing it */
+        __DMB();
+        app_event_head = head + 1u;
+    }
+    else
+    {
+        app_event_lost++;
     }
+
+    vTaskNotifyGiveFromISR(TaskHandle_application, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
@@ -0,0 +1,191 @@
+/** ************************************************************* *
+ * @file        apogee_vote.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "apogee_vote.h"
+#include "math.h"
+#include "string.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* samples in a row before a detector fires (sensor noise) */
+#define APOGEE_CONFIRM              3u
+
+/* barometer */
+#define APOGEE_BARO_DROP            3.0f    /* [m] below the peak */
+#define APOGEE_VELOCITY_ASCENT      10.0f   /* [m/s] ascent confirmed */
+#define APOGEE_VELOCITY_DT_MIN      1u      /* [ms] same sample ignored */
+
+/* alpha-beta filter of the altitude and the vertical speed, the
+ * derivative of the raw pressure is too noisy at 100 Hz */
+#define APOGEE_FILTER_ALPHA         0.1f
+#define APOGEE_FILTER_BETA          0.005f
+
+/* imu */
+#define APOGEE_TILT_ANGLE           70.0f   /* [deg] */
+#define APOGEE_FREEFALL_G           0.3f    /* [g] norm of the acceleration */
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static void confirm(STRUCT_APOGEE_t *vote, ENUM_APOGEE_DETECTOR_t detector, bool condition);
+static bool decide(STRUCT_APOGEE_t *vote);
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       update a detector with a new sample. It fires after
+ *              APOGEE_CONFIRM samples in a row and stays fired.
+ * 
+ * @param       vote 
+ * @param       detector 
+ * @param       condition 
+ * ************************************************************* **/
+static void confirm(STRUCT_APOGEE_t *vote, ENUM_APOGEE_DETECTOR_t detector, bool condition)
+{
+    if((vote->evidence & (1u << detector)) != 0u) return;
+
+    if(condition == false)
+    {
+        vote->count[detector] = 0;
+        return;
+    }
+
+    if(++vote->count[detector] >= APOGEE_CONFIRM)
+    {
+        vote->evidence |= (uint8_t)(1u << detector);
+        vote->score = (uint8_t)(vote->score + vote->config->weight[detector]);
+    }
+}
+
+/** ************************************************************* *
+ * @brief       check the quorum. The imu detectors alone can't
+ *              decide : the free fall fires as soon as the drag
+ *              is low, well before the apogee.
+ * 
+ * @param       vote 
+ * @return      true    only once, when the quorum is reached 
+ * ************************************************************* **/
+static bool decide(STRUCT_APOGEE_t *vote)
+{
+    if(vote->decided == true || vote->score < vote->config->quorum) return false;
+    if(vote->config->required != 0u && (vote->evidence & vote->config->required) == 0u) return false;
+
+    vote->decided = true;
+    return true;
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       init a vote at the liftoff : the filter of the
+ *              barometer tracks the altitude and the vertical speed
+ *              from rest, the detectors are disabled
+ * 
+ * @param       vote 
+ * @param       config 
+ * ************************************************************* **/
+void apogee_vote_init(STRUCT_APOGEE_t *vote, const STRUCT_APOGEE_CONFIG_t *config)
+{
+    memset(vote, 0, sizeof(STRUCT_APOGEE_t));
+    vote->config = config;
+}
+
+/** ************************************************************* *
+ * @brief       enable the detectors (at the burnout : the thrust
+ *              and the transonic pressure would fool them). The
+ *              vertical speed goes on from the one tracked during
+ *              the boost, not from 0.
+ * 
+ * @param       vote 
+ * ************************************************************* **/
+void apogee_vote_start(STRUCT_APOGEE_t *vote)
+{
+    memset(vote->count, 0, sizeof(vote->count));
+    vote->evidence = 0;
+    vote->score    = 0;
+    vote->started  = true;
+    vote->alt_max  = vote->alt_est;
+    vote->ascent   = (vote->velocity >= APOGEE_VELOCITY_ASCENT);
+}
+
+/** ************************************************************* *
+ * @brief       new sample of the barometer : peak and vertical
+ *              speed detectors
+ * 
+ * @param       vote 
+ * @param       altitude    [m] 
+ * @param       now         [ms] 
+ * @return      true        apogee decided by this sample 
+ * ************************************************************* **/
+bool apogee_vote_baro(STRUCT_APOGEE_t *vote, float altitude, uint32_t now)
+{
+    uint32_t dt = now - vote->alt_time;
+
+    if(vote->baro_valid == false)
+    {
+        vote->baro_valid = true;
+        vote->alt_max    = altitude;
+        vote->alt_est    = altitude;
+        vote->alt_time   = now;
+        return false;
+    }
+    if(dt < APOGEE_VELOCITY_DT_MIN) return false;
+
+    /* filter */
+    float period   = (float)dt / 1000.0f;
+    float residual = altitude - (vote->alt_est + vote->velocity * period);
+
+    vote->alt_est  += vote->velocity * period + APOGEE_FILTER_ALPHA * residual;
+    vote->velocity += (APOGEE_FILTER_BETA / period) * residual;
+    vote->alt_time  = now;
+    if(vote->started == false) return false;
+
+    /* peak */
+    if(vote->alt_est > vote->alt_max) vote->alt_max = vote->alt_est;
+    confirm(vote, E_APOGEE_BARO, vote->alt_est < vote->alt_max - APOGEE_BARO_DROP);
+
+    /* vertical speed, once the ascent has been seen */
+    if(vote->velocity >= APOGEE_VELOCITY_ASCENT) vote->ascent = true;
+    confirm(vote, E_APOGEE_VELOCITY, vote->ascent && vote->velocity < 0.0f);
+
+    return decide(vote);
+}
+
+/** ************************************************************* *
+ * @brief       new sample of the imu : tilt and free fall detectors
+ * 
+ * @param       vote 
+ * @param       ax          [g] 
+ * @param       ay          [g] 
+ * @param       az          [g] 
+ * @param       angle_x     [deg] 
+ * @param       angle_y     [deg] 
+ * @return      true        apogee decided by this sample 
+ * ************************************************************* **/
+bool apogee_vote_imu(STRUCT_APOGEE_t *vote, float ax, float ay, float az, float angle_x, float angle_y)
+{
+    if(vote->started == false) return false;
+
+    confirm(vote, E_APOGEE_TILT, fabsf(angle_x) >= APOGEE_TILT_ANGLE || fabsf(angle_y) >= APOGEE_TILT_ANGLE);
+    confirm(vote, E_APOGEE_FREEFALL, (ax * ax + ay * ay + az * az) < (APOGEE_FREEFALL_G * APOGEE_FREEFALL_G));
+
+    return decide(vote);
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
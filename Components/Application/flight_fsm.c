@@ -0,0 +1,202 @@
+/** ************************************************************* *
+ * @file        flight_fsm.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "flight_fsm.h"
+#include "stddef.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* windows settings, from the liftoff. The apogee is detected by 
+ * the vote of the sensors (apogee_vote.c) between the burnout and 
+ * the end of the window */
+#define FLIGHT_BOOST_TIME           3000u   /* [ms] motor burn time */
+#define FLIGHT_WINDOW_OUT_TIME      10000u  /* [ms] deploy whatever the sensors */
+
+/* landing */
+#define FLIGHT_LANDED_TIME          30000u  /* [ms] minimum descent time */
+#define FLIGHT_LANDED_ALTITUDE      20.0f   /* [m] above the ground */
+
+#if FLIGHT_BOOST_TIME >= FLIGHT_WINDOW_OUT_TIME
+#error "the apogee window must open after the burnout"
+#endif
+
+#define FLIGHT_TRANSITIONS(list)    {list, sizeof(list) / sizeof(list[0])}
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* guard of a transition, NULL : always true */
+typedef bool (*TYPE_FLIGHT_GUARD_t)(const STRUCT_FLIGHT_t *fsm, const STRUCT_FLIGHT_CTX_t *ctx);
+
+/* transition, the first one of the phase matching the event and
+ * with its guard true is taken */
+typedef struct
+{
+    ENUM_FLIGHT_EVENT_t event;
+    TYPE_FLIGHT_GUARD_t guard;
+    ENUM_FLIGHT_ACTION_t action;
+    ENUM_FLIGHT_PHASE_t next;
+}STRUCT_FLIGHT_TRANSITION_t;
+
+/* transitions leaving a phase */
+typedef struct
+{
+    const STRUCT_FLIGHT_TRANSITION_t *list;
+    uint32_t nb;
+}STRUCT_FLIGHT_STATE_t;
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static bool guard_burnout(const STRUCT_FLIGHT_t *fsm, const STRUCT_FLIGHT_CTX_t *ctx);
+static bool guard_window_out(const STRUCT_FLIGHT_t *fsm, const STRUCT_FLIGHT_CTX_t *ctx);
+static bool guard_apogee(const STRUCT_FLIGHT_t *fsm, const STRUCT_FLIGHT_CTX_t *ctx);
+static bool guard_landed(const STRUCT_FLIGHT_t *fsm, const STRUCT_FLIGHT_CTX_t *ctx);
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+static const STRUCT_FLIGHT_TRANSITION_t flight_idle[] = {
+    {E_FLIGHT_EVT_ARM,      NULL,               E_FLIGHT_ACT_PHASE,         E_FLIGHT_ARMED},
+};
+
+static const STRUCT_FLIGHT_TRANSITION_t flight_armed[] = {
+    {E_FLIGHT_EVT_DISARM,   NULL,               E_FLIGHT_ACT_PHASE,         E_FLIGHT_IDLE},
+    {E_FLIGHT_EVT_LIFTOFF,  NULL,               E_FLIGHT_ACT_LIFTOFF,       E_FLIGHT_BOOST},
+};
+
+static const STRUCT_FLIGHT_TRANSITION_t flight_boost[] = {
+    {E_FLIGHT_EVT_TICK,     guard_burnout,      E_FLIGHT_ACT_BURNOUT,       E_FLIGHT_COAST},
+};
+
+static const STRUCT_FLIGHT_TRANSITION_t flight_coast[] = {
+    {E_FLIGHT_EVT_TICK,     guard_apogee,       E_FLIGHT_ACT_DEPLOY,        E_FLIGHT_APOGEE},
+    {E_FLIGHT_EVT_TICK,     guard_window_out,   E_FLIGHT_ACT_DEPLOY_LATE,   E_FLIGHT_APOGEE},
+};
+
+static const STRUCT_FLIGHT_TRANSITION_t flight_apogee[] = {
+    {E_FLIGHT_EVT_TICK,     NULL,               E_FLIGHT_ACT_DESCENT,       E_FLIGHT_DESCENT},
+};
+
+static const STRUCT_FLIGHT_TRANSITION_t flight_descent[] = {
+    {E_FLIGHT_EVT_TICK,     guard_landed,       E_FLIGHT_ACT_PHASE,         E_FLIGHT_LANDED},
+};
+
+/* transitions by phase (same order as ENUM_FLIGHT_PHASE_t) */
+static const STRUCT_FLIGHT_STATE_t flight_states[E_FLIGHT_NB] = {
+    FLIGHT_TRANSITIONS(flight_idle),
+    FLIGHT_TRANSITIONS(flight_armed),
+    FLIGHT_TRANSITIONS(flight_boost),
+    FLIGHT_TRANSITIONS(flight_coast),
+    FLIGHT_TRANSITIONS(flight_apogee),
+    FLIGHT_TRANSITIONS(flight_descent),
+    {NULL, 0},
+};
+
+static const char* const flight_names[E_FLIGHT_NB] = {
+    "IDLE", "ARMED", "BOOST", "COAST", "APOGEE", "DESCENT", "LANDED"
+};
+
+/* ============================================================= ==
+   guards
+== ============================================================= */
+static bool guard_burnout(const STRUCT_FLIGHT_t *fsm, const STRUCT_FLIGHT_CTX_t *ctx)
+{
+    return (ctx->now - fsm->liftoff) >= FLIGHT_BOOST_TIME;
+}
+
+static bool guard_window_out(const STRUCT_FLIGHT_t *fsm, const STRUCT_FLIGHT_CTX_t *ctx)
+{
+    return (ctx->now - fsm->liftoff) >= FLIGHT_WINDOW_OUT_TIME;
+}
+
+static bool guard_apogee(const STRUCT_FLIGHT_t *fsm, const STRUCT_FLIGHT_CTX_t *ctx)
+{
+    (void)fsm;
+    return ctx->apogee;
+}
+
+static bool guard_landed(const STRUCT_FLIGHT_t *fsm, const STRUCT_FLIGHT_CTX_t *ctx)
+{
+    return (ctx->now - fsm->entered) >= FLIGHT_LANDED_TIME
+        && ctx->altitude < FLIGHT_LANDED_ALTITUDE;
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       
+ * 
+ * @param       fsm 
+ * @param       phase   initial phase (IDLE or ARMED) 
+ * @param       now     [ms] 
+ * ************************************************************* **/
+void flight_fsm_init(STRUCT_FLIGHT_t *fsm, ENUM_FLIGHT_PHASE_t phase, uint32_t now)
+{
+    fsm->phase   = phase;
+    fsm->entered = now;
+    fsm->liftoff = now;
+}
+
+/** ************************************************************* *
+ * @brief       process an event. Only the transitions of the
+ *              current phase are scanned, the cost of an event
+ *              is bounded by the longest list of the table.
+ * 
+ * @param       fsm 
+ * @param       event 
+ * @param       ctx 
+ * @return      ENUM_FLIGHT_ACTION_t    E_FLIGHT_ACT_NONE : the phase 
+ *                                      didn't change
+ * ************************************************************* **/
+ENUM_FLIGHT_ACTION_t flight_fsm_dispatch(STRUCT_FLIGHT_t *fsm, ENUM_FLIGHT_EVENT_t event, const STRUCT_FLIGHT_CTX_t *ctx)
+{
+    const STRUCT_FLIGHT_STATE_t *state;
+
+    if(fsm->phase >= E_FLIGHT_NB) return E_FLIGHT_ACT_NONE;
+    state = &flight_states[fsm->phase];
+
+    for(uint32_t i = 0; i < state->nb; i++)
+    {
+        const STRUCT_FLIGHT_TRANSITION_t *transition = &state->list[i];
+
+        if(transition->event != event) continue;
+        if(transition->guard != NULL && transition->guard(fsm, ctx) == false) continue;
+
+        fsm->phase   = transition->next;
+        fsm->entered = ctx->now;
+        if(event == E_FLIGHT_EVT_LIFTOFF) fsm->liftoff = ctx->now;
+
+        return transition->action;
+    }
+
+    return E_FLIGHT_ACT_NONE;
+}
+
+/** ************************************************************* *
+ * @brief       name of a phase for the hmi
+ * 
+ * @param       phase 
+ * @return      const char* 
+ * ************************************************************* **/
+const char* flight_fsm_name(ENUM_FLIGHT_PHASE_t phase)
+{
+    return (phase < E_FLIGHT_NB) ? flight_names[phase] : "?";
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
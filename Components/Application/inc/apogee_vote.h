@@ -0,0 +1,76 @@
+/** ************************************************************* *
+ * @file        apogee_vote.h
+ * @brief       Apogee decision by vote of independent detectors.
+ *              No dependency on the RTOS nor on the HAL.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef APPLICATION_INC_APOGEE_VOTE_H_
+#define APPLICATION_INC_APOGEE_VOTE_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* detectors, bit of the evidence mask */
+typedef enum
+{
+    E_APOGEE_BARO,              /* altitude below the peak */
+    E_APOGEE_VELOCITY,          /* vertical speed from positive to negative */
+    E_APOGEE_TILT,              /* rocket tilted */
+    E_APOGEE_FREEFALL,          /* no specific force (no thrust, no drag) */
+    E_APOGEE_NB
+}ENUM_APOGEE_DETECTOR_t;
+
+/* settings : the apogee is decided when the sum of the weights of
+ * the detectors which fired reaches the quorum, and one of the
+ * required detectors at least has fired */
+typedef struct
+{
+    uint8_t weight[E_APOGEE_NB];    /* confidence of each detector, 0 : disabled */
+    uint8_t quorum;
+    uint8_t required;               /* mask of the detectors, 0 : any */
+}STRUCT_APOGEE_CONFIG_t;
+
+/* state of the vote */
+typedef struct
+{
+    const STRUCT_APOGEE_CONFIG_t *config;
+    uint8_t count[E_APOGEE_NB];     /* confirming samples in a row */
+    uint8_t evidence;               /* detectors which fired (latched) */
+    uint8_t score;                  /* sum of the weights */
+    bool started;                   /* detectors enabled (burnout) */
+    bool decided;
+
+    /* barometer */
+    bool baro_valid;
+    float alt_max;                  /* [m] filtered peak */
+    float alt_est;                  /* [m] filtered */
+    uint32_t alt_time;              /* [ms] */
+    float velocity;                 /* [m/s] filtered */
+    bool ascent;                    /* ascent speed seen */
+}STRUCT_APOGEE_t;
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+void apogee_vote_init(STRUCT_APOGEE_t *vote, const STRUCT_APOGEE_CONFIG_t *config);
+void apogee_vote_start(STRUCT_APOGEE_t *vote);
+bool apogee_vote_baro(STRUCT_APOGEE_t *vote, float altitude, uint32_t now);
+bool apogee_vote_imu(STRUCT_APOGEE_t *vote, float ax, float ay, float az, float angle_x, float angle_y);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* APPLICATION_INC_APOGEE_VOTE_H_ */
@@ -0,0 +1,88 @@
+/** ************************************************************* *
+ * @file        flight_fsm.h
+ * @brief       Flight phase state machine. No dependency on the
+ *              RTOS nor on the HAL : the actions are returned to
+ *              the application which executes them.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef APPLICATION_INC_FLIGHT_FSM_H_
+#define APPLICATION_INC_FLIGHT_FSM_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* flight phases */
+typedef enum
+{
+    E_FLIGHT_IDLE,              /* on the pad, aerocontact ignored */
+    E_FLIGHT_ARMED,             /* on the pad, waiting for the liftoff */
+    E_FLIGHT_BOOST,             /* motor burning */
+    E_FLIGHT_COAST,             /* ascent after the burnout */
+    E_FLIGHT_APOGEE,            /* deploy */
+    E_FLIGHT_DESCENT,           /* under parachute */
+    E_FLIGHT_LANDED,
+    E_FLIGHT_NB
+}ENUM_FLIGHT_PHASE_t;
+
+/* events of the state machine */
+typedef enum
+{
+    E_FLIGHT_EVT_ARM,           /* ground station */
+    E_FLIGHT_EVT_DISARM,        /* ground station */
+    E_FLIGHT_EVT_LIFTOFF,       /* aerocontact */
+    E_FLIGHT_EVT_TICK,          /* period of the application, new data */
+    E_FLIGHT_EVT_NB
+}ENUM_FLIGHT_EVENT_t;
+
+/* actions executed by the application on a transition */
+typedef enum
+{
+    E_FLIGHT_ACT_NONE,          /* no transition */
+    E_FLIGHT_ACT_PHASE,         /* new phase only */
+    E_FLIGHT_ACT_LIFTOFF,       /* indicators */
+    E_FLIGHT_ACT_BURNOUT,       /* start the apogee vote */
+    E_FLIGHT_ACT_DEPLOY,        /* apogee detected : open the recovery */
+    E_FLIGHT_ACT_DEPLOY_LATE,   /* end of the window : open the recovery */
+    E_FLIGHT_ACT_DESCENT        /* indicators */
+}ENUM_FLIGHT_ACTION_t;
+
+/* inputs of the guards */
+typedef struct
+{
+    uint32_t now;               /* [ms] */
+    float altitude;             /* [m] above the ground */
+    bool apogee;                /* apogee decided by the vote */
+}STRUCT_FLIGHT_CTX_t;
+
+/* state */
+typedef struct
+{
+    ENUM_FLIGHT_PHASE_t phase;
+    uint32_t entered;           /* [ms] phase start */
+    uint32_t liftoff;           /* [ms] */
+}STRUCT_FLIGHT_t;
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+void flight_fsm_init(STRUCT_FLIGHT_t *fsm, ENUM_FLIGHT_PHASE_t phase, uint32_t now);
+ENUM_FLIGHT_ACTION_t flight_fsm_dispatch(STRUCT_FLIGHT_t *fsm, ENUM_FLIGHT_EVENT_t event, const STRUCT_FLIGHT_CTX_t *ctx);
+const char* flight_fsm_name(ENUM_FLIGHT_PHASE_t phase);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* APPLICATION_INC_FLIGHT_FSM_H_ */
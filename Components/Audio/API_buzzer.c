@@ -15,9 +15,10 @@
 -- ------------------------------------------------------------- */
 #include "API_buzzer.h"
 #include "FreeRTOS.h"
-#include "queue.h"
 #include "task.h"
+#include "semphr.h"
 #include "gpio.h"
+#include "stdbool.h"
 
 #include "MS1_config.h"
 
@@ -27,6 +28,33 @@
 #define BUZZER_DEFAULT_PERIOD       1000u
 #define BUZZER_DEFAULT_DUTYCYCLE    0.015f
 
+/* The buzzer pin (PD4) has no timer alternate function, the
+ * advanced timer TIM8 is used as sequencer and the pin is driven
+ * by DMA2 (DMA1 can not access the GPIO ports) :
+ * -> TIM8_UP  (DMA2 stream 1 channel 7) writes the pin state in BSRR
+ * -> TIM8_CH1 (DMA2 stream 2 channel 7) writes the next duration in ARR
+ * Reserved in MS1_scheduler.ioc, the registers are set here. */
+#define BUZZER_TIMER                TIM8
+#define BUZZER_TIMER_CLOCK          48000000u   /* [Hz] APB2 timer clock */
+#define BUZZER_TIMER_TICK           100000u     /* [Hz] 1 tick = 10 us */
+#define BUZZER_TIMER_ARR_MAX        0xFFFFu
+#define BUZZER_TICK_PER_MS          (BUZZER_TIMER_TICK / 1000u)
+
+#define BUZZER_DMA_STATE            DMA2_Stream1
+#define BUZZER_DMA_DURATION         DMA2_Stream2
+#define BUZZER_DMA_CHANNEL          7u
+#define BUZZER_DMA_FLAGS_STATE      0x00000F40u     /* LIFCR stream 1 flags */
+#define BUZZER_DMA_FLAGS_DURATION   0x003D0000u     /* LIFCR stream 2 flags */
+
+/* maximum number of steps of a compiled pattern */
+#define BUZZER_STEP_MAX             512u
+
+/* notes used to build the patterns */
+#define NOTE_END                    {0, 0, 0, 0}
+#define MORSE_DOT                   {0, 100, 100, 1}
+#define MORSE_DASH                  {0, 300, 100, 1}
+#define MORSE_GAP                   {0, 0, 1500, 1}
+
 /* ------------------------------------------------------------- --
    types
 -- ------------------------------------------------------------- */
@@ -37,84 +65,318 @@ typedef struct
     float       dutycycle;
 }STRUCT_BUZZER_t;
 
-/* ------------------------------------------------------------- --
-   handles
--- ------------------------------------------------------------- */
-TaskHandle_t TaskHandle_buzzer;
-QueueHandle_t QueueHandle_buzzer;
+/* Buzzer note structure
+ * -> tone   : 0 to use the buzzer own tone or the frequency 
+ *             at which the buzzer is switched 
+ * -> repeat : 0 ends the pattern */
+typedef struct
+{
+    uint16_t    tone;       /* [Hz] */
+    uint16_t    on;         /* [ms] */
+    uint16_t    off;        /* [ms] */
+    uint8_t     repeat;
+}STRUCT_BUZZER_NOTE_t;
 
 /* ------------------------------------------------------------- --
    variables
 -- ------------------------------------------------------------- */
 static STRUCT_BUZZER_t buzzer = {0};
 
+static const STRUCT_BUZZER_NOTE_t pattern_none[]         = {NOTE_END};
+static const STRUCT_BUZZER_NOTE_t pattern_wait[]         = {{0, 500, 500, 1}, NOTE_END};
+static const STRUCT_BUZZER_NOTE_t pattern_armed[]        = {MORSE_DOT, MORSE_DASH, MORSE_GAP, NOTE_END};
+static const STRUCT_BUZZER_NOTE_t pattern_ascend[]       = {{0, 10, 90, 1}, NOTE_END};
+static const STRUCT_BUZZER_NOTE_t pattern_descend[]      = {{0, 500, 500, 1}, NOTE_END};
+static const STRUCT_BUZZER_NOTE_t pattern_sensor_fault[] = {MORSE_DOT, MORSE_DOT, MORSE_DOT, MORSE_GAP, NOTE_END};
+static const STRUCT_BUZZER_NOTE_t pattern_battery_low[]  = {{2000, 30, 20, 1}, {1000, 30, 200, 1}, MORSE_DASH, MORSE_DOT, MORSE_DOT, MORSE_DOT, MORSE_GAP, NOTE_END};
+static STRUCT_BUZZER_NOTE_t pattern_custom[]             = {{0, 0, 0, 1}, NOTE_END};
+
+static const STRUCT_BUZZER_NOTE_t* const pattern_table[E_BUZZER_PATTERN_NB] =
+{
+    [E_BUZZER_PATTERN_NONE]         = pattern_none,
+    [E_BUZZER_PATTERN_CUSTOM]       = pattern_custom,
+    [E_BUZZER_PATTERN_WAIT]         = pattern_wait,
+    [E_BUZZER_PATTERN_ARMED]        = pattern_armed,
+    [E_BUZZER_PATTERN_ASCEND]       = pattern_ascend,
+    [E_BUZZER_PATTERN_DESCEND]      = pattern_descend,
+    [E_BUZZER_PATTERN_SENSOR_FAULT] = pattern_sensor_fault,
+    [E_BUZZER_PATTERN_BATTERY_LOW]  = pattern_battery_low
+};
+
+static ENUM_BUZZER_PATTERN_t pattern_current = E_BUZZER_PATTERN_NONE;
+
+/* compiled patterns : the DMA reads the active buffer while the
+ * next pattern is compiled in the other one */
+static uint32_t step_state[2][BUZZER_STEP_MAX];
+static uint32_t step_duration[2][BUZZER_STEP_MAX];
+static uint32_t step_nb[2];
+static uint32_t step_active = 0;
+
+/* one caller at a time compiles in the inactive buffer */
+static SemaphoreHandle_t buzzer_mutex;
+
 /* ------------------------------------------------------------- --
    prototypes
 -- ------------------------------------------------------------- */
-static void handler_buzzer(void* parameters);
+static bool add_step(uint32_t buffer, bool state, uint32_t ticks);
+static bool compile_pattern(uint32_t buffer, const STRUCT_BUZZER_NOTE_t* notes);
+static void stop_pattern(void);
+static void start_pattern(uint32_t buffer);
+static void play_pattern(ENUM_BUZZER_PATTERN_t pattern);
 
 /* ============================================================= ==
-   tasks functions
+   private functions
 == ============================================================= */
 /** ************************************************************* *
- * @brief       This task manage the buzzer system with two 
- *              parameters. 
- *              - The period
- *              - The dutycycle
- *              The task need to receive command from queue to 
- *              operate.
- *              Please check at the STRUCT_BUZZER_t structure
- *              to send new parameters
+ * @brief       add a step to the compiled pattern. A step longer
+ *              than the timer range is split in several steps
  * 
- * @param       parameters 
+ * @param       buffer  0 or 1 
+ * @param       state   pin state during the step
+ * @param       ticks   duration [timer tick]
+ * @return      true    step added
+ * @return      false   the pattern is too long
  * ************************************************************* **/
-static void handler_buzzer(void* parameters)
+static bool add_step(uint32_t buffer, bool state, uint32_t ticks)
 {
-    while(1)
+    uint32_t duration;
+    uint32_t *nb = &step_nb[buffer];
+
+    while(ticks > 0u)
     {
-        /* (alpha) part of dutycycle */
-        HAL_GPIO_TogglePin(BUZZER_GPIO_Port, BUZZER_Pin);
-        xQueueReceive(QueueHandle_buzzer, &buzzer, pdMS_TO_TICKS(buzzer.period * buzzer.dutycycle));
+        if(*nb >= BUZZER_STEP_MAX) return false;
+
+        duration = (ticks > BUZZER_TIMER_ARR_MAX + 1u) ? (BUZZER_TIMER_ARR_MAX + 1u) : ticks;
+        ticks   -= duration;
+
+        /* the duration is written at CNT = 1, ARR must be >= 1 */
+        if(duration < 2u) duration = 2u;
+
+        step_state[buffer][*nb]    = (state == true) ? BUZZER_Pin : ((uint32_t)BUZZER_Pin << 16u);
+        step_duration[buffer][*nb] = duration - 1u;
+        (*nb)++;
+    }
+
+    return true;
+}
+
+/** ************************************************************* *
+ * @brief       compile a list of notes into the steps played by
+ *              the DMA.
+ *              The DMA writes the step k + 1 during the step k,
+ *              so the compiled tables are rotated by one step.
+ *              Must not be called on the buffer read by the DMA.
+ * 
+ * @param       buffer  0 or 1 
+ * @param       notes 
+ * @return      true    pattern compiled
+ * @return      false   the pattern is too long
+ * ************************************************************* **/
+static bool compile_pattern(uint32_t buffer, const STRUCT_BUZZER_NOTE_t* notes)
+{
+    uint32_t half;
+    uint32_t count;
+    uint32_t first_state;
+    uint32_t first_duration;
+    uint32_t nb;
+
+    step_nb[buffer] = 0;
+
+    for(; notes->repeat != 0u; notes++)
+    {
+        for(uint8_t r = 0; r < notes->repeat; r++)
+        {
+            /* on part of the note */
+            if(notes->tone == 0u)
+            {
+                if(add_step(buffer, true, notes->on * BUZZER_TICK_PER_MS) == false) return false;
+            }
+            else
+            {
+                half  = BUZZER_TIMER_TICK / (2u * notes->tone);
+                count = (notes->on * BUZZER_TICK_PER_MS) / half;
+                for(uint32_t i = 0; i < count; i++)
+                {
+                    if(add_step(buffer, (i & 1u) == 0u, half) == false) return false;
+                }
+            }
+
+            /* off part of the note */
+            if(add_step(buffer, false, notes->off * BUZZER_TICK_PER_MS) == false) return false;
+        }
+    }
+
+    nb = step_nb[buffer];
+    if(nb == 0u) return true;
+
+    /* rotate the tables by one step */
+    first_state    = step_state[buffer][0];
+    first_duration = step_duration[buffer][0];
+    for(uint32_t i = 1; i < nb; i++)
+    {
+        step_state[buffer][i - 1]    = step_state[buffer][i];
+        step_duration[buffer][i - 1] = step_duration[buffer][i];
+    }
+    step_state[buffer][nb - 1]    = first_state;
+    step_duration[buffer][nb - 1] = first_duration;
+
+    return true;
+}
+
+/** ************************************************************* *
+ * @brief       stop the timer and the DMA streams and switch off
+ *              the buzzer
+ * 
+ * ************************************************************* **/
+static void stop_pattern(void)
+{
+    BUZZER_TIMER->CR1  &= ~TIM_CR1_CEN;
+    BUZZER_TIMER->DIER  = 0u;
+
+    BUZZER_DMA_STATE->CR    &= ~DMA_SxCR_EN;
+    BUZZER_DMA_DURATION->CR &= ~DMA_SxCR_EN;
+    while((BUZZER_DMA_STATE->CR & DMA_SxCR_EN) || (BUZZER_DMA_DURATION->CR & DMA_SxCR_EN));
+    DMA2->LIFCR = BUZZER_DMA_FLAGS_STATE | BUZZER_DMA_FLAGS_DURATION;
+
+    BUZZER_GPIO_Port->BSRR = (uint32_t)BUZZER_Pin << 16u;
+}
+
+/** ************************************************************* *
+ * @brief       start the timer and the DMA streams on a compiled
+ *              buffer. Once started, the pattern loops without any
+ *              CPU load.
+ * 
+ * @param       buffer  0 or 1 
+ * ************************************************************* **/
+static void start_pattern(uint32_t buffer)
+{
+    uint32_t nb = step_nb[buffer];
+
+    /* the first step is loaded by software (rotated at the end) */
+    BUZZER_GPIO_Port->BSRR = step_state[buffer][nb - 1];
+    BUZZER_TIMER->ARR      = step_duration[buffer][nb - 1];
+    BUZZER_TIMER->CNT      = 0u;
+    BUZZER_TIMER->EGR      = TIM_EGR_UG;
+    BUZZER_TIMER->SR       = 0u;
+
+    /* the next steps are loaded by the DMA */
+    BUZZER_DMA_STATE->NDTR    = nb;
+    BUZZER_DMA_STATE->M0AR    = (uint32_t)step_state[buffer];
+    BUZZER_DMA_DURATION->NDTR = nb;
+    BUZZER_DMA_DURATION->M0AR = (uint32_t)step_duration[buffer];
+    BUZZER_DMA_STATE->CR      |= DMA_SxCR_EN;
+    BUZZER_DMA_DURATION->CR   |= DMA_SxCR_EN;
 
-        /* (1 - alpha) part of dutycycle */
-        HAL_GPIO_TogglePin(BUZZER_GPIO_Port, BUZZER_Pin);
-        xQueueReceive(QueueHandle_buzzer, &buzzer, pdMS_TO_TICKS(buzzer.period - buzzer.period * buzzer.dutycycle));
+    BUZZER_TIMER->DIER = TIM_DIER_UDE | TIM_DIER_CC1DE;
+    BUZZER_TIMER->CR1 |= TIM_CR1_CEN;
+}
+
+/** ************************************************************* *
+ * @brief       compile the pattern in the buffer not read by the 
+ *              DMA, then switch the DMA on it. Only the switch runs
+ *              in the critical section. A pattern too long is not
+ *              played. Called with buzzer_mutex taken.
+ * 
+ * @param       pattern 
+ * ************************************************************* **/
+static void play_pattern(ENUM_BUZZER_PATTERN_t pattern)
+{
+    uint32_t buffer = step_active ^ 1u;
+    bool ok = compile_pattern(buffer, pattern_table[pattern]);
+
+    taskENTER_CRITICAL();
+
+    stop_pattern();
+    pattern_current = pattern;
+
+    if(ok == true && step_nb[buffer] != 0u)
+    {
+        start_pattern(buffer);
+        step_active = buffer;
     }
+
+    taskEXIT_CRITICAL();
 }
 
 /* ============================================================= ==
    public functions
 == ============================================================= */
 /** ************************************************************* *
- * @brief       init and start the buzzer task
+ * @brief       init the buzzer timer and DMA streams and play
+ *              the default pattern
  * 
  * ************************************************************* **/
 void API_BUZZER_START(void)
 {
-    BaseType_t status;
+    uint32_t config;
+
+    buzzer_mutex = xSemaphoreCreateMutex();
+    configASSERT(buzzer_mutex != NULL);
+
+    RCC->APB2ENR |= RCC_APB2ENR_TIM8EN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+    (void)RCC->AHB1ENR;
+
+    /* init the timer : ARR preloaded, UG does not request the DMA,
+       CC1 (frozen) requests the DMA at CNT = 1 */
+    BUZZER_TIMER->CR1   = TIM_CR1_ARPE | TIM_CR1_URS;
+    BUZZER_TIMER->PSC   = (BUZZER_TIMER_CLOCK / BUZZER_TIMER_TICK) - 1u;
+    BUZZER_TIMER->CCMR1 = 0u;
+    BUZZER_TIMER->CCR1  = 1u;
+
+    /* init the DMA streams : memory to peripheral, 32 bits, circular */
+    config = (BUZZER_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_PL_1 | DMA_SxCR_MSIZE_1 
+           | DMA_SxCR_PSIZE_1 | DMA_SxCR_MINC | DMA_SxCR_CIRC | DMA_SxCR_DIR_0;
+
+    BUZZER_DMA_STATE->CR     = config;
+    BUZZER_DMA_STATE->PAR    = (uint32_t)&BUZZER_GPIO_Port->BSRR;
+    BUZZER_DMA_DURATION->CR  = config;
+    BUZZER_DMA_DURATION->PAR = (uint32_t)&BUZZER_TIMER->ARR;
 
     /* init the main structure */
-    buzzer.period    = BUZZER_DEFAULT_PERIOD;
-    buzzer.dutycycle = BUZZER_DEFAULT_DUTYCYCLE;
-
-    /* create the queue */
-    QueueHandle_buzzer = xQueueCreate (1, sizeof(STRUCT_BUZZER_t));
-    
-    /* create the task */
-    status = xTaskCreate(handler_buzzer, "task_buzzer", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY_BUZZER, &TaskHandle_buzzer);
-    configASSERT(status == pdPASS);
+    API_BUZZER_SEND_PARAMETER(BUZZER_DEFAULT_PERIOD, BUZZER_DEFAULT_DUTYCYCLE);
 }
 
 /** ************************************************************* *
- * @brief       send new parameters to the buzzer task
+ * @brief       send new parameters to the buzzer. 
+ *              They are played as the custom pattern.
  * 
  * @param       period 
  * @param       dutycycle 
  * ************************************************************* **/
 void API_BUZZER_SEND_PARAMETER(uint16_t period, float dutycycle)
 {
-    STRUCT_BUZZER_t param = {.dutycycle = dutycycle, .period = period};
-    xQueueSend(QueueHandle_buzzer, &param, 0);
+    xSemaphoreTake(buzzer_mutex, portMAX_DELAY);
+
+    buzzer.period    = period;
+    buzzer.dutycycle = dutycycle;
+
+    pattern_custom[0].on  = (uint16_t)(buzzer.period * buzzer.dutycycle);
+    pattern_custom[0].off = buzzer.period - pattern_custom[0].on;
+    play_pattern(E_BUZZER_PATTERN_CUSTOM);
+
+    xSemaphoreGive(buzzer_mutex);
+}
+
+/** ************************************************************* *
+ * @brief       select the pattern played by the buzzer. 
+ *              Nothing is done if the pattern is already playing
+ *              so it can be called periodically.
+ * 
+ * @param       pattern 
+ * ************************************************************* **/
+void API_BUZZER_SET_PATTERN(ENUM_BUZZER_PATTERN_t pattern)
+{
+    if(pattern >= E_BUZZER_PATTERN_NB) return;
+
+    xSemaphoreTake(buzzer_mutex, portMAX_DELAY);
+
+    if(pattern != pattern_current || pattern == E_BUZZER_PATTERN_CUSTOM)
+    {
+        play_pattern(pattern);
+    }
+
+    xSemaphoreGive(buzzer_mutex);
 }
 
 /* ------------------------------------------------------------- --
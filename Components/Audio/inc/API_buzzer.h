@@ -17,11 +17,30 @@
 -- ------------------------------------------------------------- */
 #include "stdint.h"
 
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* List of patterns available for this API.
+ * Each pattern loops until an other one is selected */
+typedef enum
+{
+    E_BUZZER_PATTERN_NONE,          /* buzzer off */
+    E_BUZZER_PATTERN_CUSTOM,        /* set by API_BUZZER_SEND_PARAMETER */
+    E_BUZZER_PATTERN_WAIT,          /* waiting on the pad */
+    E_BUZZER_PATTERN_ARMED,         /* morse A */
+    E_BUZZER_PATTERN_ASCEND,        /* flight until deploy */
+    E_BUZZER_PATTERN_DESCEND,       /* after the deploy */
+    E_BUZZER_PATTERN_SENSOR_FAULT,  /* morse S */
+    E_BUZZER_PATTERN_BATTERY_LOW,   /* morse B */
+    E_BUZZER_PATTERN_NB
+}ENUM_BUZZER_PATTERN_t;
+
 /* ------------------------------------------------------------- --
    function prototypes
 -- ------------------------------------------------------------- */
 void API_BUZZER_START(void);
 void API_BUZZER_SEND_PARAMETER(uint16_t period, float dutycycle);
+void API_BUZZER_SET_PATTERN(ENUM_BUZZER_PATTERN_t pattern);
 
 /* ------------------------------------------------------------- --
    end of file
@@ -1,6 +1,6 @@
 /** ************************************************************* *
  * @file        API_battery.c
- * @brief       
+ * @brief       Battery monitoring : voltage, current, state of charge
  * 
  * @date        2021-10-14
  * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
@@ -20,6 +20,7 @@
 #include "adc.h"
 #include "dma.h"
 #include "stdint.h"
+#include "API_periodic.h"
 
 #include "MS1_config.h"
 
@@ -28,7 +29,24 @@
 -- ------------------------------------------------------------- */
 #define BATTERY_MAX_VOLTAGE         18u     /* [volt] */
 #define BATTERY_THRESHOLD_VOLTAGE   7.5f    /* [volt] */
+#define BATTERY_THRESHOLD_SOC       10.0f   /* [%] */
 #define BATTERY_ADC_RANGE           1024u
+#define BATTERY_ADC_VREF            3.3f    /* [volt] */
+
+/* current sense amplifier of the power board. The sensitivity is
+ * the nominal one of the sense chain (5 mOhm shunt, gain of 50, 
+ * 13.2 A full scale) : to be checked with a known load on each new
+ * board. The output at 0 A differs from board to board, it is 
+ * measured at boot while no motor is running. */
+#define BATTERY_CURRENT_SENSITIVITY 0.25f   /* [volt/ampere] shunt x gain */
+#define BATTERY_CURRENT_OFFSET_MAX  0.1f    /* [volt] largest output accepted at 0 A */
+#define BATTERY_CALIB_SAMPLES       16u     /* [RTOS tick] one conversion per tick */
+
+/* nominal voltage used to convert the charge into energy (2S LiPo) */
+#define BATTERY_NOMINAL_VOLTAGE     7.4f    /* [volt] */
+
+/* integration step of the coulomb counter */
+#define BATTERY_PERIOD_HOUR         ((float)(TASK_PERIOD_BATTERY * portTICK_PERIOD_MS) / 3600000.0f)   /* [h] */
 
 #define BATTERY_ADC_VBAT_SEQ        0
 #define BATTERY_ADC_IBAT_SEQ        1
@@ -40,6 +58,12 @@
 /* ------------------------------------------------------------- --
    types
 -- ------------------------------------------------------------- */
+/* battery settings */
+typedef struct
+{
+    TYPE_BATTERY_CHARGE_t   capacity;       /* [mAh] nominal capacity */
+    float                   resistance;     /* [ohm] internal resistance + wiring */
+}STRUCT_BATTERY_CONFIG_t;
 
 /* ------------------------------------------------------------- --
    handles
@@ -50,14 +74,31 @@ QueueHandle_t QueueHandle_battery_mntr;
 /* ------------------------------------------------------------- --
    variables
 -- ------------------------------------------------------------- */
+static const STRUCT_BATTERY_CONFIG_t config_seq    = {.capacity = 1000.0f, .resistance = 0.080f};
+static const STRUCT_BATTERY_CONFIG_t config_motor1 = {.capacity = 1300.0f, .resistance = 0.060f};
+static const STRUCT_BATTERY_CONFIG_t config_motor2 = {.capacity = 1300.0f, .resistance = 0.060f};
+
+/* ADC results written by the DMA */
+static volatile uint32_t adc_result[6];
+
+/* [volt] output of the current sense amplifiers at 0 A, by ADC 
+ * rank, 0 until the calibration at boot */
+static float current_offset[6] = {0};
+
+/* open circuit voltage of a 2S LiPo from 0% to 100% by steps of 10% */
+static const float ocv_table[] = {6.60f, 7.30f, 7.48f, 7.56f, 7.62f, 7.70f, 7.78f, 7.88f, 8.00f, 8.14f, 8.40f};
 
 /* ------------------------------------------------------------- --
    prototypes
 -- ------------------------------------------------------------- */
 static void handler_battery(void* parameters);
 static float convert_adc_volt(uint32_t raw_adc);
-static float convert_adc_current(uint32_t raw_adc);
-static ENUM_BATTERY_STATUS_t update_status(TYPE_BATTERY_VOLTAGE_t volt);
+static float convert_adc_current(uint32_t rank);
+static void calibrate_current(uint32_t rank);
+static float convert_ocv_soc(TYPE_BATTERY_VOLTAGE_t volt_ocv);
+static void init_capacity(STRUCT_BATTERY_DATA_t* battery, const STRUCT_BATTERY_CONFIG_t* config);
+static void update_capacity(STRUCT_BATTERY_DATA_t* battery, const STRUCT_BATTERY_CONFIG_t* config);
+static ENUM_BATTERY_STATUS_t update_status(STRUCT_BATTERY_DATA_t* battery);
 
 /* ============================================================= ==
    tasks functions
@@ -69,33 +110,57 @@ static ENUM_BATTERY_STATUS_t update_status(TYPE_BATTERY_VOLTAGE_t volt);
  * ************************************************************* **/
 static void handler_battery(void* parameters)
 {
-    TickType_t xLastWakeTime;
-    xLastWakeTime = xTaskGetTickCount();
-
     STRUCT_BATTERY_t DATA = {0};
 
-    uint32_t adc_result[6]; 
-    HAL_ADC_Start_DMA(&hadc3, adc_result, 6); // start adc in DMA mode
+    HAL_ADC_Start_DMA(&hadc3, (uint32_t*)adc_result, 6); // start adc in DMA mode
+
+    /* wait for the first conversions */
+    vTaskDelay(1);
+
+    /* offset of the current sense amplifiers, no motor is running */
+    calibrate_current(BATTERY_ADC_IBAT_SEQ);
+    calibrate_current(BATTERY_ADC_IBAT_MOTOR_1);
+    calibrate_current(BATTERY_ADC_IBAT_MOTOR_2);
+
+    API_PERIODIC_INIT(E_PERIODIC_BATTERY, TASK_PERIOD_BATTERY);
+
+    /* the initial capacity is given by the open circuit voltage.
+       No motor is running at startup so the current is close to 0 */
+    DATA.BAT_SEQ.volt       = convert_adc_volt(adc_result[BATTERY_ADC_VBAT_SEQ]);
+    DATA.BAT_SEQ.current    = convert_adc_current(BATTERY_ADC_IBAT_SEQ);
+    DATA.BAT_MOTOR1.volt    = convert_adc_volt(adc_result[BATTERY_ADC_VBAT_MOTOR_1]);
+    DATA.BAT_MOTOR1.current = convert_adc_current(BATTERY_ADC_IBAT_MOTOR_1);
+    DATA.BAT_MOTOR2.volt    = convert_adc_volt(adc_result[BATTERY_ADC_VBAT_MOTOR_2]);
+    DATA.BAT_MOTOR2.current = convert_adc_current(BATTERY_ADC_IBAT_MOTOR_2);
+
+    init_capacity(&DATA.BAT_SEQ, &config_seq);
+    init_capacity(&DATA.BAT_MOTOR1, &config_motor1);
+    init_capacity(&DATA.BAT_MOTOR2, &config_motor2);
 
     while(1)
     {
         /* update batteries values from ADC */
         DATA.BAT_SEQ.volt       = convert_adc_volt(adc_result[BATTERY_ADC_VBAT_SEQ]);
-        DATA.BAT_SEQ.current    = convert_adc_current(adc_result[BATTERY_ADC_IBAT_SEQ]);
+        DATA.BAT_SEQ.current    = convert_adc_current(BATTERY_ADC_IBAT_SEQ);
         DATA.BAT_MOTOR1.volt    = convert_adc_volt(adc_result[BATTERY_ADC_VBAT_MOTOR_1]);
-        DATA.BAT_MOTOR1.current = convert_adc_current(adc_result[BATTERY_ADC_IBAT_MOTOR_1]);
+        DATA.BAT_MOTOR1.current = convert_adc_current(BATTERY_ADC_IBAT_MOTOR_1);
         DATA.BAT_MOTOR2.volt    = convert_adc_volt(adc_result[BATTERY_ADC_VBAT_MOTOR_2]);
-        DATA.BAT_MOTOR2.current = convert_adc_current(adc_result[BATTERY_ADC_IBAT_MOTOR_2]);
+        DATA.BAT_MOTOR2.current = convert_adc_current(BATTERY_ADC_IBAT_MOTOR_2);
+
+        /* update batteries remaining capacity */
+        update_capacity(&DATA.BAT_SEQ, &config_seq);
+        update_capacity(&DATA.BAT_MOTOR1, &config_motor1);
+        update_capacity(&DATA.BAT_MOTOR2, &config_motor2);
 
         /* update batteries status */
-        DATA.BAT_SEQ.status    = update_status(DATA.BAT_SEQ.volt);
-        DATA.BAT_MOTOR1.status = update_status(DATA.BAT_MOTOR1.volt);
-        DATA.BAT_MOTOR2.status = update_status(DATA.BAT_MOTOR2.volt);
+        DATA.BAT_SEQ.status    = update_status(&DATA.BAT_SEQ);
+        DATA.BAT_MOTOR1.status = update_status(&DATA.BAT_MOTOR1);
+        DATA.BAT_MOTOR2.status = update_status(&DATA.BAT_MOTOR2);
 
         xQueueSend(QueueHandle_battery_mntr, &DATA, 0);
 
         /* wait until next task period */
-        vTaskDelayUntil(&xLastWakeTime, TASK_PERIOD_BATTERY);
+        API_PERIODIC_WAIT(E_PERIODIC_BATTERY);
     }
 }
 
@@ -111,28 +176,114 @@ static float convert_adc_volt(uint32_t raw_adc)
 }
 
 /** ************************************************************* *
- * @brief       
+ * @brief       convert the output of the current sense amplifier
+ *              into the battery current
  * 
- * @param       raw_adc 
- * @return      float 
+ * @param       rank    BATTERY_ADC_IBAT_xxx 
+ * @return      float   current [ampere]
+ * ************************************************************* **/
+static float convert_adc_current(uint32_t rank)
+{
+    float volt = BATTERY_ADC_VREF * ((float)adc_result[rank] / BATTERY_ADC_RANGE);
+    return ((volt - current_offset[rank]) / BATTERY_CURRENT_SENSITIVITY);
+}
+
+/** ************************************************************* *
+ * @brief       measure the output of a current sense amplifier at
+ *              0 A, mean of BATTERY_CALIB_SAMPLES conversions.
+ *              An output above BATTERY_CURRENT_OFFSET_MAX means a
+ *              current is drawn : the offset is left at 0.
+ * 
+ * @param       rank    BATTERY_ADC_IBAT_xxx 
  * ************************************************************* **/
-static float convert_adc_current(uint32_t raw_adc)
+static void calibrate_current(uint32_t rank)
 {
-    // TODO
-	return 0;
+    float volt = 0.0f;
+
+    for(uint32_t i = 0; i < BATTERY_CALIB_SAMPLES; i++)
+    {
+        volt += BATTERY_ADC_VREF * ((float)adc_result[rank] / BATTERY_ADC_RANGE);
+        vTaskDelay(1);
+    }
+    volt /= BATTERY_CALIB_SAMPLES;
+
+    current_offset[rank] = (volt <= BATTERY_CURRENT_OFFSET_MAX) ? volt : 0.0f;
+}
+
+/** ************************************************************* *
+ * @brief       estimate the state of charge from the open circuit
+ *              voltage with a linear interpolation of the table
+ * 
+ * @param       volt_ocv 
+ * @return      float   state of charge [%]
+ * ************************************************************* **/
+static float convert_ocv_soc(TYPE_BATTERY_VOLTAGE_t volt_ocv)
+{
+    const uint32_t size = sizeof(ocv_table) / sizeof(ocv_table[0]);
+    const float step = 100.0f / (size - 1);
+
+    if(volt_ocv <= ocv_table[0])        return 0.0f;
+    if(volt_ocv >= ocv_table[size - 1]) return 100.0f;
+
+    uint32_t i = 1;
+    while(volt_ocv > ocv_table[i]) i++;
+
+    return step * ((i - 1) + (volt_ocv - ocv_table[i - 1]) / (ocv_table[i] - ocv_table[i - 1]));
+}
+
+/** ************************************************************* *
+ * @brief       init the remaining capacity of a battery from its
+ *              open circuit voltage
+ * 
+ * @param       battery 
+ * @param       config 
+ * ************************************************************* **/
+static void init_capacity(STRUCT_BATTERY_DATA_t* battery, const STRUCT_BATTERY_CONFIG_t* config)
+{
+    battery->volt_ocv = battery->volt + battery->current * config->resistance;
+    battery->soc      = convert_ocv_soc(battery->volt_ocv);
+    battery->charge   = config->capacity * battery->soc / 100.0f;
+    battery->energy   = battery->charge * BATTERY_NOMINAL_VOLTAGE / 1000.0f;
+}
+
+/** ************************************************************* *
+ * @brief       integrate the current (coulomb counting) and the 
+ *              power over one task period. 
+ *              The voltage drop on the internal resistance is 
+ *              added back so that a motor running does not look 
+ *              like an empty battery.
+ * 
+ * @param       battery 
+ * @param       config 
+ * ************************************************************* **/
+static void update_capacity(STRUCT_BATTERY_DATA_t* battery, const STRUCT_BATTERY_CONFIG_t* config)
+{
+    /* voltage sag compensation */
+    battery->volt_ocv = battery->volt + battery->current * config->resistance;
+
+    /* coulomb counting */
+    battery->charge -= 1000.0f * battery->current * BATTERY_PERIOD_HOUR;
+    battery->energy -= battery->volt * battery->current * BATTERY_PERIOD_HOUR;
+
+    if(battery->charge < 0.0f)              battery->charge = 0.0f;
+    if(battery->charge > config->capacity)  battery->charge = config->capacity;
+    if(battery->energy < 0.0f)              battery->energy = 0.0f;
+
+    battery->soc = 100.0f * battery->charge / config->capacity;
 }
 
 /** ************************************************************* *
  * @brief       update the status of a battery
  * 
- * @param       volt 
+ * @param       battery 
  * @return      ENUM_BATTERY_STATUS_t 
  * ************************************************************* **/
-static ENUM_BATTERY_STATUS_t update_status(TYPE_BATTERY_VOLTAGE_t volt)
+static ENUM_BATTERY_STATUS_t update_status(STRUCT_BATTERY_DATA_t* battery)
 {
 	ENUM_BATTERY_STATUS_t result;
 
-	if(volt < BATTERY_THRESHOLD_VOLTAGE)
+	if((battery->volt_ocv < BATTERY_THRESHOLD_VOLTAGE)
+    || (battery->soc < BATTERY_THRESHOLD_SOC))
     {
     	result = E_BATTERY_KO;
     }
@@ -159,12 +310,13 @@ void API_BATTERY_START(void)
     QueueHandle_battery_mntr = xQueueCreate(1, sizeof(STRUCT_BATTERY_t));
 
     /* create the task */
-    status = xTaskCreate(handler_battery, "task_battery", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY_BATTERY, &TaskHandle_battery);
+    status = xTaskCreate(handler_battery, "task_battery", TASK_STACK_BATTERY, NULL, TASK_PRIORITY_BATTERY, &TaskHandle_battery);
     configASSERT(status == pdPASS);
 }
 
 /** ************************************************************* *
- * @brief       get the voltage and current from the batteries
+ * @brief       get the voltage, current and remaining capacity 
+ *              from the batteries
  *              -> if no new data
  * 
  * @param       dataStruct 
@@ -174,6 +326,29 @@ bool API_BATTERY_GET_MNTR(STRUCT_BATTERY_MNTR_t* monitoring)
     return (xQueueReceive(QueueHandle_battery_mntr, monitoring, (TickType_t)0)) ? true : false;
 }
 
+/** ************************************************************* *
+ * @brief       read the last current converted by the ADC.
+ *              Does not wait for the battery task, can be called
+ *              from an interrupt.
+ * 
+ * @param       ID 
+ * @return      TYPE_BATTERY_CURRENT_t 
+ * ************************************************************* **/
+TYPE_BATTERY_CURRENT_t API_BATTERY_READ_CURRENT(ENUM_BATTERY_ID_t ID)
+{
+    TYPE_BATTERY_CURRENT_t result;
+
+    switch(ID)
+    {
+        case E_BATTERY_SEQ:     result = convert_adc_current(BATTERY_ADC_IBAT_SEQ);     break;
+        case E_BATTERY_MOTOR1:  result = convert_adc_current(BATTERY_ADC_IBAT_MOTOR_1); break;
+        case E_BATTERY_MOTOR2:  result = convert_adc_current(BATTERY_ADC_IBAT_MOTOR_2); break;
+        default:                result = 0; break;
+    }
+
+    return result;
+}
+
 /* ------------------------------------------------------------- --
    end of file
 -- ------------------------------------------------------------- */
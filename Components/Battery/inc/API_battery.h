@@ -23,6 +23,16 @@
 -- ------------------------------------------------------------- */
 typedef float TYPE_BATTERY_VOLTAGE_t;
 typedef float TYPE_BATTERY_CURRENT_t;
+typedef float TYPE_BATTERY_CHARGE_t;
+typedef float TYPE_BATTERY_ENERGY_t;
+
+/* battery id */
+typedef enum
+{
+    E_BATTERY_SEQ,
+    E_BATTERY_MOTOR1,
+    E_BATTERY_MOTOR2
+}ENUM_BATTERY_ID_t;
 
 /* battery status */
 typedef enum
@@ -34,12 +44,17 @@ typedef enum
 
 /* data struct for a battery 
  * this struct can resume a battery 
- * with its status and his voltage/current */
+ * with its status and his voltage/current
+ * and the remaining capacity estimated by coulomb counting */
 typedef struct
 {
     ENUM_BATTERY_STATUS_t   status;
-    TYPE_BATTERY_VOLTAGE_t  volt;
-    TYPE_BATTERY_CURRENT_t  current;
+    TYPE_BATTERY_VOLTAGE_t  volt;           /* [volt] measured at the terminals */
+    TYPE_BATTERY_VOLTAGE_t  volt_ocv;       /* [volt] open circuit voltage (sag compensated) */
+    TYPE_BATTERY_CURRENT_t  current;        /* [ampere] */
+    TYPE_BATTERY_CHARGE_t   charge;         /* [mAh] remaining charge */
+    TYPE_BATTERY_ENERGY_t   energy;         /* [Wh] remaining energy */
+    float                   soc;            /* [%] state of charge */
 }STRUCT_BATTERY_DATA_t;
 
 /* main structure */
@@ -58,6 +73,7 @@ typedef STRUCT_BATTERY_t STRUCT_BATTERY_MNTR_t;
 -- ------------------------------------------------------------- */
 void API_BATTERY_START(void);
 bool API_BATTERY_GET_MNTR(STRUCT_BATTERY_MNTR_t* MNTR);
+TYPE_BATTERY_CURRENT_t API_BATTERY_READ_CURRENT(ENUM_BATTERY_ID_t ID);
 
 /* ------------------------------------------------------------- --
    end of file
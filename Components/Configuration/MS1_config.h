@@ -23,16 +23,42 @@
 /* TASK PRIORITIES */
 #define TASK_PRIORITY_SENSORS           (uint32_t)5     /* Sensors */
 #define TASK_PRIORITY_APPLICATION       (uint32_t)4     /* Application */
-#define TASK_PRIORITY_RECOVERY          (uint32_t)3     /* Recovery */
-#define TASK_PRIORITY_PAYLOAD           (uint32_t)3     /* Payload */
+#define TASK_PRIORITY_TELEMETRY         (uint32_t)2     /* Application telemetry (decimated streams) */
+#define TASK_PRIORITY_ACTUATOR          (uint32_t)3     /* Actuator (recovery and payload) */
 #define TASK_PRIORITY_BATTERY           (uint32_t)2     /* Battery */
-#define TASK_PRIORITY_BUZZER            (uint32_t)1     /* Audio */
+#define TASK_PRIORITY_GNSS              (uint32_t)2     /* GNSS */
 #define TASK_PRIORITY_HMI               (uint32_t)1     /* HMI */
+#define TASK_PRIORITY_HMI_RX            (uint32_t)1     /* HMI reception */
+#define TASK_PRIORITY_HEALTH            (uint32_t)1     /* Health */
+#define TASK_PRIORITY_RADIO             (uint32_t)1     /* Radio */
+#define TASK_PRIORITY_DATALOGGER        (uint32_t)1     /* Datalogger */
+
+/* TASK STACK SIZES */                                  /* [word] */
+/* Estimated from the call depth of each task, about twice the need.
+ * The health task reports the high water mark of each stack. */
+#define TASK_STACK_SENSORS              (uint32_t)384   /* I2C, biquad bank, kalman (float context) */
+#define TASK_STACK_APPLICATION          (uint32_t)512   /* flight FSM, hmi texts (vsnprintf) */
+#define TASK_STACK_TELEMETRY_HMI        (uint32_t)512   /* hmi texts (vsnprintf) */
+#define TASK_STACK_TELEMETRY_RADIO      (uint32_t)256
+#define TASK_STACK_ACTUATOR             (uint32_t)256
+#define TASK_STACK_BATTERY              (uint32_t)256
+#define TASK_STACK_GNSS                 (uint32_t)384   /* NMEA / UBX parser */
+#define TASK_STACK_HMI                  (uint32_t)256
+#define TASK_STACK_HMI_RX               (uint32_t)384   /* TinyFrame parser and listeners */
+#define TASK_STACK_HEALTH               (uint32_t)384   /* report payloads */
+#define TASK_STACK_RADIO                (uint32_t)256
+#define TASK_STACK_DATALOGGER           (uint32_t)520   /* block codec */
 
 /* TASK PERIOD DELAY */                                 /* [RTOS tick = 10ms/tick] */
 #define TASK_PERIOD_APPLICATION         (uint32_t)1     /* [RTOS tick] */
-#define TASK_PERIOD_RECOVERY            (uint32_t)10    /* [RTOS tick] */
 #define TASK_PERIOD_BATTERY             (uint32_t)100   /* [RTOS tick] */
+#define TASK_PERIOD_HEALTH              (uint32_t)1000  /* [RTOS tick] */
+
+/* TASK DEADLINES */
+#define PERIODIC_FAULT_MISSES           (uint32_t)3     /* deadline misses in a row raising the fault */
+
+/* TRACE */
+#define TRACE_SYSVIEW_ENABLE            1               /* 0 : no user events, 1 : SystemView user events */
 
 #endif /* _MS1_CONFIG_H_ */
 /* ------------------------------------------------------------- --
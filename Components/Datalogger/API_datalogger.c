@@ -0,0 +1,509 @@
+/** ************************************************************* *
+ * @file        API_datalogger.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "API_datalogger.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "string.h"
+#include "stddef.h"
+#include "main.h"
+
+#include "log_flash.h"
+#include "log_page.h"
+#include "log_codec.h"
+#include "API_HMI.h"
+#include "API_health.h"
+
+#include "MS1_config.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define DATALOGGER_QUEUE_SIZE       16u     /* [record] 80 ms of imu and baro */
+#define DATALOGGER_CMD_PERIOD       100u    /* [ms] commands checked while idle */
+
+/* Pre-trigger ring : the last records at full rate. Before the
+ * trigger, the records leaving the ring are decimated into the log.
+ * At the trigger the ring is frozen and committed in order, it then
+ * buffers the records to the flash at full rate. */
+#define DATALOGGER_RING_SIZE        512u    /* [record] power of 2, 2.5 s of imu and baro at 100 Hz */
+#define DATALOGGER_DECIMATION       10u     /* 1 imu and baro record out of 10 before the trigger */
+#define DATALOGGER_DRAIN            16u     /* [record] committed per loop */
+
+/* programming order of a page : body, crc, then the sequence number
+ * which marks the page as complete */
+#define DATALOGGER_BODY             sizeof(STRUCT_LOG_PAGE_HEAD_t)
+#define DATALOGGER_CRC              offsetof(STRUCT_LOG_PAGE_HEAD_t, used)
+#define DATALOGGER_SEQ              offsetof(STRUCT_LOG_PAGE_HEAD_t, seq)
+
+/* notification bits of the datalogger task */
+#define DATALOGGER_NOTIFY_DUMP      (1u << E_DATALOGGER_CMD_DUMP)
+#define DATALOGGER_NOTIFY_ERASE     (1u << E_DATALOGGER_CMD_ERASE)
+#define DATALOGGER_NOTIFY_TRIGGER   (1u << E_DATALOGGER_CMD_TRIGGER)
+#define DATALOGGER_NOTIFY_REARM     (1u << E_DATALOGGER_CMD_REARM)
+
+/* ------------------------------------------------------------- --
+   handles
+-- ------------------------------------------------------------- */
+TaskHandle_t TaskHandle_datalogger;
+QueueHandle_t QueueHandle_datalogger;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+/* page being filled, programmed when the next record doesn't fit */
+static uint8_t datalogger_page[LOG_PAGE_SIZE] __attribute__((aligned(4)));
+static uint32_t datalogger_fill = 0;        /* [byte] records in the body */
+static uint32_t datalogger_head = 0;        /* [byte] offset of the page in the log */
+static uint32_t datalogger_seq = 0;         /* sequence number of the page */
+
+static STRUCT_LOG_RECORD_t datalogger_ring[DATALOGGER_RING_SIZE];
+static uint32_t datalogger_ring_head = 0;   /* next record written */
+static uint32_t datalogger_ring_tail = 0;   /* oldest record */
+static bool datalogger_triggered = false;
+static uint32_t datalogger_decimation[E_LOG_REC_BOOT + 1u];
+
+/* imu and baro records waiting for a full block of the codec */
+static STRUCT_LOG_RECORD_t datalogger_pack[E_LOG_REC_BARO + 1u][LOG_CODEC_SAMPLES];
+static uint32_t datalogger_pack_nb[E_LOG_REC_BARO + 1u];
+static uint8_t datalogger_block[LOG_CODEC_SIZE_MAX] __attribute__((aligned(4)));
+
+static STRUCT_DATALOGGER_STATS_t datalogger_stats = {0};
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static void handler_datalogger(void* parameters);
+static void mount(void);
+static void append(const STRUCT_LOG_HEAD_t* head, const void* data);
+static void store(const STRUCT_LOG_RECORD_t* record);
+static void pack(uint8_t type);
+static void flush(void);
+static bool program(uint32_t offset, uint32_t len);
+static void log_boot(void);
+static void push(const STRUCT_LOG_RECORD_t* record);
+static void drain(uint32_t nb);
+static bool decimate(const STRUCT_LOG_RECORD_t* record);
+
+/* ============================================================= ==
+   tasks functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       This task writes the records in the flash, page by
+ *              page, through the pre-trigger ring. The commands 
+ *              (dump, erase, trigger) are received as notification
+ *              bits.
+ * 
+ * @param       parameters 
+ * ************************************************************* **/
+static void handler_datalogger(void* parameters)
+{
+    STRUCT_LOG_RECORD_t record;
+    uint32_t command;
+    TickType_t wait;
+
+    mount();
+    log_boot();
+
+    while(1)
+    {
+        /* no wait while the ring is committed */
+        wait = (datalogger_triggered && datalogger_ring_head != datalogger_ring_tail) ? 0u : pdMS_TO_TICKS(DATALOGGER_CMD_PERIOD);
+
+        if(xQueueReceive(QueueHandle_datalogger, &record, wait) == pdTRUE)
+        {
+            push(&record);
+        }
+        if(datalogger_triggered == true) drain(DATALOGGER_DRAIN);
+
+        if(xTaskNotifyWait(0u, UINT32_MAX, &command, (TickType_t)0) == pdTRUE)
+        {
+            if(command & DATALOGGER_NOTIFY_TRIGGER)
+            {
+                datalogger_triggered = true;
+
+                taskENTER_CRITICAL();
+                datalogger_stats.triggers++;
+                taskEXIT_CRITICAL();
+            }
+
+            if(command & DATALOGGER_NOTIFY_REARM)
+            {
+                /* the records still in the ring are not decimated */
+                drain(DATALOGGER_RING_SIZE);
+                pack(E_LOG_REC_IMU);
+                pack(E_LOG_REC_BARO);
+                datalogger_triggered = false;
+            }
+
+            if(command & DATALOGGER_NOTIFY_ERASE)
+            {
+                log_flash_erase();
+                datalogger_head = 0;
+                datalogger_fill = 0;
+                datalogger_seq  = 0;
+                datalogger_ring_tail = datalogger_ring_head;
+                memset(datalogger_pack_nb, 0, sizeof(datalogger_pack_nb));
+
+                taskENTER_CRITICAL();
+                datalogger_stats.used = 0;
+                taskEXIT_CRITICAL();
+            }
+
+            if(command & DATALOGGER_NOTIFY_DUMP)
+            {
+                /* the ring, the blocks and the open page are committed, 
+                   the next records start a new page */
+                drain(DATALOGGER_RING_SIZE);
+                pack(E_LOG_REC_IMU);
+                pack(E_LOG_REC_BARO);
+                flush();
+                API_HMI_STREAM(HMI_ID_LOG_DUMP, log_flash_map(0), datalogger_head);
+            }
+        }
+    }
+}
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       find the end of the log after a reset (binary search
+ *              of the first page without sequence number, a few 
+ *              microseconds). A page torn by a power cut gets its 
+ *              sequence number : it stays corrupted (crc) but the
+ *              programmed pages are still a prefix of the log.
+ *              The rest of the head sector must be erased (at most
+ *              one sector read), else an erase was cut and the log
+ *              restarts at the next sector (log_flash_erase).
+ * 
+ * ************************************************************* **/
+static void mount(void)
+{
+    uint32_t page = log_page_search(log_flash_map, LOG_FLASH_PAGES);
+    uint32_t torn = 0;
+    uint32_t end;
+
+    datalogger_head = page * LOG_PAGE_SIZE;
+    datalogger_seq  = page;
+    datalogger_fill = 0;
+
+    if(page < LOG_FLASH_PAGES && log_page_check(log_flash_map(datalogger_head)) == E_LOG_PAGE_TORN)
+    {
+        STRUCT_LOG_PAGE_HEAD_t head = {.seq = datalogger_seq};
+
+        memcpy(datalogger_page, &head, sizeof(head));
+        program(DATALOGGER_SEQ, DATALOGGER_CRC - DATALOGGER_SEQ);
+
+        datalogger_head += LOG_PAGE_SIZE;
+        datalogger_seq++;
+        torn++;
+    }
+
+    end = (datalogger_head / LOG_FLASH_SECTOR_SIZE + 1u) * LOG_FLASH_SECTOR_SIZE;
+    if(datalogger_head < LOG_FLASH_SIZE && log_page_erased(log_flash_map(datalogger_head), end - datalogger_head) == false)
+    {
+        datalogger_head = end;
+        datalogger_seq  = end / LOG_PAGE_SIZE;
+        torn++;
+    }
+
+    taskENTER_CRITICAL();
+    datalogger_stats.used = datalogger_head;
+    datalogger_stats.torn += torn;
+    taskEXIT_CRITICAL();
+}
+
+/** ************************************************************* *
+ * @brief       first record after a reset : the reset flags tell 
+ *              a brown-out from a watchdog or a power on
+ * 
+ * ************************************************************* **/
+static void log_boot(void)
+{
+    STRUCT_LOG_RECORD_t record;
+
+    record.head.type       = E_LOG_REC_BOOT;
+    record.head.size       = sizeof(STRUCT_LOG_BOOT_t);
+    record.head.reserved   = 0;
+    record.head.time       = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    record.data.boot.reset = RCC->CSR;
+    RCC->CSR |= RCC_CSR_RMVF;
+
+    append(&record.head, &record.data);
+}
+
+/** ************************************************************* *
+ * @brief       add a record to the ring. Before the trigger the 
+ *              oldest record is replaced, it goes in the log only
+ *              if it is kept by the decimation. After the trigger
+ *              the ring is a FIFO to the flash.
+ * 
+ * @param       record 
+ * ************************************************************* **/
+static void push(const STRUCT_LOG_RECORD_t* record)
+{
+    if(datalogger_ring_head - datalogger_ring_tail >= DATALOGGER_RING_SIZE)
+    {
+        if(datalogger_triggered == true)
+        {
+            /* flash slower than the sensors */
+            taskENTER_CRITICAL();
+            datalogger_stats.dropped++;
+            taskEXIT_CRITICAL();
+            return;
+        }
+
+        const STRUCT_LOG_RECORD_t* oldest = &datalogger_ring[datalogger_ring_tail & (DATALOGGER_RING_SIZE - 1u)];
+        if(decimate(oldest) == false) store(oldest);
+        datalogger_ring_tail++;
+    }
+
+    datalogger_ring[datalogger_ring_head & (DATALOGGER_RING_SIZE - 1u)] = *record;
+    datalogger_ring_head++;
+}
+
+/** ************************************************************* *
+ * @brief       commit the oldest records of the ring in the log
+ * 
+ * @param       nb      max number of records 
+ * ************************************************************* **/
+static void drain(uint32_t nb)
+{
+    while(nb-- > 0u && datalogger_ring_tail != datalogger_ring_head)
+    {
+        store(&datalogger_ring[datalogger_ring_tail & (DATALOGGER_RING_SIZE - 1u)]);
+        datalogger_ring_tail++;
+    }
+}
+
+/** ************************************************************* *
+ * @brief       decimation of the records leaving the ring before
+ *              the trigger. The phase and boot records are kept.
+ * 
+ * @param       record 
+ * @return      true    record left out 
+ * @return      false   record kept 
+ * ************************************************************* **/
+static bool decimate(const STRUCT_LOG_RECORD_t* record)
+{
+    if(record->head.type != E_LOG_REC_IMU && record->head.type != E_LOG_REC_BARO) return false;
+
+    if((datalogger_decimation[record->head.type]++ % DATALOGGER_DECIMATION) == 0u) return false;
+
+    taskENTER_CRITICAL();
+    datalogger_stats.decimated++;
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+/** ************************************************************* *
+ * @brief       program a part of the page buffer at the same place
+ *              in the head page of the log
+ * 
+ * @param       offset  [byte] in the page 
+ * @param       len 
+ * @return      true 
+ * @return      false 
+ * ************************************************************* **/
+static bool program(uint32_t offset, uint32_t len)
+{
+    return log_flash_program(datalogger_head + offset, &datalogger_page[offset], len);
+}
+
+/** ************************************************************* *
+ * @brief       write a record in the log : the imu and baro records
+ *              are compressed by blocks of LOG_CODEC_SAMPLES, the
+ *              others are written as is
+ * 
+ * @param       record 
+ * ************************************************************* **/
+static void store(const STRUCT_LOG_RECORD_t* record)
+{
+    uint8_t type = record->head.type;
+
+    taskENTER_CRITICAL();
+    datalogger_stats.raw_bytes += sizeof(STRUCT_LOG_HEAD_t) + record->head.size;
+    taskEXIT_CRITICAL();
+
+    if(log_codec_supported(type) == false || type > E_LOG_REC_BARO)
+    {
+        append(&record->head, &record->data);
+        return;
+    }
+
+    datalogger_pack[type][datalogger_pack_nb[type]++] = *record;
+    if(datalogger_pack_nb[type] == LOG_CODEC_SAMPLES) pack(type);
+}
+
+/** ************************************************************* *
+ * @brief       compress the waiting records of a type in one
+ *              E_LOG_REC_PACK record
+ * 
+ * @param       type    E_LOG_REC_IMU or E_LOG_REC_BARO 
+ * ************************************************************* **/
+static void pack(uint8_t type)
+{
+    STRUCT_LOG_HEAD_t head = {.type = E_LOG_REC_PACK, .reserved = 0};
+    uint32_t len;
+
+    if(datalogger_pack_nb[type] == 0u) return;
+
+    len = log_codec_encode(datalogger_pack[type], datalogger_pack_nb[type], datalogger_block, sizeof(datalogger_block));
+    head.size = (uint8_t)len;
+    head.time = datalogger_pack[type][0].head.time;
+    if(len > 0u) append(&head, datalogger_block);
+
+    datalogger_pack_nb[type] = 0;
+}
+
+/** ************************************************************* *
+ * @brief       add a record to the page, the page is programmed 
+ *              first if the record doesn't fit
+ * 
+ * @param       head 
+ * @param       data    payload, head->size bytes 
+ * ************************************************************* **/
+static void append(const STRUCT_LOG_HEAD_t* head, const void* data)
+{
+    uint32_t size = sizeof(STRUCT_LOG_HEAD_t) + head->size;
+
+    if(datalogger_fill + size > LOG_PAGE_DATA) flush();
+
+    if(datalogger_head >= LOG_FLASH_SIZE)
+    {
+        /* log full */
+        taskENTER_CRITICAL();
+        datalogger_stats.dropped++;
+        taskEXIT_CRITICAL();
+        return;
+    }
+
+    memcpy(&datalogger_page[DATALOGGER_BODY + datalogger_fill], head, sizeof(STRUCT_LOG_HEAD_t));
+    memcpy(&datalogger_page[DATALOGGER_BODY + datalogger_fill + sizeof(STRUCT_LOG_HEAD_t)], data, head->size);
+    datalogger_fill += size;
+
+    taskENTER_CRITICAL();
+    datalogger_stats.records++;
+    datalogger_stats.bytes += size;
+    taskEXIT_CRITICAL();
+}
+
+/** ************************************************************* *
+ * @brief       program the page, the end of the page is padded
+ *              with the erased value (E_LOG_REC_END). The sequence
+ *              number is programmed last : a power cut before it
+ *              leaves a torn page, skipped by the next mount.
+ * 
+ * ************************************************************* **/
+static void flush(void)
+{
+    bool status;
+
+    if(datalogger_fill == 0u || datalogger_head >= LOG_FLASH_SIZE) return;
+
+    memset(&datalogger_page[DATALOGGER_BODY + datalogger_fill], LOG_ERASED, LOG_PAGE_DATA - datalogger_fill);
+    log_page_seal(datalogger_page, datalogger_seq, datalogger_fill);
+
+    /* the sequence number is programmed even after an error : the
+     * page is then corrupted, the mount must not stop on it */
+    status  = program(DATALOGGER_BODY, LOG_PAGE_DATA);
+    status &= program(DATALOGGER_CRC, DATALOGGER_BODY - DATALOGGER_CRC);
+    status &= program(DATALOGGER_SEQ, DATALOGGER_CRC - DATALOGGER_SEQ);
+
+    /* a failed page is skipped, it is not programmed again */
+    datalogger_head += LOG_PAGE_SIZE;
+    datalogger_seq++;
+    datalogger_fill = 0;
+
+    taskENTER_CRITICAL();
+    datalogger_stats.used = datalogger_head;
+    datalogger_stats.errors += (status == true) ? 0u : 1u;
+    taskEXIT_CRITICAL();
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       init and start the datalogger task
+ * 
+ * ************************************************************* **/
+void API_DATALOGGER_START(void)
+{
+    BaseType_t status;
+
+    QueueHandle_datalogger = xQueueCreate(DATALOGGER_QUEUE_SIZE, sizeof(STRUCT_LOG_RECORD_t));
+    API_HEALTH_ADD_QUEUE(QueueHandle_datalogger);
+
+    /* the codec works on the stack (deltas of a block) */
+    status = xTaskCreate(handler_datalogger, "task_datalogger", TASK_STACK_DATALOGGER, NULL, TASK_PRIORITY_DATALOGGER, &TaskHandle_datalogger);
+    configASSERT(status == pdPASS);
+}
+
+/** ************************************************************* *
+ * @brief       log a record, timestamped now. Never blocks, the
+ *              record is dropped when the queue is full.
+ * 
+ * @param       type 
+ * @param       data    payload of the record 
+ * @param       size    [byte] multiple of 4 
+ * ************************************************************* **/
+void API_DATALOGGER_WRITE(ENUM_LOG_REC_t type, const void* data, uint8_t size)
+{
+    STRUCT_LOG_RECORD_t record;
+
+    if(size > sizeof(record.data)) size = sizeof(record.data);
+
+    record.head.type     = (uint8_t)type;
+    record.head.size     = size;
+    record.head.reserved = 0;
+    record.head.time     = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    memcpy(&record.data, data, size);
+
+    if(xQueueSend(QueueHandle_datalogger, &record, (TickType_t)0) != pdTRUE)
+    {
+        taskENTER_CRITICAL();
+        datalogger_stats.dropped++;
+        taskEXIT_CRITICAL();
+    }
+}
+
+/** ************************************************************* *
+ * @brief       send a ground command to the datalogger. The dump
+ *              and the erase stall the task, never in flight.
+ * 
+ * @param       command 
+ * ************************************************************* **/
+void API_DATALOGGER_SEND_CMD(ENUM_DATALOGGER_CMD_t command)
+{
+    xTaskNotify(TaskHandle_datalogger, 1u << command, eSetBits);
+}
+
+/** ************************************************************* *
+ * @brief       read the statistics of the log
+ * 
+ * @param       stats 
+ * ************************************************************* **/
+void API_DATALOGGER_GET_STATS(STRUCT_DATALOGGER_STATS_t* stats)
+{
+    taskENTER_CRITICAL();
+    *stats = datalogger_stats;
+    taskEXIT_CRITICAL();
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
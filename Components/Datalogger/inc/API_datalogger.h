@@ -1,38 +1,60 @@
 /** ************************************************************* *
- * @file        API_recovery.h
+ * @file        API_datalogger.h
  * @brief       
  * 
- * @date        2021-10-11
+ * @date        2026-10-19
  * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
  * 
  * Mines Space
  * 
  * ************************************************************* **/
 
-#ifndef RECOVERY_INC_API_RECOVERY_H_
-#define RECOVERY_INC_API_RECOVERY_H_
+#ifndef DATALOGGER_INC_API_DATALOGGER_H_
+#define DATALOGGER_INC_API_DATALOGGER_H_
 
 /* ------------------------------------------------------------- --
    includes
 -- ------------------------------------------------------------- */
 #include "stdint.h"
 #include "stdbool.h"
+#include "log_format.h"
 
 /* ------------------------------------------------------------- --
    types
 -- ------------------------------------------------------------- */
-/* id */
+/* commands. The dump and the erase on the ground only */
+typedef enum
+{
+    E_DATALOGGER_CMD_DUMP,      /* send the log to the hmi */
+    E_DATALOGGER_CMD_ERASE,     /* erase the log (several seconds) */
+    E_DATALOGGER_CMD_TRIGGER,   /* commit the pre-trigger ring, then full rate */
+    E_DATALOGGER_CMD_REARM      /* back to the pre-trigger ring */
+}ENUM_DATALOGGER_CMD_t;
+
+/* statistics of the log */
+typedef struct
+{
+    uint32_t records;           /* records written (a block counts for one) */
+    uint32_t raw_bytes;         /* [byte] records before the compression */
+    uint32_t bytes;             /* [byte] records written, raw_bytes / bytes : gain of the codec */
+    uint32_t dropped;           /* queue full or log full */
+    uint32_t used;              /* [byte] pages written */
+    uint32_t errors;            /* flash programming errors */
+    uint32_t torn;              /* pages torn by a power cut, or sector of a cut erase, skipped at the mount */
+    uint32_t decimated;         /* records left out of the log before the trigger */
+    uint32_t triggers;
+}STRUCT_DATALOGGER_STATS_t;
 
 /* ------------------------------------------------------------- --
    function propotypes
 -- ------------------------------------------------------------- */
 void API_DATALOGGER_START(void);
-void API_DATALOGGER_SEND_CMD(ENUM_RECOV_CMD_t command);
-bool API_DATALOGGER_GET_MNTR(STRUCT_RECOV_MNTR_t* monitoring);
-
+void API_DATALOGGER_WRITE(ENUM_LOG_REC_t type, const void* data, uint8_t size);
+void API_DATALOGGER_SEND_CMD(ENUM_DATALOGGER_CMD_t command);
+void API_DATALOGGER_GET_STATS(STRUCT_DATALOGGER_STATS_t* stats);
 
 /* ------------------------------------------------------------- --
    end of file
 -- ------------------------------------------------------------- */
 
-#endif /* RECOVERY_INC_API_RECOVERY_H_ */
+#endif /* DATALOGGER_INC_API_DATALOGGER_H_ */
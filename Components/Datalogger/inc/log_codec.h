@@ -0,0 +1,59 @@
+/** ************************************************************* *
+ * @file        log_codec.h
+ * @brief       Lossless compression of the sensor records of the
+ *              flight log by blocks of LOG_CODEC_SAMPLES records.
+ *              No dependency on the RTOS nor on the HAL, shared
+ *              with the host decoder.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef DATALOGGER_INC_LOG_CODEC_H_
+#define DATALOGGER_INC_LOG_CODEC_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+#include "log_format.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* Block (payload of E_LOG_REC_PACK) :
+ * - STRUCT_LOG_PACK_t
+ * - payload of the first sample, as is
+ * - bit stream, low bits first : width of each channel (6 bits)
+ *   then, channel by channel, the zigzag of the delta to the
+ *   previous sample on width bits. The channels are the time and
+ *   the fields of the record.
+ * - padding to 4 bytes
+ * The time of a block is bounded : no search, at most 5 byte
+ * accesses per value. */
+#define LOG_CODEC_SAMPLES           8u
+#define LOG_CODEC_CHANNELS          9u      /* time + 8 fields of the imu */
+#define LOG_CODEC_WIDTH_BITS        6u
+
+/* [byte] worst case : incompressible 16 bits fields, 32 bits time */
+#define LOG_CODEC_SIZE_MAX          ((sizeof(STRUCT_LOG_PACK_t) + sizeof(STRUCT_LOG_IMU_t)                  \
+                                    + (LOG_CODEC_CHANNELS * LOG_CODEC_WIDTH_BITS                            \
+                                    + (LOG_CODEC_SAMPLES - 1u) * (32u + (LOG_CODEC_CHANNELS - 1u) * 17u)    \
+                                    + 31u) / 32u * 4u))
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+bool log_codec_supported(uint8_t type);
+uint32_t log_codec_encode(const STRUCT_LOG_RECORD_t *samples, uint32_t count, uint8_t *block, uint32_t size);
+uint32_t log_codec_decode(const uint8_t *block, uint32_t size, uint32_t time, STRUCT_LOG_RECORD_t *samples, uint32_t max);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* DATALOGGER_INC_LOG_CODEC_H_ */
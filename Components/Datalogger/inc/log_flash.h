@@ -0,0 +1,46 @@
+/** ************************************************************* *
+ * @file        log_flash.h
+ * @brief       Storage of the flight log : upper half of the
+ *              internal flash (sectors 8 to 11, single bank).
+ *              The addresses are offsets in the log area.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef DATALOGGER_INC_LOG_FLASH_H_
+#define DATALOGGER_INC_LOG_FLASH_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+#include "log_format.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* smaller sectors on the host (Tools/powercut_test) */
+#ifndef LOG_FLASH_SECTOR_SIZE
+#define LOG_FLASH_SECTOR_SIZE       (256u * 1024u)  /* [byte] */
+#endif
+#define LOG_FLASH_SECTORS           4u
+#define LOG_FLASH_SIZE              (LOG_FLASH_SECTORS * LOG_FLASH_SECTOR_SIZE)
+#define LOG_FLASH_PAGES             (LOG_FLASH_SIZE / LOG_PAGE_SIZE)
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+const uint8_t* log_flash_map(uint32_t offset);
+bool log_flash_program(uint32_t offset, const uint8_t *data, uint32_t len);
+bool log_flash_erase(void);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* DATALOGGER_INC_LOG_FLASH_H_ */
@@ -0,0 +1,138 @@
+/** ************************************************************* *
+ * @file        log_format.h
+ * @brief       Format of the flight log in flash. Shared with the
+ *              host decoder (Tools/log_decoder) : fixed width
+ *              fields, little endian, no dependency.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef DATALOGGER_INC_LOG_FORMAT_H_
+#define DATALOGGER_INC_LOG_FORMAT_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* The log is a list of pages, each page is a header then a list of
+ * records. A record never crosses a page, the end of a page is
+ * padded with the erased value. All the sizes are multiple of 4
+ * bytes. */
+#define LOG_PAGE_SIZE               256u    /* [byte] */
+#define LOG_PAGE_DATA               (LOG_PAGE_SIZE - sizeof(STRUCT_LOG_PAGE_HEAD_t))
+#define LOG_ERASED                  0xFFu
+#define LOG_SEQ_ERASED              0xFFFFFFFFu
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* header of a page. The body is programmed first, then the crc and
+ * the sequence number last : a page with a sequence number is
+ * complete, a power cut leaves the sequence number erased.
+ * crc : CRC-16/ARC of seq, used and the used bytes of the body */
+typedef struct
+{
+    uint32_t    seq;            /* page number since the erase */
+    uint16_t    used;           /* [byte] records in the body */
+    uint16_t    crc;
+}STRUCT_LOG_PAGE_HEAD_t;
+
+/* record types */
+typedef enum
+{
+    E_LOG_REC_IMU       = 0x01,
+    E_LOG_REC_BARO      = 0x02,
+    E_LOG_REC_PHASE     = 0x03,
+    E_LOG_REC_BOOT      = 0x04,
+    E_LOG_REC_PACK      = 0x05,     /* block of imu or baro records, log_codec */
+    E_LOG_REC_LATENCY   = 0x06,     /* checkpoint of the deploy chain, API_latency */
+    E_LOG_REC_END       = LOG_ERASED    /* rest of the page unused */
+}ENUM_LOG_REC_t;
+
+/* header of a record */
+typedef struct
+{
+    uint8_t     type;           /* ENUM_LOG_REC_t */
+    uint8_t     size;           /* [byte] payload */
+    uint16_t    reserved;
+    uint32_t    time;           /* [ms] from the boot */
+}STRUCT_LOG_HEAD_t;
+
+/* inertial sensor */
+typedef struct
+{
+    int16_t     accel[3];       /* raw */
+    int16_t     gyro[3];        /* raw */
+    int16_t     angle_x;        /* [0.01 deg] kalman */
+    int16_t     angle_y;        /* [0.01 deg] kalman */
+}STRUCT_LOG_IMU_t;
+
+/* barometer */
+typedef struct
+{
+    int32_t     pressure;       /* [Pa] */
+    int32_t     altitude;       /* [cm] above the ground */
+    int16_t     temperature;    /* [0.01 degC] */
+    int16_t     reserved;
+}STRUCT_LOG_BARO_t;
+
+/* flight phase change */
+typedef struct
+{
+    uint8_t     phase;          /* ENUM_FLIGHT_PHASE_t */
+    uint8_t     reserved[3];
+}STRUCT_LOG_PHASE_t;
+
+/* start of the firmware, the time restarts from 0 */
+typedef struct
+{
+    uint32_t    reset;          /* RCC CSR : reset flags (brown-out, watchdog...) */
+}STRUCT_LOG_BOOT_t;
+
+/* latency of a checkpoint of the deploy chain */
+typedef struct
+{
+    uint8_t     point;          /* ENUM_LATENCY_POINT_t */
+    uint8_t     reserved;
+    uint16_t    count;          /* chains measured */
+    uint32_t    last;           /* [us] since the previous checkpoint */
+    uint32_t    max;            /* [us] */
+}STRUCT_LOG_LATENCY_t;
+
+/* block of records of the same type, compressed by log_codec. The 
+ * time of the record is the time of the first sample. Followed by 
+ * the payload of the first sample, then the bit stream. */
+typedef struct
+{
+    uint8_t     type;           /* ENUM_LOG_REC_t of the samples */
+    uint8_t     count;          /* number of samples */
+    uint16_t    reserved;
+}STRUCT_LOG_PACK_t;
+
+/* record, as queued to the datalogger */
+typedef struct
+{
+    STRUCT_LOG_HEAD_t head;
+    union
+    {
+        STRUCT_LOG_IMU_t    imu;
+        STRUCT_LOG_BARO_t   baro;
+        STRUCT_LOG_PHASE_t  phase;
+        STRUCT_LOG_BOOT_t   boot;
+        STRUCT_LOG_LATENCY_t latency;
+    }data;
+}STRUCT_LOG_RECORD_t;
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* DATALOGGER_INC_LOG_FORMAT_H_ */
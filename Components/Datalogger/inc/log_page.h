@@ -0,0 +1,51 @@
+/** ************************************************************* *
+ * @file        log_page.h
+ * @brief       Pages of the flight log : seal, check and search of
+ *              the write head. No dependency on the RTOS nor on
+ *              the HAL, shared with the host decoder.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef DATALOGGER_INC_LOG_PAGE_H_
+#define DATALOGGER_INC_LOG_PAGE_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+#include "log_format.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* state of a page in flash */
+typedef enum
+{
+    E_LOG_PAGE_VALID,
+    E_LOG_PAGE_ERASED,          /* never programmed */
+    E_LOG_PAGE_TORN,            /* power cut while programming */
+    E_LOG_PAGE_CORRUPTED        /* crc mismatch */
+}ENUM_LOG_PAGE_t;
+
+/* memory mapped log : address of a page */
+typedef const uint8_t* (*TYPE_LOG_PAGE_MAP_t)(uint32_t offset);
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+void log_page_seal(uint8_t *page, uint32_t seq, uint32_t used);
+ENUM_LOG_PAGE_t log_page_check(const uint8_t *page);
+uint32_t log_page_search(TYPE_LOG_PAGE_MAP_t map, uint32_t pages);
+bool log_page_erased(const uint8_t *data, uint32_t len);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* DATALOGGER_INC_LOG_PAGE_H_ */
@@ -0,0 +1,350 @@
+/** ************************************************************* *
+ * @file        log_codec.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "log_codec.h"
+#include "stddef.h"
+#include "string.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* field of a record : offset in the payload and size (2 or 4) */
+typedef struct
+{
+    uint8_t offset;
+    uint8_t size;
+}STRUCT_LOG_FIELD_t;
+
+/* fields of a record type */
+typedef struct
+{
+    uint8_t type;
+    uint8_t size;               /* [byte] payload */
+    uint8_t nb;
+    STRUCT_LOG_FIELD_t field[LOG_CODEC_CHANNELS - 1u];
+}STRUCT_LOG_LAYOUT_t;
+
+/* bit stream, low bits first */
+typedef struct
+{
+    uint8_t *data;
+    uint32_t size;              /* [byte] */
+    uint32_t pos;               /* [bit] */
+}STRUCT_LOG_BITS_t;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+static const STRUCT_LOG_LAYOUT_t layouts[] = {
+    {
+        .type = E_LOG_REC_IMU, .size = sizeof(STRUCT_LOG_IMU_t), .nb = 8,
+        .field = {
+            {offsetof(STRUCT_LOG_IMU_t, accel[0]), 2}, {offsetof(STRUCT_LOG_IMU_t, accel[1]), 2},
+            {offsetof(STRUCT_LOG_IMU_t, accel[2]), 2}, {offsetof(STRUCT_LOG_IMU_t, gyro[0]), 2},
+            {offsetof(STRUCT_LOG_IMU_t, gyro[1]), 2},  {offsetof(STRUCT_LOG_IMU_t, gyro[2]), 2},
+            {offsetof(STRUCT_LOG_IMU_t, angle_x), 2},  {offsetof(STRUCT_LOG_IMU_t, angle_y), 2},
+        },
+    },
+    {
+        .type = E_LOG_REC_BARO, .size = sizeof(STRUCT_LOG_BARO_t), .nb = 3,
+        .field = {
+            {offsetof(STRUCT_LOG_BARO_t, pressure), 4}, {offsetof(STRUCT_LOG_BARO_t, altitude), 4},
+            {offsetof(STRUCT_LOG_BARO_t, temperature), 2},
+        },
+    },
+};
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static const STRUCT_LOG_LAYOUT_t* get_layout(uint8_t type);
+static int32_t get_channel(const STRUCT_LOG_LAYOUT_t *layout, const STRUCT_LOG_RECORD_t *sample, uint32_t channel);
+static void set_channel(const STRUCT_LOG_LAYOUT_t *layout, STRUCT_LOG_RECORD_t *sample, uint32_t channel, int32_t value);
+static bool put_bits(STRUCT_LOG_BITS_t *bits, uint32_t value, uint32_t width);
+static bool get_bits(STRUCT_LOG_BITS_t *bits, uint32_t *value, uint32_t width);
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       fields of a record type
+ * 
+ * @param       type 
+ * @return      const STRUCT_LOG_LAYOUT_t*  NULL : not compressed 
+ * ************************************************************* **/
+static const STRUCT_LOG_LAYOUT_t* get_layout(uint8_t type)
+{
+    for(uint32_t i = 0; i < sizeof(layouts) / sizeof(layouts[0]); i++)
+    {
+        if(layouts[i].type == type) return &layouts[i];
+    }
+    return NULL;
+}
+
+/** ************************************************************* *
+ * @brief       value of a channel : 0 time, then the fields 
+ * 
+ * @param       layout 
+ * @param       sample 
+ * @param       channel 
+ * @return      int32_t 
+ * ************************************************************* **/
+static int32_t get_channel(const STRUCT_LOG_LAYOUT_t *layout, const STRUCT_LOG_RECORD_t *sample, uint32_t channel)
+{
+    const uint8_t *data = (const uint8_t*)&sample->data;
+    const STRUCT_LOG_FIELD_t *field;
+    int16_t value16;
+    int32_t value32;
+
+    if(channel == 0u) return (int32_t)sample->head.time;
+
+    field = &layout->field[channel - 1u];
+    if(field->size == 2u)
+    {
+        memcpy(&value16, &data[field->offset], sizeof(value16));
+        return value16;
+    }
+    memcpy(&value32, &data[field->offset], sizeof(value32));
+    return value32;
+}
+
+/** ************************************************************* *
+ * @brief       write a channel, the value is truncated to the size
+ *              of the field
+ * 
+ * @param       layout 
+ * @param       sample 
+ * @param       channel 
+ * @param       value 
+ * ************************************************************* **/
+static void set_channel(const STRUCT_LOG_LAYOUT_t *layout, STRUCT_LOG_RECORD_t *sample, uint32_t channel, int32_t value)
+{
+    uint8_t *data = (uint8_t*)&sample->data;
+    const STRUCT_LOG_FIELD_t *field;
+    int16_t value16 = (int16_t)value;
+
+    if(channel == 0u)
+    {
+        sample->head.time = (uint32_t)value;
+        return;
+    }
+
+    field = &layout->field[channel - 1u];
+    if(field->size == 2u)
+    {
+        memcpy(&data[field->offset], &value16, sizeof(value16));
+    }
+    else
+    {
+        memcpy(&data[field->offset], &value, sizeof(value));
+    }
+}
+
+/** ************************************************************* *
+ * @brief       append bits to the stream, byte by byte. The stream
+ *              must be cleared first.
+ * 
+ * @param       bits 
+ * @param       value 
+ * @param       width   0 to 32 
+ * @return      true 
+ * @return      false   stream full 
+ * ************************************************************* **/
+static bool put_bits(STRUCT_LOG_BITS_t *bits, uint32_t value, uint32_t width)
+{
+    if(bits->pos + width > bits->size * 8u) return false;
+
+    while(width > 0u)
+    {
+        uint32_t shift = bits->pos & 7u;
+        uint32_t nb = (8u - shift < width) ? 8u - shift : width;
+
+        bits->data[bits->pos >> 3] |= (uint8_t)((value & ((1u << nb) - 1u)) << shift);
+        value >>= nb;
+        bits->pos += nb;
+        width -= nb;
+    }
+    return true;
+}
+
+/** ************************************************************* *
+ * @brief       read bits from the stream
+ * 
+ * @param       bits 
+ * @param       value 
+ * @param       width   0 to 32 
+ * @return      true 
+ * @return      false   end of the stream 
+ * ************************************************************* **/
+static bool get_bits(STRUCT_LOG_BITS_t *bits, uint32_t *value, uint32_t width)
+{
+    uint32_t done = 0;
+
+    if(bits->pos + width > bits->size * 8u) return false;
+
+    *value = 0;
+    while(done < width)
+    {
+        uint32_t shift = bits->pos & 7u;
+        uint32_t nb = (8u - shift < width - done) ? 8u - shift : width - done;
+
+        *value |= (uint32_t)((bits->data[bits->pos >> 3] >> shift) & ((1u << nb) - 1u)) << done;
+        bits->pos += nb;
+        done += nb;
+    }
+    return true;
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       record type compressed by the codec
+ * 
+ * @param       type    ENUM_LOG_REC_t 
+ * @return      true 
+ * @return      false 
+ * ************************************************************* **/
+bool log_codec_supported(uint8_t type)
+{
+    return get_layout(type) != NULL;
+}
+
+/** ************************************************************* *
+ * @brief       compress a block of records of the same type. The
+ *              time of the first sample is the time of the record
+ *              E_LOG_REC_PACK.
+ * 
+ * @param       samples 
+ * @param       count   1 to LOG_CODEC_SAMPLES 
+ * @param       block   payload of the E_LOG_REC_PACK record 
+ * @param       size    [byte] LOG_CODEC_SIZE_MAX is always enough 
+ * @return      uint32_t [byte] length of the block, 0 on error 
+ * ************************************************************* **/
+uint32_t log_codec_encode(const STRUCT_LOG_RECORD_t *samples, uint32_t count, uint8_t *block, uint32_t size)
+{
+    const STRUCT_LOG_LAYOUT_t *layout = get_layout(samples[0].head.type);
+    STRUCT_LOG_PACK_t pack = {.type = samples[0].head.type, .count = (uint8_t)count, .reserved = 0};
+    uint32_t start = sizeof(pack) + ((layout != NULL) ? layout->size : 0u);
+    STRUCT_LOG_BITS_t bits = {.data = &block[start], .size = size - start, .pos = 0};
+    uint32_t zigzag[LOG_CODEC_CHANNELS][LOG_CODEC_SAMPLES];
+    uint32_t width[LOG_CODEC_CHANNELS];
+    bool ok = true;
+
+    if(layout == NULL || count == 0u || count > LOG_CODEC_SAMPLES || size < start) return 0;
+
+    memcpy(block, &pack, sizeof(pack));
+    memcpy(&block[sizeof(pack)], &samples[0].data, layout->size);
+    memset(&block[start], 0, size - start);
+
+    /* deltas and width of each channel */
+    for(uint32_t c = 0; c <= layout->nb; c++)
+    {
+        uint32_t max = 0;
+
+        for(uint32_t i = 1; i < count; i++)
+        {
+            int32_t delta = (int32_t)((uint32_t)get_channel(layout, &samples[i], c) - (uint32_t)get_channel(layout, &samples[i - 1u], c));
+
+            zigzag[c][i] = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+            max |= zigzag[c][i];
+        }
+
+        width[c] = 0;
+        while(width[c] < 32u && (max >> width[c]) != 0u) width[c]++;
+        ok &= put_bits(&bits, width[c], LOG_CODEC_WIDTH_BITS);
+    }
+
+    for(uint32_t c = 0; c <= layout->nb; c++)
+    {
+        for(uint32_t i = 1; i < count; i++)
+        {
+            ok &= put_bits(&bits, zigzag[c][i], width[c]);
+        }
+    }
+
+    if(ok == false) return 0;
+
+    /* padding to 4 bytes */
+    return (start + (bits.pos + 7u) / 8u + 3u) & ~3u;
+}
+
+/** ************************************************************* *
+ * @brief       decompress a block
+ * 
+ * @param       block   payload of the E_LOG_REC_PACK record 
+ * @param       size    [byte] 
+ * @param       time    [ms] time of the E_LOG_REC_PACK record 
+ * @param       samples 
+ * @param       max     size of samples 
+ * @return      uint32_t number of samples, 0 : corrupted block 
+ * ************************************************************* **/
+uint32_t log_codec_decode(const uint8_t *block, uint32_t size, uint32_t time, STRUCT_LOG_RECORD_t *samples, uint32_t max)
+{
+    const STRUCT_LOG_LAYOUT_t *layout;
+    STRUCT_LOG_BITS_t bits;
+    STRUCT_LOG_PACK_t pack;
+    uint32_t width[LOG_CODEC_CHANNELS];
+    uint32_t start;
+
+    if(size < sizeof(pack)) return 0;
+    memcpy(&pack, block, sizeof(pack));
+
+    layout = get_layout(pack.type);
+    if(layout == NULL || pack.count == 0u || pack.count > max) return 0;
+
+    start = sizeof(pack) + layout->size;
+    if(size < start) return 0;
+
+    bits.data = (uint8_t*)&block[start];
+    bits.size = size - start;
+    bits.pos  = 0;
+
+    /* first sample as is */
+    memset(samples, 0, pack.count * sizeof(STRUCT_LOG_RECORD_t));
+    samples[0].head.type = pack.type;
+    samples[0].head.size = layout->size;
+    samples[0].head.time = time;
+    memcpy(&samples[0].data, &block[sizeof(pack)], layout->size);
+
+    for(uint32_t c = 0; c <= layout->nb; c++)
+    {
+        if(get_bits(&bits, &width[c], LOG_CODEC_WIDTH_BITS) == false || width[c] > 32u) return 0;
+    }
+
+    for(uint32_t c = 0; c <= layout->nb; c++)
+    {
+        for(uint32_t i = 1; i < pack.count; i++)
+        {
+            uint32_t zigzag;
+
+            if(get_bits(&bits, &zigzag, width[c]) == false) return 0;
+
+            int32_t delta = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1u);
+            set_channel(layout, &samples[i], c, (int32_t)((uint32_t)get_channel(layout, &samples[i - 1u], c) + (uint32_t)delta));
+        }
+    }
+
+    for(uint32_t i = 1; i < pack.count; i++)
+    {
+        samples[i].head.type = pack.type;
+        samples[i].head.size = layout->size;
+    }
+
+    return pack.count;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
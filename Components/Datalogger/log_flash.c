@@ -0,0 +1,103 @@
+/** ************************************************************* *
+ * @file        log_flash.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "log_flash.h"
+#include "main.h"
+#include "string.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* sector 8 of the 2 MB single bank flash. The firmware must stay
+ * below this address (1 MB) */
+#define LOG_FLASH_BASE              0x08100000u
+#define LOG_FLASH_FIRST_SECTOR      FLASH_SECTOR_8
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       the flash is memory mapped : the log is read (and
+ *              sent by DMA) in place
+ * 
+ * @param       offset 
+ * @return      const uint8_t* 
+ * ************************************************************* **/
+const uint8_t* log_flash_map(uint32_t offset)
+{
+    return (const uint8_t*)(LOG_FLASH_BASE + offset);
+}
+
+/** ************************************************************* *
+ * @brief       program erased bytes, by words of 32 bits. The CPU
+ *              is stalled while a word is written (the code runs
+ *              from the same bank), about 1 ms for a page.
+ * 
+ * @param       offset  multiple of 4 
+ * @param       data 
+ * @param       len     multiple of 4 
+ * @return      true 
+ * @return      false   programming error, or out of the log area 
+ * ************************************************************* **/
+bool log_flash_program(uint32_t offset, const uint8_t *data, uint32_t len)
+{
+    HAL_StatusTypeDef status = HAL_OK;
+    uint32_t word;
+
+    if((offset & 3u) != 0u || (len & 3u) != 0u || offset + len > LOG_FLASH_SIZE) return false;
+
+    HAL_FLASH_Unlock();
+    for(uint32_t i = 0; i < len && status == HAL_OK; i += 4u)
+    {
+        memcpy(&word, &data[i], sizeof(word));
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, LOG_FLASH_BASE + offset + i, word);
+    }
+    HAL_FLASH_Lock();
+
+    return status == HAL_OK;
+}
+
+/** ************************************************************* *
+ * @brief       erase the whole log area. Takes several seconds,
+ *              only on the ground. The last sector is erased first :
+ *              a power cut leaves a prefix of the log, one damaged
+ *              sector then erased sectors (skipped by the mount).
+ * 
+ * @return      true 
+ * @return      false 
+ * ************************************************************* **/
+bool log_flash_erase(void)
+{
+    FLASH_EraseInitTypeDef erase = {0};
+    uint32_t error = 0;
+    HAL_StatusTypeDef status = HAL_OK;
+
+    erase.TypeErase    = FLASH_TYPEERASE_SECTORS;
+    erase.NbSectors    = 1u;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+    HAL_FLASH_Unlock();
+    for(uint32_t i = LOG_FLASH_SECTORS; i > 0u && status == HAL_OK; i--)
+    {
+        erase.Sector = LOG_FLASH_FIRST_SECTOR + i - 1u;
+        status = HAL_FLASHEx_Erase(&erase, &error);
+    }
+    HAL_FLASH_Lock();
+
+    return status == HAL_OK;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,172 @@
+/** ************************************************************* *
+ * @file        log_page.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "log_page.h"
+#include "stdbool.h"
+#include "stddef.h"
+#include "string.h"
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+/* CRC-16/ARC (poly 0x8005 reflected, init 0), 4 bits at a time,
+ * as the radio frames */
+static const uint16_t crc16_nibble[16] = {
+    0x0000, 0xCC01, 0xD801, 0x1400, 0xF001, 0x3C00, 0x2800, 0xE401,
+    0xA001, 0x6C00, 0x7800, 0xB401, 0x5000, 0x9C01, 0x8801, 0x4400
+};
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static uint16_t crc16(uint16_t crc, const uint8_t *data, uint32_t len);
+static uint16_t page_crc(const uint8_t *page, uint32_t used);
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       CRC-16/ARC of a block, chained
+ * 
+ * @param       crc     0 for the first block 
+ * @param       data 
+ * @param       len 
+ * @return      uint16_t 
+ * ************************************************************* **/
+static uint16_t crc16(uint16_t crc, const uint8_t *data, uint32_t len)
+{
+    for(uint32_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ crc16_nibble[crc & 0x0Fu];
+        crc = (crc >> 4) ^ crc16_nibble[crc & 0x0Fu];
+    }
+
+    return crc;
+}
+
+/** ************************************************************* *
+ * @brief       crc of a page : sequence number, used length and
+ *              the records (the padding is not covered)
+ * 
+ * @param       page 
+ * @param       used 
+ * @return      uint16_t 
+ * ************************************************************* **/
+static uint16_t page_crc(const uint8_t *page, uint32_t used)
+{
+    uint16_t crc = crc16(0u, page, offsetof(STRUCT_LOG_PAGE_HEAD_t, crc));
+
+    return crc16(crc, &page[sizeof(STRUCT_LOG_PAGE_HEAD_t)], used);
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       write the header of a page before programming. The
+ *              body after the records must already be padded.
+ * 
+ * @param       page    LOG_PAGE_SIZE bytes 
+ * @param       seq 
+ * @param       used    [byte] records in the body 
+ * ************************************************************* **/
+void log_page_seal(uint8_t *page, uint32_t seq, uint32_t used)
+{
+    STRUCT_LOG_PAGE_HEAD_t head = {.seq = seq, .used = (uint16_t)used, .crc = 0};
+
+    memcpy(page, &head, sizeof(head));
+    head.crc = page_crc(page, used);
+    memcpy(page, &head, sizeof(head));
+}
+
+/** ************************************************************* *
+ * @brief       state of a page read from the flash
+ * 
+ * @param       page    LOG_PAGE_SIZE bytes 
+ * @return      ENUM_LOG_PAGE_t 
+ * ************************************************************* **/
+ENUM_LOG_PAGE_t log_page_check(const uint8_t *page)
+{
+    STRUCT_LOG_PAGE_HEAD_t head;
+
+    memcpy(&head, page, sizeof(head));
+
+    if(head.seq == LOG_SEQ_ERASED)
+    {
+        return log_page_erased(page, LOG_PAGE_SIZE) ? E_LOG_PAGE_ERASED : E_LOG_PAGE_TORN;
+    }
+
+    if(head.used > LOG_PAGE_DATA || head.crc != page_crc(page, head.used)) return E_LOG_PAGE_CORRUPTED;
+
+    return E_LOG_PAGE_VALID;
+}
+
+/** ************************************************************* *
+ * @brief       find the write head : first page without sequence
+ *              number. The pages are programmed in order, the
+ *              programmed pages are a prefix of the log : binary
+ *              search, 12 reads for 4096 pages.
+ *              A torn page at the head is not erased and must be
+ *              skipped by the caller (log_page_check), as a sector
+ *              left damaged by a cut erase (log_page_erased).
+ * 
+ * @param       map     address of a page 
+ * @param       pages   number of pages of the log 
+ * @return      uint32_t    index of the page, pages if the log is full 
+ * ************************************************************* **/
+uint32_t log_page_search(TYPE_LOG_PAGE_MAP_t map, uint32_t pages)
+{
+    uint32_t low = 0;
+    uint32_t high = pages;
+
+    while(low < high)
+    {
+        uint32_t mid = low + (high - low) / 2u;
+        STRUCT_LOG_PAGE_HEAD_t head;
+
+        memcpy(&head, map(mid * LOG_PAGE_SIZE), sizeof(head));
+        if(head.seq != LOG_SEQ_ERASED)
+        {
+            low = mid + 1u;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/** ************************************************************* *
+ * @brief       check that a block of the log is erased
+ * 
+ * @param       data 
+ * @param       len 
+ * @return      true 
+ * @return      false 
+ * ************************************************************* **/
+bool log_page_erased(const uint8_t *data, uint32_t len)
+{
+    for(uint32_t i = 0; i < len; i++)
+    {
+        if(data[i] != LOG_ERASED) return false;
+    }
+    return true;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
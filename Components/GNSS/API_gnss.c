@@ -0,0 +1,733 @@
+/** ************************************************************* *
+ * @file        API_gnss.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "API_gnss.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "main.h"
+#include "string.h"
+
+#include "MS1_config.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* UART5 (TX PC12, RX PD2) -> DMA1 stream 0 channel 4 (circular).
+ * Reserved in MS1_scheduler.ioc, the interrupt handlers call
+ * API_GNSS_CALLBACK_ISR without the HAL handlers. UART4 (PA0/PA1)
+ * is used by the HMI */
+#define GNSS_UART                   UART5
+#define GNSS_UART_IRQ               UART5_IRQn
+#define GNSS_UART_CLOCK             24000000u   /* [Hz] APB1 */
+#define GNSS_BAUDRATE               9600u
+#define GNSS_DMA                    DMA1_Stream0
+#define GNSS_DMA_CHANNEL            4u
+#define GNSS_DMA_IRQ                DMA1_Stream0_IRQn
+#define GNSS_IRQ_PRIORITY           6u
+
+/* parser */
+#define GNSS_RING_SIZE              512u        /* power of 2 */
+#define GNSS_RING_MASK              (GNSS_RING_SIZE - 1u)
+#define GNSS_NMEA_MAX               82u         /* [byte] longest NMEA sentence */
+#define GNSS_UBX_MAX                (GNSS_RING_SIZE / 2u)   /* [byte] longest UBX payload */
+#define GNSS_TIMEOUT                1000u       /* [ms] */
+
+/* UBX */
+#define GNSS_UBX_SYNC1              0xB5u
+#define GNSS_UBX_SYNC2              0x62u
+#define GNSS_UBX_NAV_PVT            0x0107u     /* class, id */
+#define GNSS_UBX_NAV_PVT_LEN        92u
+
+/* byte of the ring at a free running index */
+#define RING(index)                 gnss_ring[(index) & GNSS_RING_MASK]
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* fields of a NMEA sentence in the ring */
+typedef struct
+{
+    uint32_t pos;                   /* free running index */
+    uint32_t end;                   /* index of the '*' */
+}STRUCT_GNSS_CURSOR_t;
+
+/* ------------------------------------------------------------- --
+   handles
+-- ------------------------------------------------------------- */
+TaskHandle_t TaskHandle_gnss;
+QueueHandle_t QueueHandle_gnss;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+static uint8_t gnss_ring[GNSS_RING_SIZE];
+static uint32_t gnss_tail = 0;      /* first byte not parsed (free running) */
+
+static STRUCT_GNSS_GPS_t gnss_gps = {0};
+static STRUCT_GNSS_STATS_t gnss_stats = {0};
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static void handler_gnss(void* parameters);
+
+static void init_uart(void);
+static void parse(uint32_t head);
+static uint32_t find_byte(uint32_t start, uint32_t len, uint8_t value);
+static uint32_t skip(uint32_t start, uint32_t avail);
+
+static uint32_t parse_nmea(uint32_t start, uint32_t avail);
+static bool check_nmea(uint32_t start, uint32_t end);
+static bool next_field(STRUCT_GNSS_CURSOR_t* cur);
+static bool read_fixed(const STRUCT_GNSS_CURSOR_t* cur, uint8_t decimals, int32_t* value);
+static uint8_t read_char(const STRUCT_GNSS_CURSOR_t* cur);
+static int32_t to_degrees(int32_t value);
+static bool decode_gga(uint32_t start, uint32_t end);
+static bool decode_rmc(uint32_t start, uint32_t end);
+
+static uint32_t parse_ubx(uint32_t start, uint32_t avail);
+static uint32_t read_u32(uint32_t pos);
+static void decode_nav_pvt(uint32_t payload);
+
+static void publish(void);
+
+/* ============================================================= ==
+   tasks functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       This task parses the bytes received in the DMA ring.
+ *              It is woken up by the idle line (end of a burst of
+ *              the receiver) and the half/full transfer interrupts.
+ * 
+ * @param       parameters 
+ * ************************************************************* **/
+static void handler_gnss(void* parameters)
+{
+    uint32_t head = 0;
+    uint32_t pos;
+
+    while(1)
+    {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(GNSS_TIMEOUT));
+
+        /* position of the DMA, the ring is read at least twice per turn */
+        pos   = (GNSS_RING_SIZE - GNSS_DMA->NDTR) & GNSS_RING_MASK;
+        head += (pos - head) & GNSS_RING_MASK;
+
+        parse(head);
+    }
+}
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       init UART5 and its DMA at register level
+ * 
+ * ************************************************************* **/
+static void init_uart(void)
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOCEN | RCC_AHB1ENR_GPIODEN | RCC_AHB1ENR_DMA1EN;
+    RCC->APB1ENR |= RCC_APB1ENR_UART5EN;
+    (void)RCC->APB1ENR;
+
+    /* PC12 : UART5_TX (AF8), PD2 : UART5_RX (AF8, pull-up) */
+    GPIOC->MODER  = (GPIOC->MODER  & ~(3u << 24))  | (2u << 24);
+    GPIOC->AFR[1] = (GPIOC->AFR[1] & ~(15u << 16)) | (8u << 16);
+    GPIOD->MODER  = (GPIOD->MODER  & ~(3u << 4))   | (2u << 4);
+    GPIOD->PUPDR  = (GPIOD->PUPDR  & ~(3u << 4))   | (1u << 4);
+    GPIOD->AFR[0] = (GPIOD->AFR[0] & ~(15u << 8))  | (8u << 8);
+
+    /* peripheral to memory, byte, circular */
+    GNSS_DMA->CR &= ~DMA_SxCR_EN;
+    while(GNSS_DMA->CR & DMA_SxCR_EN);
+    DMA1->LIFCR = DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0;
+
+    GNSS_DMA->PAR  = (uint32_t)&GNSS_UART->RDR;
+    GNSS_DMA->M0AR = (uint32_t)gnss_ring;
+    GNSS_DMA->NDTR = GNSS_RING_SIZE;
+    GNSS_DMA->FCR  = 0u;
+    GNSS_DMA->CR   = (GNSS_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_MINC | DMA_SxCR_CIRC
+                   | DMA_SxCR_HTIE | DMA_SxCR_TCIE;
+    GNSS_DMA->CR  |= DMA_SxCR_EN;
+
+    /* 8N1, rx by DMA, idle line interrupt */
+    GNSS_UART->CR1 = 0u;
+    GNSS_UART->BRR = GNSS_UART_CLOCK / GNSS_BAUDRATE;
+    GNSS_UART->CR3 = USART_CR3_DMAR;
+    GNSS_UART->CR1 = USART_CR1_TE | USART_CR1_RE | USART_CR1_IDLEIE | USART_CR1_UE;
+
+    HAL_NVIC_SetPriority(GNSS_DMA_IRQ, GNSS_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(GNSS_DMA_IRQ);
+    HAL_NVIC_SetPriority(GNSS_UART_IRQ, GNSS_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(GNSS_UART_IRQ);
+}
+
+/** ************************************************************* *
+ * @brief       parse the frames received up to head. The frames
+ *              are decoded in place, an incomplete frame is kept
+ *              for the next call.
+ * 
+ * @param       head    free running index of the DMA 
+ * ************************************************************* **/
+static void parse(uint32_t head)
+{
+    uint32_t used;
+    uint8_t c;
+
+    /* overrun : the oldest bytes were overwritten by the DMA */
+    if(head - gnss_tail > GNSS_RING_SIZE)
+    {
+        gnss_stats.skipped += head - gnss_tail - GNSS_RING_SIZE;
+        gnss_tail = head - GNSS_RING_SIZE;
+    }
+
+    while(gnss_tail != head)
+    {
+        c = RING(gnss_tail);
+
+        if(c == '$')
+        {
+            used = parse_nmea(gnss_tail, head - gnss_tail);
+        }
+        else if(c == GNSS_UBX_SYNC1)
+        {
+            used = parse_ubx(gnss_tail, head - gnss_tail);
+        }
+        else
+        {
+            used = skip(gnss_tail, head - gnss_tail);
+        }
+
+        /* frame not complete */
+        if(used == 0u) break;
+
+        gnss_tail += used;
+    }
+}
+
+/** ************************************************************* *
+ * @brief       search a byte in the ring (two spans at most)
+ * 
+ * @param       start 
+ * @param       len 
+ * @param       value 
+ * @return      uint32_t    offset from start, len if not found 
+ * ************************************************************* **/
+static uint32_t find_byte(uint32_t start, uint32_t len, uint8_t value)
+{
+    uint32_t index = start & GNSS_RING_MASK;
+    uint32_t first = (len < GNSS_RING_SIZE - index) ? len : GNSS_RING_SIZE - index;
+    const uint8_t* found;
+
+    found = memchr(&gnss_ring[index], value, first);
+    if(found != NULL) return (uint32_t)(found - &gnss_ring[index]);
+
+    if(len > first)
+    {
+        found = memchr(gnss_ring, value, len - first);
+        if(found != NULL) return first + (uint32_t)(found - gnss_ring);
+    }
+
+    return len;
+}
+
+/** ************************************************************* *
+ * @brief       skip the bytes until the next frame
+ * 
+ * @param       start 
+ * @param       avail 
+ * @return      uint32_t    bytes skipped 
+ * ************************************************************* **/
+static uint32_t skip(uint32_t start, uint32_t avail)
+{
+    uint32_t nmea = find_byte(start, avail, '$');
+    uint32_t ubx  = find_byte(start, nmea, GNSS_UBX_SYNC1);
+
+    gnss_stats.skipped += ubx;
+    return ubx;
+}
+
+/** ************************************************************* *
+ * @brief       parse a NMEA sentence "$ttSSS,...*hh\r\n".
+ *              Only the line end is searched, the checksum and
+ *              the fields are read for the decoded types only.
+ *              A sentence cut by a '$' is dropped up to the '$' :
+ *              the next sentence is not lost with it.
+ * 
+ * @param       start 
+ * @param       avail 
+ * @return      uint32_t    bytes used, 0 if not complete 
+ * ************************************************************* **/
+static uint32_t parse_nmea(uint32_t start, uint32_t avail)
+{
+    uint32_t max = (avail < GNSS_NMEA_MAX) ? avail : GNSS_NMEA_MAX;
+    uint32_t end = find_byte(start, max, '\n');
+    uint32_t cut;
+    bool ok;
+
+    if(end == max)
+    {
+        if(avail < GNSS_NMEA_MAX) return 0u;
+
+        /* no line end, not a sentence */
+        gnss_stats.errors++;
+        return 1u;
+    }
+
+    /* truncated sentence */
+    cut = 1u + find_byte(start + 1u, end - 1u, '$');
+    if(cut < end)
+    {
+        gnss_stats.errors++;
+        return cut;
+    }
+    end += start;
+
+    if(RING(start + 3u) == 'G' && RING(start + 4u) == 'G' && RING(start + 5u) == 'A')
+    {
+        ok = check_nmea(start, end) && decode_gga(start, end);
+    }
+    else if(RING(start + 3u) == 'R' && RING(start + 4u) == 'M' && RING(start + 5u) == 'C')
+    {
+        ok = check_nmea(start, end) && decode_rmc(start, end);
+    }
+    else
+    {
+        gnss_stats.ignored++;
+        return end - start + 1u;
+    }
+
+    if(ok == true)  gnss_stats.nmea++;
+    else            gnss_stats.errors++;
+
+    return end - start + 1u;
+}
+
+/** ************************************************************* *
+ * @brief       check the checksum of a NMEA sentence
+ * 
+ * @param       start   index of the '$' 
+ * @param       end     index of the '\n' 
+ * @return      true    valid 
+ * @return      false   invalid 
+ * ************************************************************* **/
+static bool check_nmea(uint32_t start, uint32_t end)
+{
+    uint8_t cksum = 0;
+    uint8_t ref = 0;
+    uint8_t c;
+    uint32_t pos;
+
+    for(pos = start + 1u; pos != end; pos++)
+    {
+        c = RING(pos);
+        if(c == '*') break;
+        cksum ^= c;
+    }
+
+    if(end - pos < 3u) return false;
+
+    for(uint32_t i = 1; i <= 2u; i++)
+    {
+        c = RING(pos + i);
+        if(c >= '0' && c <= '9')        ref = (uint8_t)((ref << 4) | (c - '0'));
+        else if(c >= 'A' && c <= 'F')   ref = (uint8_t)((ref << 4) | (c - 'A' + 10u));
+        else return false;
+    }
+
+    return (cksum == ref);
+}
+
+/** ************************************************************* *
+ * @brief       move the cursor to the next field
+ * 
+ * @param       cur 
+ * @return      true    next field 
+ * @return      false   end of the sentence 
+ * ************************************************************* **/
+static bool next_field(STRUCT_GNSS_CURSOR_t* cur)
+{
+    uint8_t c;
+
+    while(cur->pos != cur->end)
+    {
+        c = RING(cur->pos);
+        if(c == '*') return false;
+
+        cur->pos++;
+        if(c == ',') return true;
+    }
+
+    return false;
+}
+
+/** ************************************************************* *
+ * @brief       read a decimal field as a fixed point value
+ * 
+ * @param       cur 
+ * @param       decimals    digits kept after the point 
+ * @param       value       value * 10^decimals 
+ * @return      true    value read 
+ * @return      false   empty field 
+ * ************************************************************* **/
+static bool read_fixed(const STRUCT_GNSS_CURSOR_t* cur, uint8_t decimals, int32_t* value)
+{
+    uint32_t pos = cur->pos;
+    int64_t result = 0;
+    uint8_t nb = 0;
+    bool negative = false;
+    bool fraction = false;
+    bool digit = false;
+    uint8_t c;
+
+    while(pos != cur->end)
+    {
+        c = RING(pos++);
+
+        if(c >= '0' && c <= '9')
+        {
+            /* digits past the range are dropped (saturated below) */
+            if((fraction == false || nb < decimals) && result <= INT32_MAX)
+            {
+                result = result * 10 + (c - '0');
+                if(fraction == true) nb++;
+            }
+            digit = true;
+        }
+        else if(c == '.')   fraction = true;
+        else if(c == '-')   negative = true;
+        else break;
+    }
+
+    for(; nb < decimals; nb++) result *= 10;
+    if(result > INT32_MAX) result = INT32_MAX;
+
+    *value = (int32_t)(negative ? -result : result);
+    return digit;
+}
+
+/** ************************************************************* *
+ * @brief       first character of a field
+ * 
+ * @param       cur 
+ * @return      uint8_t     0 if empty 
+ * ************************************************************* **/
+static uint8_t read_char(const STRUCT_GNSS_CURSOR_t* cur)
+{
+    uint8_t c = (cur->pos != cur->end) ? RING(cur->pos) : 0u;
+
+    return (c == ',' || c == '*') ? 0u : c;
+}
+
+/** ************************************************************* *
+ * @brief       convert a NMEA angle "dddmm.mmmmm" (5 decimals)
+ * 
+ * @param       value 
+ * @return      int32_t     [1e-7 deg] 
+ * ************************************************************* **/
+static int32_t to_degrees(int32_t value)
+{
+    int32_t degrees = value / 10000000;
+    int32_t minutes = value % 10000000;     /* [1e-5 min] */
+
+    return degrees * 10000000 + (int32_t)(((int64_t)minutes * 5) / 3);
+}
+
+/** ************************************************************* *
+ * @brief       decode "$--GGA,time,lat,N,lon,E,quality,sats,hdop,
+ *              alt,M,..." and publish the fix
+ * 
+ * @param       start 
+ * @param       end 
+ * @return      true    decoded 
+ * @return      false   format error 
+ * ************************************************************* **/
+static bool decode_gga(uint32_t start, uint32_t end)
+{
+    STRUCT_GNSS_CURSOR_t cur = {.pos = start, .end = end};
+    int32_t value;
+    bool position = true;
+
+    /* time hhmmss.ss */
+    if(next_field(&cur) == false) return false;
+    if(read_fixed(&cur, 2u, &value) == true)
+    {
+        gnss_gps.time = (uint32_t)(((value / 1000000) * 3600 + ((value / 10000) % 100) * 60
+                      + (value / 100) % 100) * 1000 + (value % 100) * 10);
+    }
+
+    /* latitude */
+    if(next_field(&cur) == false) return false;
+    position &= read_fixed(&cur, 5u, &value);
+    gnss_gps.lat = to_degrees(value);
+    if(next_field(&cur) == false) return false;
+    if(read_char(&cur) == 'S') gnss_gps.lat = -gnss_gps.lat;
+
+    /* longitude */
+    if(next_field(&cur) == false) return false;
+    position &= read_fixed(&cur, 5u, &value);
+    gnss_gps.lon = to_degrees(value);
+    if(next_field(&cur) == false) return false;
+    if(read_char(&cur) == 'W') gnss_gps.lon = -gnss_gps.lon;
+
+    /* quality */
+    if(next_field(&cur) == false) return false;
+    read_fixed(&cur, 0u, &value);
+    gnss_gps.fix = (value > 0 && position == true) ? E_GNSS_FIX_3D : E_GNSS_FIX_NONE;
+
+    /* satellites, hdop */
+    if(next_field(&cur) == false) return false;
+    if(read_fixed(&cur, 0u, &value) == true) gnss_gps.sats = (uint8_t)value;
+    if(next_field(&cur) == false) return false;
+    if(read_fixed(&cur, 2u, &value) == true) gnss_gps.hdop = (uint16_t)value;
+
+    /* altitude [mm] */
+    if(next_field(&cur) == false) return false;
+    if(read_fixed(&cur, 3u, &value) == true) gnss_gps.alt = value;
+
+    publish();
+    return true;
+}
+
+/** ************************************************************* *
+ * @brief       decode "$--RMC,time,status,lat,N,lon,E,speed,..."
+ *              Only the ground speed is used, the fix is published
+ *              with the next GGA. The speed of a sentence without
+ *              a valid fix (status 'V') is not used.
+ * 
+ * @param       start 
+ * @param       end 
+ * @return      true    decoded 
+ * @return      false   format error 
+ * ************************************************************* **/
+static bool decode_rmc(uint32_t start, uint32_t end)
+{
+    STRUCT_GNSS_CURSOR_t cur = {.pos = start, .end = end};
+    int32_t value;
+
+    /* skip time, status 'A' : valid, 'V' : warning */
+    for(uint8_t i = 0; i < 2u; i++)
+    {
+        if(next_field(&cur) == false) return false;
+    }
+    if(read_char(&cur) != 'A') return true;
+
+    /* skip lat, N, lon, E */
+    for(uint8_t i = 0; i < 5u; i++)
+    {
+        if(next_field(&cur) == false) return false;
+    }
+
+    /* speed [knot] -> [mm/s] */
+    if(read_fixed(&cur, 3u, &value) == true)
+    {
+        gnss_gps.speed = (uint32_t)(((int64_t)value * 1852) / 3600);
+    }
+
+    return true;
+}
+
+/** ************************************************************* *
+ * @brief       parse a UBX message "B5 62 class id len payload
+ *              ck_a ck_b". The messages not decoded are skipped
+ *              with their length, without reading the payload.
+ * 
+ * @param       start 
+ * @param       avail 
+ * @return      uint32_t    bytes used, 0 if not complete 
+ * ************************************************************* **/
+static uint32_t parse_ubx(uint32_t start, uint32_t avail)
+{
+    uint16_t type;
+    uint32_t len;
+    uint8_t ck_a = 0;
+    uint8_t ck_b = 0;
+
+    if(avail < 6u) return 0u;
+
+    if(RING(start + 1u) != GNSS_UBX_SYNC2)
+    {
+        gnss_stats.skipped++;
+        return 1u;
+    }
+
+    type = (uint16_t)((RING(start + 2u) << 8) | RING(start + 3u));
+    len  = (uint32_t)RING(start + 4u) | ((uint32_t)RING(start + 5u) << 8);
+
+    if(len > GNSS_UBX_MAX)
+    {
+        gnss_stats.errors++;
+        return 1u;
+    }
+
+    if(avail < len + 8u) return 0u;
+
+    if(type != GNSS_UBX_NAV_PVT || len != GNSS_UBX_NAV_PVT_LEN)
+    {
+        gnss_stats.ignored++;
+        return len + 8u;
+    }
+
+    /* Fletcher checksum over class, id, length and payload */
+    for(uint32_t i = 2; i < len + 6u; i++)
+    {
+        ck_a += RING(start + i);
+        ck_b += ck_a;
+    }
+
+    if(ck_a != RING(start + len + 6u) || ck_b != RING(start + len + 7u))
+    {
+        gnss_stats.errors++;
+        return 1u;
+    }
+
+    decode_nav_pvt(start + 6u);
+    gnss_stats.ubx++;
+    return len + 8u;
+}
+
+/** ************************************************************* *
+ * @brief       read a little endian word in the ring
+ * 
+ * @param       pos 
+ * @return      uint32_t 
+ * ************************************************************* **/
+static uint32_t read_u32(uint32_t pos)
+{
+    return (uint32_t)RING(pos) | ((uint32_t)RING(pos + 1u) << 8)
+         | ((uint32_t)RING(pos + 2u) << 16) | ((uint32_t)RING(pos + 3u) << 24);
+}
+
+/** ************************************************************* *
+ * @brief       decode UBX NAV-PVT and publish the fix
+ * 
+ * @param       payload     index of the payload 
+ * ************************************************************* **/
+static void decode_nav_pvt(uint32_t payload)
+{
+    int32_t nano = (int32_t)read_u32(payload + 16u);
+    uint8_t type = RING(payload + 20u);
+
+    gnss_gps.time  = ((uint32_t)RING(payload + 8u) * 3600u + (uint32_t)RING(payload + 9u) * 60u
+                   + (uint32_t)RING(payload + 10u)) * 1000u + ((nano > 0) ? (uint32_t)nano / 1000000u : 0u);
+
+    /* fix ok flag */
+    if((RING(payload + 21u) & 0x01u) == 0u) type = 0u;
+    gnss_gps.fix   = (type == 3u) ? E_GNSS_FIX_3D : (type == 2u) ? E_GNSS_FIX_2D : E_GNSS_FIX_NONE;
+
+    gnss_gps.sats  = RING(payload + 23u);
+    gnss_gps.lon   = (int32_t)read_u32(payload + 24u);
+    gnss_gps.lat   = (int32_t)read_u32(payload + 28u);
+    gnss_gps.alt   = (int32_t)read_u32(payload + 36u);
+    gnss_gps.speed = read_u32(payload + 60u);
+    gnss_gps.hdop  = (uint16_t)(RING(payload + 76u) | (RING(payload + 77u) << 8));   /* pDOP */
+
+    publish();
+}
+
+/** ************************************************************* *
+ * @brief       publish the fix, the mailbox keeps the last one
+ * 
+ * ************************************************************* **/
+static void publish(void)
+{
+    gnss_gps.tick = xTaskGetTickCount();
+    xQueueOverwrite(QueueHandle_gnss, &gnss_gps);
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       init the receiver uart and start the gnss task
+ * 
+ * ************************************************************* **/
+void API_GNSS_START(void)
+{
+    BaseType_t status;
+
+    QueueHandle_gnss = xQueueCreate(1, sizeof(STRUCT_GNSS_GPS_t));
+
+    /* create the task */
+    status = xTaskCreate(handler_gnss, "task_gnss", TASK_STACK_GNSS, NULL, TASK_PRIORITY_GNSS, &TaskHandle_gnss);
+    configASSERT(status == pdPASS);
+
+    init_uart();
+}
+
+/** ************************************************************* *
+ * @brief       get the last fix
+ * 
+ * @param       gps 
+ * @return      true    new fix received 
+ * @return      false   nothing received 
+ * ************************************************************* **/
+bool API_GNSS_GET_GPS(STRUCT_GNSS_GPS_t* gps)
+{
+    return (xQueueReceive(QueueHandle_gnss, gps, (TickType_t)0)) ? true : false;
+}
+
+/** ************************************************************* *
+ * @brief       get the parser statistics
+ * 
+ * @param       stats 
+ * ************************************************************* **/
+void API_GNSS_GET_STATS(STRUCT_GNSS_STATS_t* stats)
+{
+    taskENTER_CRITICAL();
+    *stats = gnss_stats;
+    taskEXIT_CRITICAL();
+}
+
+/** ************************************************************* *
+ * @brief       This function must be called by the UART5 and the
+ *              DMA1 stream 0 interrupts. It wakes up the gnss task
+ *              on idle line and on half or full transfer.
+ * 
+ * ************************************************************* **/
+void API_GNSS_CALLBACK_ISR(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    bool event = false;
+
+    if(GNSS_UART->ISR & USART_ISR_IDLE)
+    {
+        GNSS_UART->ICR = USART_ICR_IDLECF;
+        event = true;
+    }
+
+    if(GNSS_UART->ISR & USART_ISR_ORE)
+    {
+        GNSS_UART->ICR = USART_ICR_ORECF;
+    }
+
+    if(DMA1->LISR & (DMA_LISR_TCIF0 | DMA_LISR_HTIF0))
+    {
+        DMA1->LIFCR = DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0;
+        event = true;
+    }
+
+    if(event == true)
+    {
+        vTaskNotifyGiveFromISR(TaskHandle_gnss, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    }
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,68 @@
+/** ************************************************************* *
+ * @file        API_gnss.h
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef GNSS_INC_API_GNSS_H_
+#define GNSS_INC_API_GNSS_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* quality of the fix */
+typedef enum
+{
+    E_GNSS_FIX_NONE,
+    E_GNSS_FIX_2D,
+    E_GNSS_FIX_3D
+}ENUM_GNSS_FIX_t;
+
+/* last fix of the receiver (NMEA GGA + RMC or UBX NAV-PVT) */
+typedef struct
+{
+    ENUM_GNSS_FIX_t fix;
+    uint8_t     sats;           /* satellites used */
+    uint16_t    hdop;           /* [0.01] */
+    uint32_t    time;           /* [ms] UTC time of day */
+    int32_t     lat;            /* [1e-7 deg] */
+    int32_t     lon;            /* [1e-7 deg] */
+    int32_t     alt;            /* [mm] above mean sea level */
+    uint32_t    speed;          /* [mm/s] ground speed */
+    uint32_t    tick;           /* [RTOS tick] reception time */
+}STRUCT_GNSS_GPS_t;
+
+/* parser statistics */
+typedef struct
+{
+    uint32_t    nmea;           /* NMEA sentences decoded */
+    uint32_t    ubx;            /* UBX messages decoded */
+    uint32_t    ignored;        /* valid framing, type not decoded */
+    uint32_t    errors;         /* checksum or format errors */
+    uint32_t    skipped;        /* [byte] outside of a frame */
+}STRUCT_GNSS_STATS_t;
+
+/* ------------------------------------------------------------- --
+   function propotypes
+-- ------------------------------------------------------------- */
+void API_GNSS_START(void);
+bool API_GNSS_GET_GPS(STRUCT_GNSS_GPS_t* gps);
+void API_GNSS_GET_STATS(STRUCT_GNSS_STATS_t* stats);
+void API_GNSS_CALLBACK_ISR(void);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* GNSS_INC_API_GNSS_H_ */
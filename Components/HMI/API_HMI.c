@@ -24,73 +24,545 @@
 #include "TinyFrame.h"
 #include "utils.h"
 #include "string.h"
+#include "payload_parser.h"
+#include "payload_builder.h"
+#include "tf_cksum.h"
 
+/* instance used by the tx and the rx paths */
 TinyFrame *TinyFrame_TX;
 
 #include "MS1_config.h"
+#include "API_trace.h"
+#include "API_health.h"
 
 /* ------------------------------------------------------------- --
    defines
 -- ------------------------------------------------------------- */
 #define HMI_DEFAULT_QUEUE_SIZE      32u 
-#define HMI_DEFAULT_BUFFER_SIZE     16u
+#define HMI_DEFAULT_BUFFER_SIZE     HMI_PAYLOAD_SIZE
 #define HMI_DEFAULT_UART_TIMEOUT    1u
 #define HMI_DEFAULT_HEADER          "[%x]"
 
+/* transmit path : telemetry arena -> UART4 tx DMA (DMA1 stream 4) */
+#define HMI_ARENA_SLOTS             HMI_DEFAULT_QUEUE_SIZE
+#define HMI_ARENA_FRAME_SIZE        (TF_FRAME_HEAD_LEN + HMI_PAYLOAD_SIZE + TF_FRAME_TAIL_LEN)
+#define HMI_TX_TIMEOUT              10u     /* [ms] end of the DMA transfer */
+#define HMI_TX_TRIES                2u      /* a frame not sent is dropped after */
 
+/* telemetry lanes */
+#define HMI_CRITICAL_SLOTS          8u      /* slots [0..7] kept for the critical lane */
+#define HMI_LATEST_NB               16u     /* periodic IDs */
+#define HMI_LINK_BUDGET             46u     /* [byte/ms] 50% of UART4 at 921600 baud */
+#define HMI_LINK_BURST              256     /* [byte] */
+
+/* notifications of the hmi task */
+#define HMI_NOTIFY_WORK             0u      /* slot committed */
+#define HMI_NOTIFY_TX               1u      /* end of the DMA transfer */
+
+/* receive path : UART4 rx -> DMA1 stream 2 channel 4 (circular) */
+#define HMI_RX_BUFFER_SIZE          256u
+#define HMI_RX_DMA                  DMA1_Stream2
+#define HMI_RX_DMA_CHANNEL          4u
+#define HMI_RX_DMA_IRQ              DMA1_Stream2_IRQn
+#define HMI_RX_IRQ_PRIORITY         6u
+#define HMI_RX_TICK_PERIOD          10u     /* [ms] TF_Tick period (parser timeout) */
+#define HMI_CMD_QUEUE_SIZE          4u
+
+/* bulk streams : raw bytes sent by DMA from the memory of the caller
+ * (memory mapped flash), by chunks of 5.6 ms at 921600 baud */
+#define HMI_STREAM_CHUNK            512u    /* [byte] */
+#define HMI_STREAM_HEAD_SIZE        8u      /* [byte] offset u32, length u32 */
+#define HMI_STREAM_TIMEOUT          10u     /* [ms] end of the DMA transfer of a chunk */
+#define HMI_STREAM_TRIES            3u      /* a chunk not sent ends the stream after */
+
+/* notification value of the caller of a stream */
+#define HMI_STREAM_SENT             1u
+#define HMI_STREAM_FAILED           2u
+
+/* slot of the telemetry arena, the producer writes the payload in 
+ * place and the frame is composed around it */
 typedef struct 
 {
     TYPE_HMI_ID_t ID;
-    uint8_t buffer[16];
-}STRUCT_HMI_FORM_t;
+    ENUM_HMI_LANE_t lane;
+    uint8_t len;
+    uint8_t frame[HMI_ARENA_FRAME_SIZE];
+}STRUCT_HMI_SLOT_t;
+
+/* latest value of a periodic ID, an older value is released */
+typedef struct
+{
+    TYPE_HMI_ID_t ID;
+    bool pending;
+    TYPE_HMI_SLOT_t slot;
+}STRUCT_HMI_LATEST_t;
+
+/* bulk stream, the caller waits until the last chunk is sent */
+typedef struct
+{
+    TYPE_HMI_ID_t ID;
+    const uint8_t* data;
+    uint32_t len;
+    uint32_t offset;            /* next chunk */
+    uint32_t tries;             /* of the next chunk */
+    TaskHandle_t task;          /* caller */
+    bool done;
+}STRUCT_HMI_STREAM_t;
 
 /* ------------------------------------------------------------- --
    handles
 -- ------------------------------------------------------------- */
 TaskHandle_t TaskHandle_hmi;
+TaskHandle_t TaskHandle_hmi_rx;
 QueueHandle_t QueueHandle_hmi;
+QueueHandle_t QueueHandle_hmi_critical;
+QueueHandle_t QueueHandle_hmi_free;
+QueueHandle_t QueueHandle_hmi_free_critical;
+QueueHandle_t QueueHandle_hmi_cmd;
+QueueHandle_t QueueHandle_hmi_stream;
 
 /* ------------------------------------------------------------- --
    variables
 -- ------------------------------------------------------------- */
+static STRUCT_HMI_SLOT_t hmi_arena[HMI_ARENA_SLOTS];
+
+static STRUCT_HMI_LATEST_t hmi_latest[HMI_LATEST_NB];
+static uint32_t hmi_latest_pending = 0;         /* number of pending values */
+static uint32_t hmi_latest_next = 0;            /* round robin */
+
+static STRUCT_HMI_LANE_STATS_t hmi_lanes[E_HMI_LANE_NB];
+
+static int32_t hmi_tokens = HMI_LINK_BURST;     /* [byte] link budget */
+static TickType_t hmi_tokens_tick = 0;
+static uint8_t hmi_rx_buffer[HMI_RX_BUFFER_SIZE];
+
+static STRUCT_HMI_STREAM_t hmi_stream = {.done = true};
+static uint8_t hmi_stream_head[TF_FRAME_HEAD_LEN + HMI_STREAM_HEAD_SIZE + TF_FRAME_TAIL_LEN];
 
 /* ------------------------------------------------------------- --
    prototypes
 -- ------------------------------------------------------------- */
 static void handler_hmi(void* parameters);
+static void handler_hmi_rx(void* parameters);
+
+static void init_rx(void);
+static ENUM_HMI_LANE_t get_lane(TYPE_HMI_ID_t ID);
+static void release_slot(TYPE_HMI_SLOT_t slot);
+static void commit_latest(TYPE_HMI_SLOT_t slot);
+static bool take_latest(TYPE_HMI_SLOT_t* slot);
+static void refill_tokens(void);
+static void send_slot(TYPE_HMI_SLOT_t slot);
+static bool send_dma(const uint8_t* data, uint32_t len, uint32_t timeout);
+static void send_stream(void);
+static TF_Result listener_cmd(TinyFrame *tf, TF_Msg *msg);
 
 /* ============================================================= ==
    tasks functions
 == ============================================================= */
 /** ************************************************************* *
- * @brief       This task manage the hmi system with one 
- *              parameters. 
- *              - The data buffer
- *              The task need to receive buffer from queue to 
- *              operate.
+ * @brief       This task manage the hmi system.
+ *              The committed slots are sent by lane priority :
+ *              - critical : phase, deploy and actuators, first
+ *              - event : FIFO (health)
+ *              - stream : bulk data (log dump), one chunk at a time
+ *              - periodic : latest value of each ID, only when the
+ *                link budget allows it
  * 
  * @param       parameters 
  * ************************************************************* **/
 static void handler_hmi(void* parameters)
 {
-	STRUCT_HMI_FORM_t form;
-    TF_Msg msg;
+    TYPE_HMI_SLOT_t slot;
+
+    hmi_tokens_tick = xTaskGetTickCount();
+
+    while(1)
+    {
+        refill_tokens();
+
+        if(xQueueReceive(QueueHandle_hmi_critical, &slot, (TickType_t)0) == pdTRUE
+        || xQueueReceive(QueueHandle_hmi, &slot, (TickType_t)0) == pdTRUE
+        || (hmi_tokens >= (int32_t)HMI_ARENA_FRAME_SIZE && take_latest(&slot) == true))
+        {
+            send_slot(slot);
+            continue;
+        }
+
+        /* a stream takes the whole link between the critical and
+         * event frames, the periodic lane waits for its end */
+        if(hmi_stream.done == false || xQueueReceive(QueueHandle_hmi_stream, &hmi_stream, (TickType_t)0) == pdTRUE)
+        {
+            send_stream();
+            continue;
+        }
+
+        /* wait for a new slot, or for the budget of a pending periodic value */
+        ulTaskNotifyTakeIndexed(HMI_NOTIFY_WORK, pdTRUE, (hmi_latest_pending > 0u) ? 1u : portMAX_DELAY);
+    }
+}
+
+/** ************************************************************* *
+ * @brief       This task feeds the received bytes to TinyFrame.
+ *              It is woken up by the idle line and the half/full 
+ *              transfer interrupts, the bytes are read by spans 
+ *              from the circular DMA buffer. The task also drives
+ *              the TinyFrame tick (parser timeout).
+ * 
+ * @param       parameters 
+ * ************************************************************* **/
+static void handler_hmi_rx(void* parameters)
+{
+    TickType_t tick = xTaskGetTickCount();
+    uint32_t tail = 0;
+    uint32_t head;
 
     while(1)
     {
-        /* wait until receiving something */
-        xQueueReceive(QueueHandle_hmi, &form, portMAX_DELAY);
+        /* wait for data or the next tick */
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(HMI_RX_TICK_PERIOD));
+
+        /* position of the DMA in the buffer */
+        head = (HMI_RX_BUFFER_SIZE - HMI_RX_DMA->NDTR) % HMI_RX_BUFFER_SIZE;
 
-        TF_ClearMsg(&msg);
-        
-        msg.type = form.ID;
-        msg.data = form.buffer;
-        msg.len = sizeof(form.buffer);
+        if(head > tail)
+        {
+            TF_Accept(TinyFrame_TX, &hmi_rx_buffer[tail], head - tail);
+        }
+        else if(head < tail)
+        {
+            /* the span wraps at the end of the buffer */
+            TF_Accept(TinyFrame_TX, &hmi_rx_buffer[tail], HMI_RX_BUFFER_SIZE - tail);
+            TF_Accept(TinyFrame_TX, hmi_rx_buffer, head);
+        }
+        tail = head;
 
-        TF_Send(TinyFrame_TX, &msg);
+        if(xTaskGetTickCount() - tick >= pdMS_TO_TICKS(HMI_RX_TICK_PERIOD))
+        {
+            tick += pdMS_TO_TICKS(HMI_RX_TICK_PERIOD);
+            TF_Tick(TinyFrame_TX);
+        }
     }
 }
 
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       lane of a telemetry ID
+ * 
+ * @param       ID 
+ * @return      ENUM_HMI_LANE_t 
+ * ************************************************************* **/
+static ENUM_HMI_LANE_t get_lane(TYPE_HMI_ID_t ID)
+{
+    if(ID == HMI_ID_HEALTH_FAULT) return E_HMI_LANE_CRITICAL;
+
+    switch(ID & 0xF0u)
+    {
+        case 0x10u :    /* application */
+        case 0x40u :    /* recovery */
+        case 0x50u :    /* payload */
+            return E_HMI_LANE_CRITICAL;
+
+        case 0x20u :    /* sensors */
+        case 0x30u :    /* battery monitoring */
+            return E_HMI_LANE_PERIODIC;
+
+        default :
+            return E_HMI_LANE_EVENT;
+    }
+}
+
+/** ************************************************************* *
+ * @brief       give back a slot to its pool
+ * 
+ * @param       slot 
+ * ************************************************************* **/
+static void release_slot(TYPE_HMI_SLOT_t slot)
+{
+    if(slot < HMI_CRITICAL_SLOTS)
+    {
+        xQueueSend(QueueHandle_hmi_free_critical, &slot, (TickType_t)0);
+    }
+    else
+    {
+        xQueueSend(QueueHandle_hmi_free, &slot, (TickType_t)0);
+    }
+}
+
+/** ************************************************************* *
+ * @brief       store a periodic value, the previous value of the 
+ *              same ID not sent yet is released (superseded)
+ * 
+ * @param       slot 
+ * ************************************************************* **/
+static void commit_latest(TYPE_HMI_SLOT_t slot)
+{
+    TYPE_HMI_ID_t ID = hmi_arena[slot].ID;
+    STRUCT_HMI_LATEST_t* latest = NULL;
+    TYPE_HMI_SLOT_t old = slot;
+    bool release = true;
+
+    taskENTER_CRITICAL();
+    for(uint32_t i = 0; i < HMI_LATEST_NB; i++)
+    {
+        if(hmi_latest[i].ID == ID || (latest == NULL && hmi_latest[i].ID == HMI_ID_NONE))
+        {
+            latest = &hmi_latest[i];
+            if(hmi_latest[i].ID == ID) break;
+        }
+    }
+
+    if(latest == NULL)
+    {
+        /* no entry left for this ID */
+        hmi_lanes[E_HMI_LANE_PERIODIC].dropped++;
+    }
+    else if(latest->pending == true)
+    {
+        old = latest->slot;
+        latest->slot = slot;
+        hmi_lanes[E_HMI_LANE_PERIODIC].superseded++;
+    }
+    else
+    {
+        latest->ID = ID;
+        latest->slot = slot;
+        latest->pending = true;
+        hmi_latest_pending++;
+        release = false;
+    }
+    taskEXIT_CRITICAL();
+
+    if(release == true) release_slot(old);
+}
+
+/** ************************************************************* *
+ * @brief       take the next pending periodic value (round robin)
+ * 
+ * @param       slot 
+ * @return      true    value taken
+ * @return      false   nothing pending
+ * ************************************************************* **/
+static bool take_latest(TYPE_HMI_SLOT_t* slot)
+{
+    bool taken = false;
+
+    taskENTER_CRITICAL();
+    for(uint32_t i = 0; i < HMI_LATEST_NB && hmi_latest_pending > 0u; i++)
+    {
+        STRUCT_HMI_LATEST_t* latest = &hmi_latest[(hmi_latest_next + i) % HMI_LATEST_NB];
+
+        if(latest->pending == true)
+        {
+            *slot = latest->slot;
+            latest->pending = false;
+            hmi_latest_pending--;
+            hmi_latest_next = (hmi_latest_next + i + 1u) % HMI_LATEST_NB;
+            taken = true;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return taken;
+}
+
+/** ************************************************************* *
+ * @brief       refill the link budget (token bucket)
+ * 
+ * ************************************************************* **/
+static void refill_tokens(void)
+{
+    TickType_t now = xTaskGetTickCount();
+    TickType_t elapsed = now - hmi_tokens_tick;
+
+    hmi_tokens_tick = now;
+    if(elapsed > (TickType_t)HMI_LINK_BURST) elapsed = (TickType_t)HMI_LINK_BURST;
+
+    hmi_tokens += (int32_t)(elapsed * HMI_LINK_BUDGET * portTICK_PERIOD_MS);
+    if(hmi_tokens > HMI_LINK_BURST) hmi_tokens = HMI_LINK_BURST;
+}
+
+/** ************************************************************* *
+ * @brief       compose the frame around the payload of a slot and
+ *              send it by DMA, HMI_TX_TRIES times at most. The slot
+ *              is released at the end of the transfer, a frame not
+ *              sent is counted as dropped.
+ * 
+ * @param       slot 
+ * ************************************************************* **/
+static void send_slot(TYPE_HMI_SLOT_t slot)
+{
+    STRUCT_HMI_SLOT_t* form = &hmi_arena[slot];
+    bool sent = false;
+    uint32_t len;
+    TF_Msg msg;
+
+    TF_ClearMsg(&msg);
+    msg.type = form->ID;
+    msg.len = form->len;
+
+    API_TRACE_ENTER(E_TRACE_HMI_SEND, form->ID);
+    len = TF_ComposeInPlace(TinyFrame_TX, form->frame, &msg);
+
+    for(uint32_t i = 0; i < HMI_TX_TRIES && len > 0u && sent == false; i++)
+    {
+        sent = send_dma(form->frame, len, HMI_TX_TIMEOUT);
+    }
+
+    /* every lane uses the budget, the periodic lane gets what is left */
+    if(sent == true) hmi_tokens -= (int32_t)len;
+
+    taskENTER_CRITICAL();
+    if(sent == true)    hmi_lanes[form->lane].sent++;
+    else                hmi_lanes[form->lane].dropped++;
+    taskEXIT_CRITICAL();
+    API_TRACE_EXIT(E_TRACE_HMI_SEND, form->ID);
+
+    release_slot(slot);
+}
+
+/** ************************************************************* *
+ * @brief       send a buffer by DMA and wait for the end of the 
+ *              transfer, the buffer is read by the DMA until then
+ * 
+ * @param       data 
+ * @param       len 
+ * @param       timeout [ms] 
+ * @return      true    sent
+ * @return      false   uart busy, or timeout (transfer aborted)
+ * ************************************************************* **/
+static bool send_dma(const uint8_t* data, uint32_t len, uint32_t timeout)
+{
+    if(HAL_UART_Transmit_DMA(&huart4, (uint8_t*)data, (uint16_t)len) != HAL_OK) return false;
+
+    if(ulTaskNotifyTakeIndexed(HMI_NOTIFY_TX, pdTRUE, pdMS_TO_TICKS(timeout)) == 0u)
+    {
+        HAL_UART_AbortTransmit(&huart4);
+        return false;
+    }
+    return true;
+}
+
+/** ************************************************************* *
+ * @brief       send the next chunk of the stream : a header frame
+ *              {offset, length} then the raw bytes, straight from
+ *              the memory of the caller. A chunk not sent is sent
+ *              again on the next call, the stream fails after 
+ *              HMI_STREAM_TRIES. The caller is notified at the end.
+ * 
+ * ************************************************************* **/
+static void send_stream(void)
+{
+    uint32_t len = hmi_stream.len - hmi_stream.offset;
+    PayloadBuilder pb = pb_start(&hmi_stream_head[TF_FRAME_HEAD_LEN], HMI_STREAM_HEAD_SIZE, NULL);
+    uint32_t head;
+    TF_Msg msg;
+
+    if(len > HMI_STREAM_CHUNK) len = HMI_STREAM_CHUNK;
+
+    pb_u32(&pb, hmi_stream.offset);
+    pb_u32(&pb, len);
+
+    TF_ClearMsg(&msg);
+    msg.type = hmi_stream.ID;
+    msg.len = (TF_LEN)pb_length(&pb);
+
+    API_TRACE_ENTER(E_TRACE_HMI_SEND, hmi_stream.ID);
+    head = TF_ComposeInPlace(TinyFrame_TX, hmi_stream_head, &msg);
+
+    if(head > 0u && send_dma(hmi_stream_head, head, HMI_TX_TIMEOUT) == true
+    && send_dma(&hmi_stream.data[hmi_stream.offset], len, HMI_STREAM_TIMEOUT) == true)
+    {
+        hmi_stream.offset += len;
+        hmi_stream.tries = 0;
+        hmi_tokens -= (int32_t)(head + len);
+    }
+    else
+    {
+        hmi_stream.tries++;
+    }
+    API_TRACE_EXIT(E_TRACE_HMI_SEND, hmi_stream.ID);
+
+    if(hmi_stream.offset >= hmi_stream.len)
+    {
+        hmi_stream.done = true;
+        xTaskNotifyIndexed(hmi_stream.task, HMI_NOTIFY_STREAM, HMI_STREAM_SENT, eSetValueWithOverwrite);
+    }
+    else if(hmi_stream.tries >= HMI_STREAM_TRIES)
+    {
+        hmi_stream.done = true;
+        xTaskNotifyIndexed(hmi_stream.task, HMI_NOTIFY_STREAM, HMI_STREAM_FAILED, eSetValueWithOverwrite);
+    }
+}
+
+/** ************************************************************* *
+ * @brief       start the reception of UART4 in the circular 
+ *              buffer (DMA1 stream 2) with the idle line interrupt.
+ *              The stream is reserved in MS1_scheduler.ioc, its 
+ *              handler calls API_HMI_CALLBACK_ISR only.
+ * 
+ * ************************************************************* **/
+static void init_rx(void)
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    (void)RCC->AHB1ENR;
+
+    HMI_RX_DMA->CR &= ~DMA_SxCR_EN;
+    while(HMI_RX_DMA->CR & DMA_SxCR_EN);
+    DMA1->LIFCR = DMA_LIFCR_CTCIF2 | DMA_LIFCR_CHTIF2 | DMA_LIFCR_CTEIF2 | DMA_LIFCR_CDMEIF2 | DMA_LIFCR_CFEIF2;
+
+    /* peripheral to memory, byte, circular */
+    HMI_RX_DMA->PAR  = (uint32_t)&UART4->RDR;
+    HMI_RX_DMA->M0AR = (uint32_t)hmi_rx_buffer;
+    HMI_RX_DMA->NDTR = HMI_RX_BUFFER_SIZE;
+    HMI_RX_DMA->FCR  = 0u;
+    HMI_RX_DMA->CR   = (HMI_RX_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_MINC | DMA_SxCR_CIRC
+                     | DMA_SxCR_HTIE | DMA_SxCR_TCIE;
+    HMI_RX_DMA->CR  |= DMA_SxCR_EN;
+
+    HAL_NVIC_SetPriority(HMI_RX_DMA_IRQ, HMI_RX_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(HMI_RX_DMA_IRQ);
+
+    /* the uart interrupt is enabled by CubeMX */
+    UART4->ICR  = USART_ICR_IDLECF | USART_ICR_ORECF;
+    UART4->CR3 |= USART_CR3_DMAR;
+    UART4->CR1 |= USART_CR1_IDLEIE;
+}
+
+/** ************************************************************* *
+ * @brief       TinyFrame listener of the uplink commands.
+ *              The commands are sent to the application with the
+ *              command queue. Runs in the rx task, must not send.
+ * 
+ * @param       tf 
+ * @param       msg 
+ * @return      TF_Result 
+ * ************************************************************* **/
+static TF_Result listener_cmd(TinyFrame *tf, TF_Msg *msg)
+{
+    PayloadParser pp = pp_start(msg->data, msg->len, NULL);
+    STRUCT_HMI_CMD_t cmd;
+
+    switch(msg->type)
+    {
+        case HMI_ID_CMD_ARM :       cmd.ID = E_HMI_CMD_ARM;      cmd.value = pp_u8(&pp);  break;
+        case HMI_ID_CMD_RECOV :     cmd.ID = E_HMI_CMD_RECOV;    cmd.value = pp_u8(&pp);  break;
+        case HMI_ID_CMD_PAYLOAD :   cmd.ID = E_HMI_CMD_PAYLOAD;  cmd.value = pp_u8(&pp);  break;
+        case HMI_ID_CMD_TLM_RATE :  cmd.ID = E_HMI_CMD_TLM_RATE; cmd.value = pp_u16(&pp); break;
+        case HMI_ID_CMD_LOG_DUMP :  cmd.ID = E_HMI_CMD_LOG_DUMP; cmd.value = 0;           break;
+        case HMI_ID_CMD_LOG_ERASE : cmd.ID = E_HMI_CMD_LOG_ERASE; cmd.value = 0;          break;
+        default : return TF_NEXT;
+    }
+
+    /* payload too short */
+    if(pp.ok == false) return TF_STAY;
+
+    xQueueSend(QueueHandle_hmi_cmd, &cmd, (TickType_t)0);
+    return TF_STAY;
+}
+
 /* ============================================================= ==
    public functions
 == ============================================================= */
@@ -102,42 +574,258 @@ void API_HMI_START(void)
 {
     BaseType_t status;
 
+    TF_CksumInit();
     TinyFrame_TX = TF_Init(TF_MASTER); // 1 = master, 0 = slave
 
-    /* create the queue */
-    QueueHandle_hmi = xQueueCreate(HMI_DEFAULT_QUEUE_SIZE, sizeof(STRUCT_HMI_FORM_t));
+    /* uplink commands */
+    TF_AddTypeListener(TinyFrame_TX, HMI_ID_CMD_ARM, listener_cmd);
+    TF_AddTypeListener(TinyFrame_TX, HMI_ID_CMD_RECOV, listener_cmd);
+    TF_AddTypeListener(TinyFrame_TX, HMI_ID_CMD_PAYLOAD, listener_cmd);
+    TF_AddTypeListener(TinyFrame_TX, HMI_ID_CMD_TLM_RATE, listener_cmd);
+    TF_AddTypeListener(TinyFrame_TX, HMI_ID_CMD_LOG_DUMP, listener_cmd);
+    TF_AddTypeListener(TinyFrame_TX, HMI_ID_CMD_LOG_ERASE, listener_cmd);
+
+    /* create the queues, all the slots of the arena are free. 
+     * The lane queues can hold every slot, they never overflow */
+    QueueHandle_hmi = xQueueCreate(HMI_ARENA_SLOTS, sizeof(TYPE_HMI_SLOT_t));
+    QueueHandle_hmi_critical = xQueueCreate(HMI_ARENA_SLOTS, sizeof(TYPE_HMI_SLOT_t));
+    QueueHandle_hmi_free = xQueueCreate(HMI_ARENA_SLOTS - HMI_CRITICAL_SLOTS, sizeof(TYPE_HMI_SLOT_t));
+    QueueHandle_hmi_free_critical = xQueueCreate(HMI_CRITICAL_SLOTS, sizeof(TYPE_HMI_SLOT_t));
+    for(TYPE_HMI_SLOT_t i = 0; i < HMI_ARENA_SLOTS; i++)
+    {
+        release_slot(i);
+    }
+    QueueHandle_hmi_cmd = xQueueCreate(HMI_CMD_QUEUE_SIZE, sizeof(STRUCT_HMI_CMD_t));
+    QueueHandle_hmi_stream = xQueueCreate(1, sizeof(STRUCT_HMI_STREAM_t));
+    API_HEALTH_ADD_QUEUE(QueueHandle_hmi);
+    API_HEALTH_ADD_QUEUE(QueueHandle_hmi_critical);
+    API_HEALTH_ADD_QUEUE(QueueHandle_hmi_free);
+    API_HEALTH_ADD_QUEUE(QueueHandle_hmi_cmd);
+
+    /* create the tasks */
+    status = xTaskCreate(handler_hmi, "task_hmi", TASK_STACK_HMI, NULL, TASK_PRIORITY_HMI, &TaskHandle_hmi);
+    configASSERT(status == pdPASS);
 
-    /* create the task */
-    status = xTaskCreate(handler_hmi, "task_hmi", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY_HMI, &TaskHandle_hmi);
+    status = xTaskCreate(handler_hmi_rx, "task_hmi_rx", TASK_STACK_HMI_RX, NULL, TASK_PRIORITY_HMI_RX, &TaskHandle_hmi_rx);
     configASSERT(status == pdPASS);
+
+    /* start the reception */
+    init_rx();
+}
+
+/** ************************************************************* *
+ * @brief       get a command received from the ground station
+ * 
+ * @param       cmd 
+ * @return      true    new command received
+ * @return      false   nothing received
+ * ************************************************************* **/
+bool API_HMI_GET_CMD(STRUCT_HMI_CMD_t* cmd)
+{
+    return (xQueueReceive(QueueHandle_hmi_cmd, cmd, (TickType_t)0)) ? true : false;
 }
 
 /** ************************************************************* *
- * @brief       send data to the hmi uart with the ID as header.
- *              total buffer must be smaller than 32 bytes.
+ * @brief       This function must be called by the UART4 and the 
+ *              DMA1 stream 2 interrupts (before the HAL handler).
+ *              It wakes up the rx task on idle line and on half or
+ *              full transfer of the circular buffer.
+ * 
+ * ************************************************************* **/
+void API_HMI_CALLBACK_ISR(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    bool event = false;
+
+    if(UART4->ISR & USART_ISR_IDLE)
+    {
+        UART4->ICR = USART_ICR_IDLECF;
+        event = true;
+    }
+
+    if(UART4->ISR & USART_ISR_ORE)
+    {
+        UART4->ICR = USART_ICR_ORECF;
+    }
+
+    if(DMA1->LISR & (DMA_LISR_TCIF2 | DMA_LISR_HTIF2))
+    {
+        DMA1->LIFCR = DMA_LIFCR_CTCIF2 | DMA_LIFCR_CHTIF2;
+        event = true;
+    }
+
+    if(event == true)
+    {
+        vTaskNotifyGiveFromISR(TaskHandle_hmi_rx, &xHigherPriorityTaskWoken);
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    }
+}
+
+/** ************************************************************* *
+ * @brief       This function must be called by the UART4 transfer
+ *              complete callback (HAL_UART_TxCpltCallback).
+ *              It wakes up the hmi task at the end of a frame.
+ * 
+ * ************************************************************* **/
+void API_HMI_CALLBACK_TX_ISR(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    vTaskNotifyGiveIndexedFromISR(TaskHandle_hmi, HMI_NOTIFY_TX, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/** ************************************************************* *
+ * @brief       reserve a slot of the telemetry arena. The payload 
+ *              (HMI_PAYLOAD_SIZE bytes max) is written in place by 
+ *              the caller then sent with API_HMI_COMMIT.
+ *              The critical lane has its own slots, it falls back 
+ *              on the shared slots when they are all used.
  * 
  * @param       dataID 
- * @param       fmt
+ * @param       slot    reserved slot 
+ * @return      uint8_t* payload area, NULL if the arena is full 
+ * ************************************************************* **/
+uint8_t* API_HMI_RESERVE(TYPE_HMI_ID_t dataID, TYPE_HMI_SLOT_t* slot)
+{
+    ENUM_HMI_LANE_t lane = get_lane(dataID);
+
+    if((lane != E_HMI_LANE_CRITICAL || xQueueReceive(QueueHandle_hmi_free_critical, slot, (TickType_t)0) == pdFALSE)
+    && xQueueReceive(QueueHandle_hmi_free, slot, (TickType_t)0) == pdFALSE)
+    {
+        taskENTER_CRITICAL();
+        hmi_lanes[lane].dropped++;
+        taskEXIT_CRITICAL();
+        return NULL;
+    }
+
+    hmi_arena[*slot].ID   = dataID;
+    hmi_arena[*slot].lane = lane;
+    return &hmi_arena[*slot].frame[TF_FRAME_HEAD_LEN];
+}
+
+/** ************************************************************* *
+ * @brief       send a reserved slot to the hmi task
+ * 
+ * @param       slot 
+ * @param       len     payload length, truncated to HMI_PAYLOAD_SIZE 
+ * ************************************************************* **/
+void API_HMI_COMMIT(TYPE_HMI_SLOT_t slot, uint8_t len)
+{
+    hmi_arena[slot].len = (len < HMI_PAYLOAD_SIZE) ? len : HMI_PAYLOAD_SIZE;
+
+    /* send to task */
+    switch(hmi_arena[slot].lane)
+    {
+        case E_HMI_LANE_CRITICAL :  xQueueSend(QueueHandle_hmi_critical, &slot, 0);   break;
+        case E_HMI_LANE_PERIODIC :  commit_latest(slot);                             break;
+        default :                   xQueueSend(QueueHandle_hmi, &slot, 0);            break;
+    }
+    xTaskNotifyGiveIndexed(TaskHandle_hmi, HMI_NOTIFY_WORK);
+    API_TRACE_MARK(E_TRACE_HMI_QUEUE, hmi_arena[slot].ID);
+}
+
+/** ************************************************************* *
+ * @brief       get the statistics of a telemetry lane
+ * 
+ * @param       lane 
+ * @param       stats 
+ * ************************************************************* **/
+void API_HMI_GET_LANE_STATS(ENUM_HMI_LANE_t lane, STRUCT_HMI_LANE_STATS_t* stats)
+{
+    if(lane >= E_HMI_LANE_NB) return;
+
+    taskENTER_CRITICAL();
+    *stats = hmi_lanes[lane];
+    taskEXIT_CRITICAL();
+}
+
+/** ************************************************************* *
+ * @brief       send a bulk of data (log dump) at the full speed of
+ *              the link. The data are read in place by the DMA, the
+ *              caller is blocked until the last byte is sent.
+ *              Each chunk is preceded by a frame of the ID with the
+ *              offset and the length of the chunk (u32, u32).
+ * 
+ * @param       dataID 
+ * @param       data    must stay valid until the return 
+ * @param       len 
+ * @return      true    sent
+ * @return      false   another stream is running, or a chunk was 
+ *                      not sent after HMI_STREAM_TRIES 
+ * ************************************************************* **/
+bool API_HMI_STREAM(TYPE_HMI_ID_t dataID, const uint8_t* data, uint32_t len)
+{
+    STRUCT_HMI_STREAM_t stream = {.ID = dataID, .data = data, .len = len, .offset = 0, .tries = 0, .done = false};
+    uint32_t result = 0;
+
+    if(len == 0u) return true;
+
+    stream.task = xTaskGetCurrentTaskHandle();
+    if(xQueueSend(QueueHandle_hmi_stream, &stream, (TickType_t)0) != pdTRUE) return false;
+
+    xTaskNotifyGiveIndexed(TaskHandle_hmi, HMI_NOTIFY_WORK);
+    xTaskNotifyWaitIndexed(HMI_NOTIFY_STREAM, 0u, UINT32_MAX, &result, portMAX_DELAY);
+    return (result == HMI_STREAM_SENT);
+}
+
+/** ************************************************************* *
+ * @brief       send a text to the hmi uart with the ID as header.
+ *              The text is formatted in the slot, truncated to 
+ *              HMI_DEFAULT_BUFFER_SIZE - 1 characters, and sent 
+ *              without the terminating null.
+ * 
+ * @param       dataID 
+ * @param       fmt     printf format 
  * @param       ... 
  * ************************************************************* **/
 void API_HMI_SEND_DATA(TYPE_HMI_ID_t  dataID, const char *fmt, ...)
 {
+    TYPE_HMI_SLOT_t slot;
+    uint8_t* buffer;
     va_list args;
-    va_start(args, fmt);
+    int len;
 
-    STRUCT_HMI_FORM_t form;
-    form.ID = dataID;
-    memcpy(form.buffer, fmt, HMI_DEFAULT_BUFFER_SIZE);
+    buffer = API_HMI_RESERVE(dataID, &slot);
+    if(buffer == NULL) return;
 
+    va_start(args, fmt);
+    len = vsnprintf((char*)buffer, HMI_DEFAULT_BUFFER_SIZE, fmt, args);
     va_end(args);
 
-    /* send to task */
-    xQueueSend(QueueHandle_hmi, &form, 0);
+    if(len < 0) len = 0;
+    if(len > (int)HMI_DEFAULT_BUFFER_SIZE - 1) len = (int)HMI_DEFAULT_BUFFER_SIZE - 1;
+
+    API_HMI_COMMIT(slot, (uint8_t)len);
+}
+
+/** ************************************************************* *
+ * @brief       send a binary payload to the hmi uart with the ID 
+ *              as header. The payload is truncated to 16 bytes.
+ *              API_HMI_RESERVE avoids the copy of the payload.
+ * 
+ * @param       dataID 
+ * @param       data 
+ * @param       len 
+ * ************************************************************* **/
+void API_HMI_SEND_BINARY(TYPE_HMI_ID_t dataID, const uint8_t* data, uint8_t len)
+{
+    TYPE_HMI_SLOT_t slot;
+    uint8_t* buffer;
+
+    buffer = API_HMI_RESERVE(dataID, &slot);
+    if(buffer == NULL) return;
+
+    if(len > HMI_PAYLOAD_SIZE) len = HMI_PAYLOAD_SIZE;
+    memcpy(buffer, data, len);
+
+    API_HMI_COMMIT(slot, len);
 }
 
 /**
  * This function should be defined in the application code.
  * It implements the lowest layer - sending bytes to UART (or other)
+ * Only used by TF_Send, the telemetry is composed in place and sent by DMA.
  */
 void TF_WriteImpl(TinyFrame *tf, const uint8_t *buff, uint32_t len)
 {
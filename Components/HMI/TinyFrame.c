@@ -1057,6 +1057,42 @@ void _TF_FN TF_Multipart_Close(TinyFrame *tf)
 //endregion Sending API funcs - multipart
 
 
+//region Sending API funcs - in place
+
+uint32_t _TF_FN TF_ComposeInPlace(TinyFrame *tf, uint8_t *frame, TF_Msg *msg)
+{
+    TF_CKSUM cksum = 0;
+    TF_LEN i = 0;
+    uint32_t pos = 0;
+
+    (void)cksum; // suppress "unused" warning if checksums are disabled
+
+    if (!TF_ClaimTx(tf)) return 0;
+
+    pos = TF_ComposeHead(tf, frame, msg); // frame ID is incremented here if it's not a response
+
+    // the payload is only read to compute the checksum
+    pos += msg->len;
+    if (msg->len > 0) {
+        CKSUM_RESET(cksum);
+#if TF_CKSUM_BLOCK
+        (void)i;
+        cksum = TF_CksumBlock(cksum, frame + TF_FRAME_HEAD_LEN, msg->len);
+#else
+        for (i = 0; i < msg->len; i++) {
+            CKSUM_ADD(cksum, frame[TF_FRAME_HEAD_LEN + i]);
+        }
+#endif
+        pos += TF_ComposeTail(frame + pos, &cksum);
+    }
+
+    TF_ReleaseTx(tf);
+    return pos;
+}
+
+//endregion Sending API funcs - in place
+
+
 /** Timebase hook - for timeouts */
 void _TF_FN TF_Tick(TinyFrame *tf)
 {
@@ -16,6 +16,7 @@
    includes
 -- ------------------------------------------------------------- */
 #include "stdint.h"
+#include "stdbool.h"
 
 /* ------------------------------------------------------------- --
    types
@@ -23,9 +24,53 @@
 /* The id is use by the API to identify which type of data is sent */
 typedef uint8_t TYPE_HMI_ID_t;
 
+/* slot of the telemetry arena reserved by API_HMI_RESERVE */
+typedef uint8_t TYPE_HMI_SLOT_t;
+
+/* telemetry lanes, sorted by priority. The lane is given by the ID */
+typedef enum
+{
+    E_HMI_LANE_CRITICAL,        /* phase, deploy, actuators : never dropped */
+    E_HMI_LANE_EVENT,           /* FIFO (health) */
+    E_HMI_LANE_PERIODIC,        /* sensors : latest value per ID, rate limited */
+    E_HMI_LANE_NB
+}ENUM_HMI_LANE_t;
+
+/* statistics of a lane */
+typedef struct
+{
+    uint32_t sent;
+    uint32_t dropped;           /* no slot left, or not sent (uart timeout) */
+    uint32_t superseded;        /* replaced by a newer value before sending */
+}STRUCT_HMI_LANE_STATS_t;
+
+/* List of the commands received from the ground station */
+typedef enum
+{
+    E_HMI_CMD_NONE,
+    E_HMI_CMD_ARM,              /* value : 0 disarm, 1 arm */
+    E_HMI_CMD_RECOV,            /* value : ENUM_RECOV_CMD_t */
+    E_HMI_CMD_PAYLOAD,          /* value : ENUM_PAYLOAD_CMD_t */
+    E_HMI_CMD_TLM_RATE,         /* value : telemetry period [ms] */
+    E_HMI_CMD_LOG_DUMP,         /* value : unused */
+    E_HMI_CMD_LOG_ERASE         /* value : unused */
+}ENUM_HMI_CMD_t;
+
+/* command received from the ground station */
+typedef struct
+{
+    ENUM_HMI_CMD_t ID;
+    uint16_t value;
+}STRUCT_HMI_CMD_t;
+
 /* ------------------------------------------------------------- --
    defines
 -- ------------------------------------------------------------- */ 
+#define HMI_PAYLOAD_SIZE            16u     /* [byte] max payload of a frame */
+
+/* notification index of the task calling API_HMI_STREAM */
+#define HMI_NOTIFY_STREAM           1u
+
 /* default value */
 #define HMI_ID_NONE                 (TYPE_HMI_ID_t)0x00
 
@@ -49,6 +94,7 @@ typedef uint8_t TYPE_HMI_ID_t;
 #define HMI_ID_SENS_BARO_PRESS      (TYPE_HMI_ID_t)0x2A
 #define HMI_ID_SENS_BARO_TEMP       (TYPE_HMI_ID_t)0x2B
 #define HMI_ID_SENS_BARO_ERROR      (TYPE_HMI_ID_t)0x2C
+#define HMI_ID_SENS_GNSS            (TYPE_HMI_ID_t)0x2D
 
 /* monitoring IDs */
 #define HMI_ID_MNTR_BAT_SEQ         (TYPE_HMI_ID_t)0x30
@@ -63,11 +109,42 @@ typedef uint8_t TYPE_HMI_ID_t;
 #define HMI_ID_PAYLOAD_LAST_CMD     (TYPE_HMI_ID_t)0x50
 #define HMI_ID_PAYLOAD_STATUS       (TYPE_HMI_ID_t)0x51
 
+/* system health IDs (binary) */
+#define HMI_ID_HEALTH_TASK          (TYPE_HMI_ID_t)0x60
+#define HMI_ID_HEALTH_HEAP          (TYPE_HMI_ID_t)0x61
+#define HMI_ID_HEALTH_QUEUE         (TYPE_HMI_ID_t)0x62
+#define HMI_ID_HEALTH_PERIOD        (TYPE_HMI_ID_t)0x63
+#define HMI_ID_HEALTH_HIST          (TYPE_HMI_ID_t)0x64
+#define HMI_ID_HEALTH_FAULT         (TYPE_HMI_ID_t)0x65
+#define HMI_ID_HEALTH_LATENCY       (TYPE_HMI_ID_t)0x66
+#define HMI_ID_HEALTH_LAT_HIST      (TYPE_HMI_ID_t)0x67
+#define HMI_ID_HEALTH_CKSUM         (TYPE_HMI_ID_t)0x68
+#define HMI_ID_HEALTH_LANE          (TYPE_HMI_ID_t)0x69
+
+/* stream IDs : header {offset u32, length u32} then length raw bytes */
+#define HMI_ID_LOG_DUMP             (TYPE_HMI_ID_t)0x70
+
+/* uplink command IDs */
+#define HMI_ID_CMD_ARM              (TYPE_HMI_ID_t)0x80     /* u8 : 0 disarm, 1 arm */
+#define HMI_ID_CMD_RECOV            (TYPE_HMI_ID_t)0x81     /* u8 : ENUM_RECOV_CMD_t */
+#define HMI_ID_CMD_PAYLOAD          (TYPE_HMI_ID_t)0x82     /* u8 : ENUM_PAYLOAD_CMD_t */
+#define HMI_ID_CMD_TLM_RATE         (TYPE_HMI_ID_t)0x83     /* u16 : telemetry period [ms] */
+#define HMI_ID_CMD_LOG_DUMP         (TYPE_HMI_ID_t)0x84     /* no payload */
+#define HMI_ID_CMD_LOG_ERASE        (TYPE_HMI_ID_t)0x85     /* no payload */
+
 /* ------------------------------------------------------------- --
    function prototypes
 -- ------------------------------------------------------------- */
 void API_HMI_START(void);
 void API_HMI_SEND_DATA(TYPE_HMI_ID_t dataID, const char *fmt, ...);
+void API_HMI_SEND_BINARY(TYPE_HMI_ID_t dataID, const uint8_t* data, uint8_t len);
+uint8_t* API_HMI_RESERVE(TYPE_HMI_ID_t dataID, TYPE_HMI_SLOT_t* slot);
+void API_HMI_COMMIT(TYPE_HMI_SLOT_t slot, uint8_t len);
+void API_HMI_GET_LANE_STATS(ENUM_HMI_LANE_t lane, STRUCT_HMI_LANE_STATS_t* stats);
+bool API_HMI_STREAM(TYPE_HMI_ID_t dataID, const uint8_t* data, uint32_t len);
+void API_HMI_CALLBACK_TX_ISR(void);
+bool API_HMI_GET_CMD(STRUCT_HMI_CMD_t* cmd);
+void API_HMI_CALLBACK_ISR(void);
 
 /* ------------------------------------------------------------- --
    end of file
@@ -33,7 +33,14 @@
 //   TF_CKSUM_NONE, TF_CKSUM_XOR, TF_CKSUM_CRC8, TF_CKSUM_CRC16, TF_CKSUM_CRC32
 //   TF_CKSUM_CUSTOM8, TF_CKSUM_CUSTOM16, TF_CKSUM_CUSTOM32
 // Custom checksums require you to implement checksum functions (see TinyFrame.h)
-#define TF_CKSUM_TYPE TF_CKSUM_CRC16
+// CRC-16 (poly 0x8005, same as TF_CKSUM_CRC16) implemented in tf_cksum.c
+#define TF_CKSUM_TYPE TF_CKSUM_CUSTOM16
+// The custom checksum provides TF_CksumBlock() for contiguous payloads
+#define TF_CKSUM_BLOCK  1
+// TF_CksumBlock() uses the CRC peripheral (0 : slice-by-4 tables, e.g. host build)
+#ifndef TF_CKSUM_HW
+#define TF_CKSUM_HW     1
+#endif
 
 // Use a SOF byte to mark the start of a frame
 #define TF_USE_SOF_BYTE 1
@@ -79,6 +79,16 @@
     #error Bad value for TF_CKSUM_TYPE
 #endif
 
+#if TF_CKSUM_TYPE == TF_CKSUM_NONE
+    #define TF_CKSUM_BYTES 0
+#else
+    #define TF_CKSUM_BYTES sizeof(TF_CKSUM)
+#endif
+
+/** Size of the frame head (SOF, ID, LEN, TYPE, head checksum) and tail (body checksum) */
+#define TF_FRAME_HEAD_LEN (TF_USE_SOF_BYTE + TF_ID_BYTES + TF_LEN_BYTES + TF_TYPE_BYTES + TF_CKSUM_BYTES)
+#define TF_FRAME_TAIL_LEN (TF_CKSUM_BYTES)
+
 //endregion
 
 //---------------------------------------------------------------------------
@@ -398,6 +408,21 @@ void TF_Multipart_Payload(TinyFrame *tf, const uint8_t *buff, uint32_t length);
  */
 void TF_Multipart_Close(TinyFrame *tf);
 
+/**
+ * Compose a complete frame in place, without copy of the payload.
+ * The payload (msg->len bytes) must already be written at
+ * frame + TF_FRAME_HEAD_LEN, the buffer must hold
+ * TF_FRAME_HEAD_LEN + msg->len + TF_FRAME_TAIL_LEN bytes.
+ * The head and the tail are written around the payload, the frame is
+ * then sent by the caller (e.g. by DMA) instead of TF_WriteImpl().
+ *
+ * @param tf - instance
+ * @param frame - buffer holding the payload at TF_FRAME_HEAD_LEN
+ * @param msg - message struct, the data field is ignored
+ * @return nr of bytes of the frame, 0 on failure (tx locked)
+ */
+uint32_t TF_ComposeInPlace(TinyFrame *tf, uint8_t *frame, TF_Msg *msg);
+
 
 // ---------------------------------- INTERNAL ----------------------------------
 // This is publicly visible only to allow static init.
@@ -532,6 +557,18 @@ extern void TF_WriteImpl(TinyFrame *tf, const uint8_t *buff, uint32_t len);
      */
     extern TF_CKSUM TF_CksumEnd(TF_CKSUM cksum);
 
+    #if TF_CKSUM_BLOCK
+    /**
+     * Update a checksum with a contiguous block of bytes
+     *
+     * @param cksum - checksum value
+     * @param data - bytes to add
+     * @param len - number of bytes
+     * @return updated checksum
+     */
+    extern TF_CKSUM TF_CksumBlock(TF_CKSUM cksum, const uint8_t *data, uint32_t len);
+    #endif
+
 #endif
 
 #endif
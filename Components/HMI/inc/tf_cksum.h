@@ -0,0 +1,44 @@
+/** ************************************************************* *
+ * @file        tf_cksum.h
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef HMI_INC_TF_CKSUM_H_
+#define HMI_INC_TF_CKSUM_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+#include "TinyFrame.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* result of the checksum benchmark */
+typedef struct
+{
+    bool ok;                    /* block checksum matches the byte table */
+    uint32_t bytes;             /* [byte] total length of the frames */
+    uint32_t ref_cycles;        /* [cycle] byte table */
+    uint32_t block_cycles;      /* [cycle] TF_CksumBlock (hardware or slice-by-4) */
+}STRUCT_TF_CKSUM_BENCH_t;
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+void TF_CksumInit(void);
+bool TF_CksumBench(STRUCT_TF_CKSUM_BENCH_t *bench);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* HMI_INC_TF_CKSUM_H_ */
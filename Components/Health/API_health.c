@@ -0,0 +1,439 @@
+/** ************************************************************* *
+ * @file        API_health.c
+ * @brief       System health report : cpu load, stacks, heap, queues, timing
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "API_health.h"
+#include "API_HMI.h"
+#include "API_periodic.h"
+#include "API_latency.h"
+#include "API_datalogger.h"
+#include "task.h"
+#include "string.h"
+
+#include "payload_builder.h"
+#include "tf_cksum.h"
+
+#include "MS1_config.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define HEALTH_MAX_TASKS        16u     /* tasks of the application and idle task */
+#define HEALTH_MAX_QUEUES       12u
+#define HEALTH_MSG_SIZE         16u     /* hmi buffer size */
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* run time of a task at the previous report */
+typedef struct
+{
+    TaskHandle_t    handle;
+    uint32_t        runtime;
+}STRUCT_HEALTH_RUNTIME_t;
+
+/* ------------------------------------------------------------- --
+   handles
+-- ------------------------------------------------------------- */
+TaskHandle_t TaskHandle_health;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+static TaskStatus_t health_tasks[HEALTH_MAX_TASKS];
+static STRUCT_HEALTH_RUNTIME_t health_runtime[HEALTH_MAX_TASKS] = {0};
+static uint32_t health_total = 0;
+
+static QueueHandle_t health_queues[HEALTH_MAX_QUEUES] = {0};
+static uint8_t health_nb_queues = 0;
+
+/* name of the task whose stack overflowed, read by the debugger */
+static volatile const char* health_overflow = NULL;
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static void handler_health(void* parameters);
+
+static void report_tasks(void);
+static void report_heap(void);
+static void report_queues(void);
+static void report_periods(void);
+static void report_latency(void);
+static void report_cksum(void);
+static void report_lanes(void);
+static void callback_periodic_fault(ENUM_PERIODIC_ID_t ID, uint32_t misses);
+static uint32_t update_runtime(TaskHandle_t handle, uint32_t runtime);
+
+/* ============================================================= ==
+   tasks functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       This task sends periodically the system health 
+ *              report over the hmi (binary messages) :
+ *              - HMI_ID_HEALTH_TASK  : one message per task
+ *              - HMI_ID_HEALTH_HEAP  : heap usage
+ *              - HMI_ID_HEALTH_QUEUE : one message per queue
+ *              - HMI_ID_HEALTH_PERIOD/HIST : periodic tasks timing
+ *              - HMI_ID_HEALTH_LATENCY/LAT_HIST : deploy chain, 
+ *                only after a new measure
+ *              - HMI_ID_HEALTH_LANE : one message per hmi lane
+ *              - HMI_ID_HEALTH_CKSUM : once at start
+ * 
+ * @param       parameters 
+ * ************************************************************* **/
+static void handler_health(void* parameters)
+{
+    API_PERIODIC_INIT(E_PERIODIC_HEALTH, TASK_PERIOD_HEALTH);
+    report_cksum();
+
+    while(1)
+    {
+        report_tasks();
+        report_heap();
+        report_queues();
+        report_periods();
+        report_latency();
+        report_lanes();
+
+        /* wait until next task period */
+        API_PERIODIC_WAIT(E_PERIODIC_HEALTH);
+    }
+}
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       send the cpu load and the stack margin of each 
+ *              task since the previous report.
+ *              payload : number (u8), cpu [0.1%] (u16), 
+ *              stack high water mark [word] (u16), name
+ * 
+ * ************************************************************* **/
+static void report_tasks(void)
+{
+    uint32_t total;
+    uint32_t elapsed;
+    UBaseType_t nb;
+
+    nb = uxTaskGetSystemState(health_tasks, HEALTH_MAX_TASKS, &total);
+
+    /* the run time counter wraps, only the deltas are valid */
+    elapsed      = total - health_total;
+    health_total = total;
+
+    for(UBaseType_t i = 0; i < nb; i++)
+    {
+        /* the payload is built in place in the hmi arena */
+        TYPE_HMI_SLOT_t slot;
+        uint8_t* buffer = API_HMI_RESERVE(HMI_ID_HEALTH_TASK, &slot);
+        if(buffer == NULL) return;
+
+        PayloadBuilder pb = pb_start(buffer, HMI_PAYLOAD_SIZE, NULL);
+        uint32_t runtime = update_runtime(health_tasks[i].xHandle, health_tasks[i].ulRunTimeCounter);
+        uint16_t load = (elapsed != 0u) ? (uint16_t)(((uint64_t)runtime * 1000u) / elapsed) : 0u;
+        size_t name = strnlen(health_tasks[i].pcTaskName, configMAX_TASK_NAME_LEN);
+
+        pb_u8(&pb, (uint8_t)health_tasks[i].xTaskNumber);
+        pb_u16(&pb, load);
+        pb_u16(&pb, (uint16_t)health_tasks[i].usStackHighWaterMark);
+        pb_buf(&pb, (const uint8_t*)health_tasks[i].pcTaskName, (uint32_t)name);
+
+        API_HMI_COMMIT(slot, (uint8_t)pb_length(&pb));
+    }
+}
+
+/** ************************************************************* *
+ * @brief       send the heap usage.
+ *              payload : free [byte] (u32), minimum ever free 
+ *              [byte] (u32), total [byte] (u32)
+ * 
+ * ************************************************************* **/
+static void report_heap(void)
+{
+    TYPE_HMI_SLOT_t slot;
+    uint8_t* buffer = API_HMI_RESERVE(HMI_ID_HEALTH_HEAP, &slot);
+    if(buffer == NULL) return;
+
+    PayloadBuilder pb = pb_start(buffer, HMI_PAYLOAD_SIZE, NULL);
+
+    pb_u32(&pb, (uint32_t)xPortGetFreeHeapSize());
+    pb_u32(&pb, (uint32_t)xPortGetMinimumEverFreeHeapSize());
+    pb_u32(&pb, (uint32_t)configTOTAL_HEAP_SIZE);
+
+    API_HMI_COMMIT(slot, (uint8_t)pb_length(&pb));
+}
+
+/** ************************************************************* *
+ * @brief       send the fill level of the registered queues.
+ *              payload : index (u8), waiting (u8), length (u8)
+ * 
+ * ************************************************************* **/
+static void report_queues(void)
+{
+    for(uint8_t i = 0; i < health_nb_queues; i++)
+    {
+        uint8_t buffer[HEALTH_MSG_SIZE];
+        PayloadBuilder pb = pb_start(buffer, sizeof(buffer), NULL);
+        UBaseType_t waiting = uxQueueMessagesWaiting(health_queues[i]);
+        UBaseType_t spaces  = uxQueueSpacesAvailable(health_queues[i]);
+
+        pb_u8(&pb, i);
+        pb_u8(&pb, (uint8_t)waiting);
+        pb_u8(&pb, (uint8_t)(waiting + spaces));
+
+        API_HMI_SEND_BINARY(HMI_ID_HEALTH_QUEUE, buffer, (uint8_t)pb_length(&pb));
+    }
+}
+
+/** ************************************************************* *
+ * @brief       send the timing statistics of the periodic tasks.
+ *              HMI_ID_HEALTH_PERIOD payload : ID (u8), iterations 
+ *              (u32), deadline misses (u32), max jitter [us] (u16),
+ *              max execution time [us] (u16)
+ *              HMI_ID_HEALTH_HIST payload : ID << 1 | histogram 
+ *              (u8, 0 : jitter, 1 : execution time), buckets (u16)
+ * 
+ * ************************************************************* **/
+static void report_periods(void)
+{
+    STRUCT_PERIODIC_STATS_t stats;
+
+    for(uint8_t i = 0; i < E_PERIODIC_NB; i++)
+    {
+        uint8_t buffer[HEALTH_MSG_SIZE];
+        PayloadBuilder pb = pb_start(buffer, sizeof(buffer), NULL);
+
+        API_PERIODIC_GET_STATS((ENUM_PERIODIC_ID_t)i, &stats);
+
+        pb_u8(&pb, i);
+        pb_u32(&pb, stats.iterations);
+        pb_u32(&pb, stats.misses);
+        pb_u16(&pb, (stats.jitter_max < UINT16_MAX) ? (uint16_t)stats.jitter_max : UINT16_MAX);
+        pb_u16(&pb, (stats.exec_max < UINT16_MAX) ? (uint16_t)stats.exec_max : UINT16_MAX);
+        API_HMI_SEND_BINARY(HMI_ID_HEALTH_PERIOD, buffer, (uint8_t)pb_length(&pb));
+
+        for(uint8_t hist = 0; hist < 2; hist++)
+        {
+            const uint32_t* buckets = (hist == 0) ? stats.jitter_hist : stats.exec_hist;
+
+            pb_rewind((&pb));
+            pb_u8(&pb, (uint8_t)((i << 1) | hist));
+            for(uint8_t j = 0; j < PERIODIC_NB_BUCKETS; j++)
+            {
+                pb_u16(&pb, (buckets[j] < UINT16_MAX) ? (uint16_t)buckets[j] : UINT16_MAX);
+            }
+            API_HMI_SEND_BINARY(HMI_ID_HEALTH_HIST, buffer, (uint8_t)pb_length(&pb));
+        }
+    }
+}
+
+/** ************************************************************* *
+ * @brief       send the latency of the deploy chain checkpoints 
+ *              measured since the previous report, and log them in 
+ *              flash (E_LOG_REC_LATENCY).
+ *              HMI_ID_HEALTH_LATENCY payload : checkpoint (u8), 
+ *              count (u16), min [us] (u32), max [us] (u32)
+ *              HMI_ID_HEALTH_LAT_HIST payload : checkpoint (u8), 
+ *              buckets (u8)
+ * 
+ * ************************************************************* **/
+static void report_latency(void)
+{
+    STRUCT_LATENCY_STATS_t stats;
+
+    for(uint8_t i = 0; i < E_LATENCY_NB; i++)
+    {
+        uint8_t buffer[HEALTH_MSG_SIZE];
+        PayloadBuilder pb = pb_start(buffer, sizeof(buffer), NULL);
+
+        if(API_LATENCY_GET_STATS((ENUM_LATENCY_POINT_t)i, &stats) == false) continue;
+
+        pb_u8(&pb, i);
+        pb_u16(&pb, (stats.count < UINT16_MAX) ? (uint16_t)stats.count : UINT16_MAX);
+        pb_u32(&pb, stats.min);
+        pb_u32(&pb, stats.max);
+        API_HMI_SEND_BINARY(HMI_ID_HEALTH_LATENCY, buffer, (uint8_t)pb_length(&pb));
+
+        pb_rewind((&pb));
+        pb_u8(&pb, i);
+        for(uint8_t j = 0; j < LATENCY_NB_BUCKETS; j++)
+        {
+            pb_u8(&pb, (stats.hist[j] < UINT8_MAX) ? (uint8_t)stats.hist[j] : UINT8_MAX);
+        }
+        API_HMI_SEND_BINARY(HMI_ID_HEALTH_LAT_HIST, buffer, (uint8_t)pb_length(&pb));
+
+        STRUCT_LOG_LATENCY_t rec;
+
+        rec.point    = i;
+        rec.reserved = 0;
+        rec.count    = (stats.count < UINT16_MAX) ? (uint16_t)stats.count : UINT16_MAX;
+        rec.last     = stats.last;
+        rec.max      = stats.max;
+        API_DATALOGGER_WRITE(E_LOG_REC_LATENCY, &rec, sizeof(rec));
+    }
+}
+
+/** ************************************************************* *
+ * @brief       send the statistics of the hmi telemetry lanes.
+ *              payload : lane (u8), sent (u32), dropped (u32), 
+ *              superseded (u32)
+ * 
+ * ************************************************************* **/
+static void report_lanes(void)
+{
+    STRUCT_HMI_LANE_STATS_t stats;
+
+    for(uint8_t i = 0; i < E_HMI_LANE_NB; i++)
+    {
+        uint8_t buffer[HEALTH_MSG_SIZE];
+        PayloadBuilder pb = pb_start(buffer, sizeof(buffer), NULL);
+
+        API_HMI_GET_LANE_STATS((ENUM_HMI_LANE_t)i, &stats);
+
+        pb_u8(&pb, i);
+        pb_u32(&pb, stats.sent);
+        pb_u32(&pb, stats.dropped);
+        pb_u32(&pb, stats.superseded);
+        API_HMI_SEND_BINARY(HMI_ID_HEALTH_LANE, buffer, (uint8_t)pb_length(&pb));
+    }
+}
+
+/** ************************************************************* *
+ * @brief       check and benchmark the TinyFrame checksum.
+ *              payload : ok (u8), bytes (u32), byte table [cycle] 
+ *              (u32), block [cycle] (u32)
+ * 
+ * ************************************************************* **/
+static void report_cksum(void)
+{
+    uint8_t buffer[HEALTH_MSG_SIZE];
+    PayloadBuilder pb = pb_start(buffer, sizeof(buffer), NULL);
+    STRUCT_TF_CKSUM_BENCH_t bench;
+
+    TF_CksumBench(&bench);
+
+    pb_u8(&pb, (uint8_t)bench.ok);
+    pb_u32(&pb, bench.bytes);
+    pb_u32(&pb, bench.ref_cycles);
+    pb_u32(&pb, bench.block_cycles);
+    API_HMI_SEND_BINARY(HMI_ID_HEALTH_CKSUM, buffer, (uint8_t)pb_length(&pb));
+}
+
+/** ************************************************************* *
+ * @brief       called by a periodic task missing its deadlines.
+ *              payload : ID (u8), deadline misses (u32)
+ * 
+ * @param       ID 
+ * @param       misses 
+ * ************************************************************* **/
+static void callback_periodic_fault(ENUM_PERIODIC_ID_t ID, uint32_t misses)
+{
+    uint8_t buffer[HEALTH_MSG_SIZE];
+    PayloadBuilder pb = pb_start(buffer, sizeof(buffer), NULL);
+
+    pb_u8(&pb, (uint8_t)ID);
+    pb_u32(&pb, misses);
+
+    API_HMI_SEND_BINARY(HMI_ID_HEALTH_FAULT, buffer, (uint8_t)pb_length(&pb));
+}
+
+/** ************************************************************* *
+ * @brief       get the run time of a task since the previous 
+ *              report and save the new value
+ * 
+ * @param       handle 
+ * @param       runtime     run time counter of the task 
+ * @return      uint32_t    run time since the previous report 
+ * ************************************************************* **/
+static uint32_t update_runtime(TaskHandle_t handle, uint32_t runtime)
+{
+    STRUCT_HEALTH_RUNTIME_t* slot = NULL;
+    uint32_t delta;
+
+    for(uint8_t i = 0; i < HEALTH_MAX_TASKS; i++)
+    {
+        if(health_runtime[i].handle == handle)
+        {
+            slot = &health_runtime[i];
+            break;
+        }
+        if(slot == NULL && health_runtime[i].handle == NULL)
+        {
+            slot = &health_runtime[i];
+        }
+    }
+
+    if(slot == NULL) return 0u;
+
+    delta = (slot->handle == handle) ? runtime - slot->runtime : runtime;
+    slot->handle  = handle;
+    slot->runtime = runtime;
+
+    return delta;
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       init and start the health task
+ * 
+ * ************************************************************* **/
+void API_HEALTH_START(void)
+{
+    BaseType_t status;
+
+    /* report the deadline misses */
+    API_PERIODIC_SET_FAULT(callback_periodic_fault);
+
+    /* create the task */
+    status = xTaskCreate(handler_health, "task_health", TASK_STACK_HEALTH, NULL, TASK_PRIORITY_HEALTH, &TaskHandle_health);
+    configASSERT(status == pdPASS);
+}
+
+/** ************************************************************* *
+ * @brief       add a queue to the report, the index in the report
+ *              is the order of registration.
+ *              Must be called before the scheduler starts.
+ * 
+ * @param       queue 
+ * ************************************************************* **/
+void API_HEALTH_ADD_QUEUE(QueueHandle_t queue)
+{
+    if(queue == NULL || health_nb_queues >= HEALTH_MAX_QUEUES) return;
+
+    health_queues[health_nb_queues++] = queue;
+}
+
+/** ************************************************************* *
+ * @brief       FreeRTOS hook (configCHECK_FOR_STACK_OVERFLOW 2), 
+ *              called by the context switch when the task left has
+ *              overflowed its stack. The memory after the stack is 
+ *              already corrupted : the name is kept and the cpu 
+ *              halts as on a failed configASSERT.
+ * 
+ * @param       xTask 
+ * @param       pcTaskName 
+ * ************************************************************* **/
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char* pcTaskName)
+{
+    health_overflow = pcTaskName;
+    configASSERT(health_overflow == NULL);
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,32 @@
+/** ************************************************************* *
+ * @file        API_health.h
+ * @brief       System health report : cpu load, stacks, heap, queues, timing
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef HEALTH_INC_API_HEALTH_H_
+#define HEALTH_INC_API_HEALTH_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+void API_HEALTH_START(void);
+void API_HEALTH_ADD_QUEUE(QueueHandle_t queue);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* HEALTH_INC_API_HEALTH_H_ */
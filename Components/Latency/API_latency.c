@@ -0,0 +1,164 @@
+/** ************************************************************* *
+ * @file        API_latency.c
+ * @brief       Latency of the deploy chain, from the aerocontact to the motors
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "API_latency.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* The checkpoints are timestamped with the run time stats counter
+ * (DWT cycle counter, see FreeRTOSConfig.h) */
+#define LATENCY_GET_CYCLES()        portGET_RUN_TIME_COUNTER_VALUE()
+#define LATENCY_CYCLES_PER_US       (SystemCoreClock / 1000000u)
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+static STRUCT_LATENCY_STATS_t latency_stats[E_LATENCY_NB] = {0};
+static bool latency_updated[E_LATENCY_NB] = {0};
+
+/* chain in progress */
+static bool latency_open = false;
+static ENUM_LATENCY_POINT_t latency_last = E_LATENCY_AEROC_ISR;
+static uint32_t latency_stamp = 0;          /* [cycle] last checkpoint */
+static TickType_t latency_tick = 0;         /* [RTOS tick] last checkpoint */
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static uint8_t get_bucket(uint32_t latency);
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       get the histogram bucket of a latency
+ * 
+ * @param       latency     [us] 
+ * @return      uint8_t     bucket index 
+ * ************************************************************* **/
+static uint8_t get_bucket(uint32_t latency)
+{
+    uint8_t bucket = 0;
+
+    latency >>= 2;
+    while(latency != 0u && bucket < LATENCY_NB_BUCKETS - 1u)
+    {
+        latency >>= 2;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       open a new deploy chain, a chain in progress is
+ *              dropped. Called when the liftoff is accepted : the
+ *              bounces of the aerocontact and its edges on the
+ *              ground do not open a chain.
+ * 
+ * @param       stamp   [cycle] time of the aerocontact interrupt 
+ * ************************************************************* **/
+void API_LATENCY_START(uint32_t stamp)
+{
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+    latency_open  = true;
+    latency_last  = E_LATENCY_AEROC_ISR;
+    latency_stamp = stamp;
+    latency_tick  = xTaskGetTickCountFromISR();
+
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/** ************************************************************* *
+ * @brief       record a checkpoint of the deploy chain.
+ *              The checkpoints outside of a chain or not in the
+ *              order of ENUM_LATENCY_POINT_t are ignored (second
+ *              window timer, manual commands), a chain older than
+ *              LATENCY_TIMEOUT is dropped.
+ *              Can be called from an interrupt.
+ * 
+ * @param       point 
+ * ************************************************************* **/
+void API_LATENCY_MARK(ENUM_LATENCY_POINT_t point)
+{
+    uint32_t now = LATENCY_GET_CYCLES();
+    UBaseType_t mask;
+
+    if(point >= E_LATENCY_NB) return;
+
+    mask = taskENTER_CRITICAL_FROM_ISR();
+
+    /* stale chain */
+    if(latency_open == true && xTaskGetTickCountFromISR() - latency_tick > pdMS_TO_TICKS(LATENCY_TIMEOUT))
+    {
+        latency_open = false;
+    }
+
+    if(latency_open == true && point > latency_last)
+    {
+        STRUCT_LATENCY_STATS_t* stats = &latency_stats[point];
+        uint32_t latency = (now - latency_stamp) / LATENCY_CYCLES_PER_US;
+
+        if(stats->count == 0u || latency < stats->min) stats->min = latency;
+        if(latency > stats->max) stats->max = latency;
+        stats->last = latency;
+        stats->hist[get_bucket(latency)]++;
+        stats->count++;
+        latency_updated[point] = true;
+
+        latency_last  = point;
+        latency_stamp = now;
+        latency_tick  = xTaskGetTickCountFromISR();
+
+        /* the chain ends with the motors */
+        if(point == E_LATENCY_MOTOR_ENABLE) latency_open = false;
+    }
+
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/** ************************************************************* *
+ * @brief       get a copy of the statistics of a checkpoint
+ * 
+ * @param       point 
+ * @param       stats 
+ * @return      true    updated since the previous call 
+ * @return      false   no new measure 
+ * ************************************************************* **/
+bool API_LATENCY_GET_STATS(ENUM_LATENCY_POINT_t point, STRUCT_LATENCY_STATS_t* stats)
+{
+    bool updated;
+
+    if(point >= E_LATENCY_NB) return false;
+
+    taskENTER_CRITICAL();
+    *stats  = latency_stats[point];
+    updated = latency_updated[point];
+    latency_updated[point] = false;
+    taskEXIT_CRITICAL();
+
+    return updated;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
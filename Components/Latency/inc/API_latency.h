@@ -0,0 +1,73 @@
+/** ************************************************************* *
+ * @file        API_latency.h
+ * @brief       Latency of the deploy chain, from the aerocontact to the motors
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef LATENCY_INC_API_LATENCY_H_
+#define LATENCY_INC_API_LATENCY_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* Histogram buckets in powers of 4 [us] :
+ * [0, 4[ [4, 16[ [16, 64[ ... [4^10, 4^11[ [4^11, +inf[ */
+#define LATENCY_NB_BUCKETS          12u
+
+/* a chain without checkpoint for this time is dropped (stuck deploy,
+ * manual command). Below the wrap around of the cycle counter
+ * (89 s at 48 MHz). */
+#define LATENCY_TIMEOUT             60000u  /* [ms] */
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* List of the checkpoints of the deploy chain, in order.
+ * The chain is opened at the time of the aerocontact interrupt when
+ * the flight state machine accepts the liftoff (API_LATENCY_START)
+ * and closed by the motor enable, each checkpoint measures the time
+ * since the previous one. */
+typedef enum
+{
+    E_LATENCY_AEROC_ISR,            /* aerocontact interrupt */
+    E_LATENCY_APP_PICKUP,           /* aerocontact seen by the application */
+    E_LATENCY_TIMER_EXPIRY,         /* end of the apogee window */
+    E_LATENCY_DEPLOY,               /* deploy decision */
+    E_LATENCY_ACTUATOR_DEQUEUE,     /* recovery open command received */
+    E_LATENCY_MOTOR_ENABLE,         /* motors enabled */
+    E_LATENCY_NB
+}ENUM_LATENCY_POINT_t;
+
+/* statistics of a checkpoint */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;                           /* [us] since the previous checkpoint */
+    uint32_t max;                           /* [us] since the previous checkpoint */
+    uint32_t last;                          /* [us] since the previous checkpoint */
+    uint32_t hist[LATENCY_NB_BUCKETS];
+}STRUCT_LATENCY_STATS_t;
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+void API_LATENCY_START(uint32_t stamp);
+void API_LATENCY_MARK(ENUM_LATENCY_POINT_t point);
+bool API_LATENCY_GET_STATS(ENUM_LATENCY_POINT_t point, STRUCT_LATENCY_STATS_t* stats);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* LATENCY_INC_API_LATENCY_H_ */
@@ -0,0 +1,255 @@
+/** ************************************************************* *
+ * @file        API_motion.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "API_motion.h"
+#include "API_battery.h"
+#include "tim.h"
+
+#include "MS1_config.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* The profile is computed by the TIM7 update interrupt (1 kHz)
+ * and written in the CCR of the motors pwm (ARR = 4800). TIM7 and
+ * its interrupt are reserved in MS1_scheduler.ioc, the handler
+ * calls API_MOTION_CALLBACK_ISR without the HAL handler. */
+#define MOTION_TIMER                TIM7
+#define MOTION_TIMER_IRQ            TIM7_IRQn
+#define MOTION_TIMER_IRQ_PRIORITY   6u
+#define MOTION_TIMER_CLOCK          48000000u   /* [Hz] APB1 timer clock */
+#define MOTION_TIMER_FREQ           1000u       /* [Hz] 1 step = 1 ms */
+
+/* profile settings */
+#define MOTION_PROFILE_SCURVE       1           /* 0 : trapezoid, 1 : S-curve */
+#define MOTION_DUTY_START           480.0f      /* 10% PWM */
+#define MOTION_DUTY_CRUISE          3840.0f     /* 80% PWM */
+#define MOTION_DUTY_APPROACH        1440.0f     /* 30% PWM near the end stops */
+#define MOTION_RAMP_TIME            200u        /* [ms] */
+#define MOTION_TRAVEL_TIME          1500u       /* [ms] at cruise before the approach */
+
+/* current loop settings */
+#define MOTION_CURRENT_LOOP         1           /* 0 : open loop, 1 : current limited */
+#define MOTION_CURRENT_LIMIT        3.0f        /* [ampere] */
+#define MOTION_CURRENT_GAIN         20.0f       /* [CCR / ampere / step] */
+#define MOTION_CURRENT_RELEASE      10.0f       /* [CCR / step] */
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* hardware of a motor channel */
+typedef struct
+{
+    volatile uint32_t*  ccr;            /* pwm compare register */
+    ENUM_BATTERY_ID_t   battery;        /* battery powering the motor */
+}STRUCT_MOTION_CONFIG_t;
+
+/* state of a motor channel */
+typedef struct
+{
+    bool        running;
+    uint32_t    time;                   /* [ms] since the start */
+    float       derate;                 /* [CCR] removed by the current loop */
+}STRUCT_MOTION_t;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+static const STRUCT_MOTION_CONFIG_t motion_config[E_MOTION_NB] =
+{
+    [E_MOTION_M1] = {.ccr = &TIM2->CCR1, .battery = E_BATTERY_MOTOR1},
+    [E_MOTION_M2] = {.ccr = &TIM3->CCR3, .battery = E_BATTERY_MOTOR2}
+};
+
+static volatile STRUCT_MOTION_t motion[E_MOTION_NB] = {0};
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static float compute_shape(float x);
+static float compute_duty(uint32_t time);
+static void update_channel(ENUM_MOTION_CHANNEL_t channel);
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       shape of the ramps
+ * 
+ * @param       x       progress of the ramp [0..1] 
+ * @return      float   progress of the duty [0..1] 
+ * ************************************************************* **/
+static float compute_shape(float x)
+{
+#if MOTION_PROFILE_SCURVE
+    return x * x * (3.0f - 2.0f * x);
+#else
+    return x;
+#endif
+}
+
+/** ************************************************************* *
+ * @brief       compute the open loop duty of the profile :
+ *              ramp up -> cruise -> ramp down -> approach.
+ *              The approach duty is kept until the end stop.
+ * 
+ * @param       time    [ms] since the start 
+ * @return      float   [CCR] 
+ * ************************************************************* **/
+static float compute_duty(uint32_t time)
+{
+    float duty;
+
+    if(time < MOTION_RAMP_TIME)
+    {
+        duty = MOTION_DUTY_START + (MOTION_DUTY_CRUISE - MOTION_DUTY_START)
+             * compute_shape((float)time / MOTION_RAMP_TIME);
+    }
+    else if(time < MOTION_RAMP_TIME + MOTION_TRAVEL_TIME)
+    {
+        duty = MOTION_DUTY_CRUISE;
+    }
+    else if(time < 2u * MOTION_RAMP_TIME + MOTION_TRAVEL_TIME)
+    {
+        duty = MOTION_DUTY_CRUISE - (MOTION_DUTY_CRUISE - MOTION_DUTY_APPROACH)
+             * compute_shape((float)(time - MOTION_RAMP_TIME - MOTION_TRAVEL_TIME) / MOTION_RAMP_TIME);
+    }
+    else
+    {
+        duty = MOTION_DUTY_APPROACH;
+    }
+
+    return duty;
+}
+
+/** ************************************************************* *
+ * @brief       compute one step of the profile of a channel
+ * 
+ * @param       channel 
+ * ************************************************************* **/
+static void update_channel(ENUM_MOTION_CHANNEL_t channel)
+{
+    volatile STRUCT_MOTION_t* state = &motion[channel];
+    float duty;
+
+    if(state->running == false) return;
+
+    duty = compute_duty(state->time);
+    if(state->time < UINT32_MAX) state->time++;
+
+#if MOTION_CURRENT_LOOP
+    /* reduce the duty while the current is above the limit */
+    float current = API_BATTERY_READ_CURRENT(motion_config[channel].battery);
+
+    if(current > MOTION_CURRENT_LIMIT)
+    {
+        state->derate += MOTION_CURRENT_GAIN * (current - MOTION_CURRENT_LIMIT);
+    }
+    else
+    {
+        state->derate -= MOTION_CURRENT_RELEASE;
+    }
+
+    if(state->derate > duty - MOTION_DUTY_START) state->derate = duty - MOTION_DUTY_START;
+    if(state->derate < 0.0f)                     state->derate = 0.0f;
+
+    duty -= state->derate;
+#endif
+
+    *motion_config[channel].ccr = (uint32_t)duty;
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       init and start the motion profile timer
+ * 
+ * ************************************************************* **/
+void API_MOTION_START(void)
+{
+    for(uint8_t i = 0; i < E_MOTION_NB; i++)
+    {
+        motion[i].running = false;
+        *motion_config[i].ccr = 0u;
+    }
+
+    RCC->APB1ENR |= RCC_APB1ENR_TIM7EN;
+    (void)RCC->APB1ENR;
+
+    MOTION_TIMER->CR1  = TIM_CR1_URS;
+    MOTION_TIMER->PSC  = (MOTION_TIMER_CLOCK / 1000000u) - 1u;
+    MOTION_TIMER->ARR  = (1000000u / MOTION_TIMER_FREQ) - 1u;
+    MOTION_TIMER->EGR  = TIM_EGR_UG;
+    MOTION_TIMER->SR   = 0u;
+    MOTION_TIMER->DIER = TIM_DIER_UIE;
+
+    HAL_NVIC_SetPriority(MOTION_TIMER_IRQ, MOTION_TIMER_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(MOTION_TIMER_IRQ);
+
+    MOTION_TIMER->CR1 |= TIM_CR1_CEN;
+}
+
+/** ************************************************************* *
+ * @brief       start the profile of a motor from the start duty.
+ *              The pwm and the motor must be enabled by the caller.
+ * 
+ * @param       channel 
+ * ************************************************************* **/
+void API_MOTION_RUN(ENUM_MOTION_CHANNEL_t channel)
+{
+    if(channel >= E_MOTION_NB) return;
+
+    HAL_NVIC_DisableIRQ(MOTION_TIMER_IRQ);
+    motion[channel].time    = 0u;
+    motion[channel].derate  = 0.0f;
+    motion[channel].running = true;
+    *motion_config[channel].ccr = (uint32_t)MOTION_DUTY_START;
+    HAL_NVIC_EnableIRQ(MOTION_TIMER_IRQ);
+}
+
+/** ************************************************************* *
+ * @brief       stop the profile of a motor and clear its duty.
+ *              Can be called from an interrupt.
+ * 
+ * @param       channel 
+ * ************************************************************* **/
+void API_MOTION_STOP(ENUM_MOTION_CHANNEL_t channel)
+{
+    if(channel >= E_MOTION_NB) return;
+
+    motion[channel].running = false;
+    *motion_config[channel].ccr = 0u;
+}
+
+/** ************************************************************* *
+ * @brief       This function must be called by the TIM7 interrupt.
+ *              It computes one step of the profile of each motor.
+ * 
+ * ************************************************************* **/
+void API_MOTION_CALLBACK_ISR(void)
+{
+    if((MOTION_TIMER->SR & TIM_SR_UIF) == 0u) return;
+    MOTION_TIMER->SR = ~TIM_SR_UIF;
+
+    for(uint8_t i = 0; i < E_MOTION_NB; i++)
+    {
+        update_channel((ENUM_MOTION_CHANNEL_t)i);
+    }
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,43 @@
+/** ************************************************************* *
+ * @file        API_motion.h
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef MOTION_INC_API_MOTION_H_
+#define MOTION_INC_API_MOTION_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* List of the motor channels driven by the motion profile */
+typedef enum
+{
+    E_MOTION_M1,        /* TIM2 CH1 */
+    E_MOTION_M2,        /* TIM3 CH3 */
+    E_MOTION_NB
+}ENUM_MOTION_CHANNEL_t;
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+void API_MOTION_START(void);
+void API_MOTION_RUN(ENUM_MOTION_CHANNEL_t channel);
+void API_MOTION_STOP(ENUM_MOTION_CHANNEL_t channel);
+void API_MOTION_CALLBACK_ISR(void);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+#endif /* MOTION_INC_API_MOTION_H_ */
@@ -20,7 +20,7 @@
 /* ------------------------------------------------------------- --
    types
 -- ------------------------------------------------------------- */
-/* List of commands available for this API. 
+/* List of commands available for this API (same order as ENUM_ACTUATOR_CMD_t). 
  * -> Stop command      : will stop the motors 
  * -> Open/Close command: will run the motors until reach the end */
 typedef enum
@@ -31,7 +31,7 @@ typedef enum
     E_CMD_PL_CLOSE
 }ENUM_PAYLOAD_CMD_t;
 
-/* List of system status */
+/* List of system status (same order as ENUM_ACTUATOR_STATUS_t) */
 typedef enum
 {
     E_STATUS_PL_NONE,          /* default state */
@@ -54,7 +54,6 @@ typedef STRUCT_PAYLOAD_t STRUCT_PAYLOAD_MNTR_t;
 /* ------------------------------------------------------------- --
    function propotypes
 -- ------------------------------------------------------------- */
-void API_PAYLOAD_START(void);
 void API_PAYLOAD_SEND_CMD(ENUM_PAYLOAD_CMD_t command);
 bool API_PAYLOAD_GET_MNTR(STRUCT_PAYLOAD_MNTR_t* monitoring);
 
@@ -0,0 +1,252 @@
+/** ************************************************************* *
+ * @file        API_periodic.c
+ * @brief       Periodic tasks : fixed rate wait, jitter and deadline statistics
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "API_periodic.h"
+#include "task.h"
+#include "stdbool.h"
+
+#include "MS1_config.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* The times are measured with the run time stats counter 
+ * (DWT cycle counter, see FreeRTOSConfig.h) */
+#define PERIODIC_GET_CYCLES()       portGET_RUN_TIME_COUNTER_VALUE()
+#define PERIODIC_CYCLES_PER_US      (SystemCoreClock / 1000000u)
+#define PERIODIC_CYCLES_PER_TICK    (SystemCoreClock / configTICK_RATE_HZ)
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* state of a periodic task */
+typedef struct
+{
+    TickType_t  period;         /* [RTOS tick] */
+    TickType_t  wake;           /* last wake time */
+    uint32_t    start;          /* [cycle] start of the iteration */
+    uint32_t    period_start;   /* [cycle] start of the period */
+    uint32_t    consecutive;    /* deadline misses in a row */
+    bool        started;
+}STRUCT_PERIODIC_t;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+static STRUCT_PERIODIC_t periodic[E_PERIODIC_NB] = {0};
+static STRUCT_PERIODIC_STATS_t periodic_stats[E_PERIODIC_NB] = {0};
+
+static TYPE_PERIODIC_FAULT_t periodic_fault = NULL;
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static uint8_t get_bucket(uint32_t value, uint32_t period);
+static bool record_exec(STRUCT_PERIODIC_STATS_t* stats, uint32_t exec, uint32_t period);
+static void wait_period(ENUM_PERIODIC_ID_t ID, bool notify);
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       get the histogram bucket of a time, the buckets 
+ *              are powers of 2 of the period (see 
+ *              PERIODIC_NB_BUCKETS)
+ * 
+ * @param       value       [cycle] 
+ * @param       period      [cycle] 
+ * @return      uint8_t     bucket index 
+ * ************************************************************* **/
+static uint8_t get_bucket(uint32_t value, uint32_t period)
+{
+    uint64_t ratio = ((uint64_t)value * 32u) / period;  /* [1/32 period] */
+    uint8_t bucket = 0;
+
+    while(ratio != 0u && bucket < PERIODIC_NB_BUCKETS - 1u)
+    {
+        ratio >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+/** ************************************************************* *
+ * @brief       record the execution time of an iteration
+ * 
+ * @param       stats 
+ * @param       exec        [cycle] 
+ * @param       period      [cycle] 
+ * @return      true        deadline missed 
+ * @return      false       in time 
+ * ************************************************************* **/
+static bool record_exec(STRUCT_PERIODIC_STATS_t* stats, uint32_t exec, uint32_t period)
+{
+    taskENTER_CRITICAL();
+    stats->exec_hist[get_bucket(exec, period)]++;
+    if(exec / PERIODIC_CYCLES_PER_US > stats->exec_max) stats->exec_max = exec / PERIODIC_CYCLES_PER_US;
+    taskEXIT_CRITICAL();
+
+    return (exec > period) ? true : false;
+}
+
+/** ************************************************************* *
+ * @brief       end of an iteration, see API_PERIODIC_WAIT
+ * 
+ * @param       ID 
+ * @param       notify      a notification ends the wait early 
+ * ************************************************************* **/
+static void wait_period(ENUM_PERIODIC_ID_t ID, bool notify)
+{
+    STRUCT_PERIODIC_t* task;
+    STRUCT_PERIODIC_STATS_t* stats;
+    uint32_t period;
+    uint32_t now;
+    TickType_t remaining;
+    BaseType_t delayed;
+    bool miss;
+
+    if(ID >= E_PERIODIC_NB) return;
+
+    task   = &periodic[ID];
+    stats  = &periodic_stats[ID];
+    period = task->period * PERIODIC_CYCLES_PER_TICK;
+
+    /* execution time of the iteration */
+    miss = record_exec(stats, PERIODIC_GET_CYCLES() - task->start, period);
+
+    /* wait for a notification until the next wake time */
+    if(notify == true && miss == false)
+    {
+        remaining = task->wake + task->period - xTaskGetTickCount();
+
+        if(remaining != 0u && remaining <= task->period && ulTaskNotifyTake(pdTRUE, remaining) != 0u)
+        {
+            task->start = PERIODIC_GET_CYCLES();
+            return;
+        }
+    }
+
+    delayed = xTaskDelayUntil(&task->wake, task->period);
+    now = PERIODIC_GET_CYCLES();
+
+    /* the next wake time is already passed. Reached exactly is in 
+     * time : the wait for a notification timed out on it */
+    if(delayed == pdFALSE && xTaskGetTickCount() != task->wake) miss = true;
+
+    taskENTER_CRITICAL();
+    stats->iterations++;
+
+    /* start jitter : gap between the measured and the nominal period */
+    if(task->started == true)
+    {
+        uint32_t interval = now - task->period_start;
+        uint32_t jitter   = (interval > period) ? interval - period : period - interval;
+
+        stats->jitter_hist[get_bucket(jitter, period)]++;
+        if(jitter / PERIODIC_CYCLES_PER_US > stats->jitter_max) stats->jitter_max = jitter / PERIODIC_CYCLES_PER_US;
+    }
+
+    if(miss == true) stats->misses++;
+    taskEXIT_CRITICAL();
+
+    task->start        = now;
+    task->period_start = now;
+    task->started      = true;
+
+    /* raise the fault once per streak of misses */
+    task->consecutive = (miss == true) ? task->consecutive + 1u : 0u;
+    if(task->consecutive == PERIODIC_FAULT_MISSES && periodic_fault != NULL)
+    {
+        periodic_fault(ID, stats->misses);
+    }
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       init a periodic task, must be called by the task 
+ *              before its loop
+ * 
+ * @param       ID 
+ * @param       period  [RTOS tick] 
+ * ************************************************************* **/
+void API_PERIODIC_INIT(ENUM_PERIODIC_ID_t ID, TickType_t period)
+{
+    if(ID >= E_PERIODIC_NB) return;
+
+    periodic[ID].period       = period;
+    periodic[ID].wake         = xTaskGetTickCount();
+    periodic[ID].start        = PERIODIC_GET_CYCLES();
+    periodic[ID].period_start = periodic[ID].start;
+    periodic[ID].consecutive  = 0;
+    periodic[ID].started      = false;
+}
+
+/** ************************************************************* *
+ * @brief       end of an iteration : record the execution time, 
+ *              wait until the next period (vTaskDelayUntil) and 
+ *              record the start jitter of the next iteration.
+ *              A deadline is missed when the execution is longer
+ *              than the period.
+ * 
+ * @param       ID 
+ * ************************************************************* **/
+void API_PERIODIC_WAIT(ENUM_PERIODIC_ID_t ID)
+{
+    wait_period(ID, false);
+}
+
+/** ************************************************************* *
+ * @brief       same as API_PERIODIC_WAIT but a task notification 
+ *              (xTaskNotifyGive) ends the wait early. The next 
+ *              period is unchanged.
+ * 
+ * @param       ID 
+ * ************************************************************* **/
+void API_PERIODIC_WAIT_NOTIFY(ENUM_PERIODIC_ID_t ID)
+{
+    wait_period(ID, true);
+}
+
+/** ************************************************************* *
+ * @brief       get a copy of the statistics of a periodic task
+ * 
+ * @param       ID 
+ * @param       stats 
+ * ************************************************************* **/
+void API_PERIODIC_GET_STATS(ENUM_PERIODIC_ID_t ID, STRUCT_PERIODIC_STATS_t* stats)
+{
+    if(ID >= E_PERIODIC_NB) return;
+
+    taskENTER_CRITICAL();
+    *stats = periodic_stats[ID];
+    taskEXIT_CRITICAL();
+}
+
+/** ************************************************************* *
+ * @brief       set the function called on the fault event
+ * 
+ * @param       callback 
+ * ************************************************************* **/
+void API_PERIODIC_SET_FAULT(TYPE_PERIODIC_FAULT_t callback)
+{
+    periodic_fault = callback;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,70 @@
+/** ************************************************************* *
+ * @file        API_periodic.h
+ * @brief       Periodic tasks : fixed rate wait, jitter and deadline statistics
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef PERIODIC_INC_API_PERIODIC_H_
+#define PERIODIC_INC_API_PERIODIC_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "FreeRTOS.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* Histogram buckets, in fraction of the period :
+ * [0, 1/32[ [1/32, 1/16[ [1/16, 1/8[ [1/8, 1/4[ [1/4, 1/2[ [1/2, 1[ [1, +inf[ */
+#define PERIODIC_NB_BUCKETS         7u
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* List of the periodic tasks */
+typedef enum
+{
+    E_PERIODIC_SENSORS,
+    E_PERIODIC_APPLICATION,
+    E_PERIODIC_BATTERY,
+    E_PERIODIC_HEALTH,
+    E_PERIODIC_RADIO,
+    E_PERIODIC_NB
+}ENUM_PERIODIC_ID_t;
+
+/* statistics of a periodic task */
+typedef struct
+{
+    uint32_t iterations;
+    uint32_t misses;                            /* deadline misses */
+    uint32_t jitter_max;                        /* [us] start jitter */
+    uint32_t exec_max;                          /* [us] execution time */
+    uint32_t jitter_hist[PERIODIC_NB_BUCKETS];
+    uint32_t exec_hist[PERIODIC_NB_BUCKETS];
+}STRUCT_PERIODIC_STATS_t;
+
+/* fault event, raised when a task misses PERIODIC_FAULT_MISSES 
+ * deadlines in a row. Called from the late task. */
+typedef void (*TYPE_PERIODIC_FAULT_t)(ENUM_PERIODIC_ID_t ID, uint32_t misses);
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+void API_PERIODIC_INIT(ENUM_PERIODIC_ID_t ID, TickType_t period);
+void API_PERIODIC_WAIT(ENUM_PERIODIC_ID_t ID);
+void API_PERIODIC_WAIT_NOTIFY(ENUM_PERIODIC_ID_t ID);
+void API_PERIODIC_GET_STATS(ENUM_PERIODIC_ID_t ID, STRUCT_PERIODIC_STATS_t* stats);
+void API_PERIODIC_SET_FAULT(TYPE_PERIODIC_FAULT_t callback);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* PERIODIC_INC_API_PERIODIC_H_ */
@@ -0,0 +1,178 @@
+/** ************************************************************* *
+ * @file        API_radio.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "API_radio.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "usart.h"
+
+#include "API_health.h"
+#include "API_periodic.h"
+
+#include "MS1_config.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* The samples are taken on a fixed schedule and sent by frames of
+ * RADIO_FRAME_SAMPLES, with a keyframe every RADIO_KEYFRAME_PERIOD
+ * frames : a receiver which lost a frame resumes within 2 s */
+#define RADIO_SAMPLE_PERIOD         50u     /* [ms] 20 Hz */
+#define RADIO_FRAME_SAMPLES         10u     /* one frame every 500 ms */
+#define RADIO_KEYFRAME_PERIOD       4u      /* [frame] */
+#define RADIO_FRAME_SIZE            RADIO_CODEC_FRAME_MAX(RADIO_FRAME_SAMPLES)
+
+/* [byte] sample with fixed width fields (angles i16, altitude i32,
+ * phase u8, battery u16, actuators u8), reference of the stats */
+#define RADIO_RAW_SAMPLE_SIZE       12u
+
+/* USART2 (PD5/PD6) to the radio module */
+#define RADIO_UART_TIMEOUT          10u     /* [ms] */
+
+/* ------------------------------------------------------------- --
+   handles
+-- ------------------------------------------------------------- */
+TaskHandle_t TaskHandle_radio;
+QueueHandle_t QueueHandle_radio;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+static STRUCT_RADIO_CODEC_t radio_codec;
+static STRUCT_RADIO_SAMPLE_t radio_samples[RADIO_FRAME_SAMPLES];
+static uint8_t radio_frame[RADIO_FRAME_SIZE];
+static STRUCT_RADIO_STATS_t radio_stats = {0};
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static void handler_radio(void* parameters);
+static void send_frame(bool key);
+
+/* ============================================================= ==
+   tasks functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       This task samples the last telemetry given by the
+ *              application at a fixed rate and sends the frames.
+ *              The previous sample is repeated when the
+ *              application didn't give a new one (delta of 0, one
+ *              byte per field).
+ * 
+ * @param       parameters 
+ * ************************************************************* **/
+static void handler_radio(void* parameters)
+{
+    STRUCT_RADIO_SAMPLE_t sample = {0};
+    uint32_t nb = 0;
+    uint32_t frames = 0;
+
+    radio_codec_init(&radio_codec);
+    API_PERIODIC_INIT(E_PERIODIC_RADIO, pdMS_TO_TICKS(RADIO_SAMPLE_PERIOD));
+
+    while(1)
+    {
+        xQueueReceive(QueueHandle_radio, &sample, (TickType_t)0);
+        radio_samples[nb++] = sample;
+
+        if(nb == RADIO_FRAME_SAMPLES)
+        {
+            send_frame((frames % RADIO_KEYFRAME_PERIOD) == 0u);
+            frames++;
+            nb = 0;
+        }
+
+        /* wait until next sample */
+        API_PERIODIC_WAIT(E_PERIODIC_RADIO);
+    }
+}
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       encode and send the pending samples. USART2 has
+ *              no DMA channel in the configuration : the frame
+ *              (less than 2 ms at 921600 bauds) is sent by polling
+ *              from this low priority task.
+ * 
+ * @param       key     true : keyframe 
+ * ************************************************************* **/
+static void send_frame(bool key)
+{
+    uint32_t len = radio_codec_encode(&radio_codec, radio_samples, RADIO_FRAME_SAMPLES, key, radio_frame, sizeof(radio_frame));
+    HAL_StatusTypeDef status = HAL_UART_Transmit(&huart2, radio_frame, (uint16_t)len, RADIO_UART_TIMEOUT);
+
+    taskENTER_CRITICAL();
+    if(status == HAL_OK)
+    {
+        radio_stats.frames++;
+        radio_stats.keyframes += key ? 1u : 0u;
+        radio_stats.samples   += RADIO_FRAME_SAMPLES;
+        radio_stats.bytes     += len;
+        radio_stats.raw_bytes += RADIO_FRAME_SAMPLES * RADIO_RAW_SAMPLE_SIZE;
+    }
+    else
+    {
+        radio_stats.errors++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       
+ * 
+ * ************************************************************* **/
+void API_RADIO_START(void)
+{
+    BaseType_t status;
+
+    QueueHandle_radio = xQueueCreate(1, sizeof(STRUCT_RADIO_SAMPLE_t));
+    API_HEALTH_ADD_QUEUE(QueueHandle_radio);
+
+    status = xTaskCreate(handler_radio, "task_radio", TASK_STACK_RADIO, NULL, TASK_PRIORITY_RADIO, &TaskHandle_radio);
+    configASSERT(status == pdPASS);
+}
+
+/** ************************************************************* *
+ * @brief       give the last telemetry sample, a sample not yet
+ *              taken by the radio task is replaced
+ * 
+ * @param       sample 
+ * ************************************************************* **/
+void API_RADIO_SET_SAMPLE(const STRUCT_RADIO_SAMPLE_t* sample)
+{
+    xQueueOverwrite(QueueHandle_radio, sample);
+}
+
+/** ************************************************************* *
+ * @brief       read the statistics of the downlink, the ratio
+ *              raw_bytes / bytes is the gain of the encoding
+ * 
+ * @param       stats 
+ * ************************************************************* **/
+void API_RADIO_GET_STATS(STRUCT_RADIO_STATS_t* stats)
+{
+    taskENTER_CRITICAL();
+    *stats = radio_stats;
+    taskEXIT_CRITICAL();
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,47 @@
+/** ************************************************************* *
+ * @file        API_radio.h
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef RADIO_INC_API_RADIO_H_
+#define RADIO_INC_API_RADIO_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+#include "radio_codec.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* statistics of the downlink */
+typedef struct
+{
+    uint32_t frames;            /* frames sent */
+    uint32_t keyframes;         /* keyframes sent */
+    uint32_t samples;           /* samples sent */
+    uint32_t bytes;             /* [byte] sent */
+    uint32_t raw_bytes;         /* [byte] same samples with fixed width fields */
+    uint32_t errors;            /* uart errors */
+}STRUCT_RADIO_STATS_t;
+
+/* ------------------------------------------------------------- --
+   function propotypes
+-- ------------------------------------------------------------- */
+void API_RADIO_START(void);
+void API_RADIO_SET_SAMPLE(const STRUCT_RADIO_SAMPLE_t* sample);
+void API_RADIO_GET_STATS(STRUCT_RADIO_STATS_t* stats);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* RADIO_INC_API_RADIO_H_ */
@@ -0,0 +1,106 @@
+/** ************************************************************* *
+ * @file        radio_codec.h
+ * @brief       Encoder / decoder of the radio telemetry frames.
+ *              No dependency on the RTOS nor on the HAL, the same
+ *              files are built by the ground station decoder.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef RADIO_INC_RADIO_CODEC_H_
+#define RADIO_INC_RADIO_CODEC_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* Frame :
+ * [0]      sync RADIO_CODEC_SYNC
+ * [1]      flags : bit 7 keyframe, bits 3..0 number of samples
+ * [2]      sequence number
+ * [3..]    keyframe only : first sample, each field absolute as a
+ *          zigzag varint
+ *          bit stream, low bits first : width of each field 
+ *          (RADIO_CODEC_WIDTH_BITS) then, field by field, the 
+ *          zigzag of the delta of each sample to the previous one 
+ *          on width bits, the last sample of the previous frame 
+ *          for the first one of a delta frame. Padded to a byte.
+ * [n-2]    CRC-16/ARC (little endian) of [1..n-3] 
+ * A field which doesn't change in the frame (phase, actuators) 
+ * takes only its width, 0. */
+#define RADIO_CODEC_SYNC            0xA5u
+#define RADIO_CODEC_KEY             0x80u
+#define RADIO_CODEC_COUNT_MASK      0x0Fu
+#define RADIO_CODEC_HEAD_LEN        3u
+#define RADIO_CODEC_TAIL_LEN        2u
+#define RADIO_CODEC_MAX_SAMPLES     RADIO_CODEC_COUNT_MASK
+#define RADIO_CODEC_WIDTH_BITS      6u
+
+/* [byte] longest field (zigzag varint of 32 bits) */
+#define RADIO_CODEC_VARINT_MAX      5u
+
+/* [byte] longest frame for nb samples : absolute first sample and
+ * deltas of 32 bits */
+#define RADIO_CODEC_FRAME_MAX(nb)   (RADIO_CODEC_HEAD_LEN + E_RADIO_FIELD_NB * RADIO_CODEC_VARINT_MAX          \
+                                    + (E_RADIO_FIELD_NB * (RADIO_CODEC_WIDTH_BITS + (nb) * 32u) + 7u) / 8u    \
+                                    + RADIO_CODEC_TAIL_LEN)
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* fields of a sample, in the order of the frame */
+typedef enum
+{
+    E_RADIO_FIELD_ANGLE_X,      /* [0.01 deg] kalman angle */
+    E_RADIO_FIELD_ANGLE_Y,      /* [0.01 deg] kalman angle */
+    E_RADIO_FIELD_ALTITUDE,     /* [dm] above the ground */
+    E_RADIO_FIELD_PHASE,        /* ENUM_FLIGHT_PHASE_t */
+    E_RADIO_FIELD_BATTERY,      /* [mV] sequencer battery */
+    E_RADIO_FIELD_ACTUATORS,    /* recovery status | payload status << 4 */
+    E_RADIO_FIELD_NB
+}ENUM_RADIO_FIELD_t;
+
+/* telemetry sample */
+typedef struct
+{
+    int32_t field[E_RADIO_FIELD_NB];
+}STRUCT_RADIO_SAMPLE_t;
+
+/* state shared by the frames of a link (one per direction) */
+typedef struct
+{
+    STRUCT_RADIO_SAMPLE_t last;     /* reference of the next delta */
+    bool valid;                     /* decoder : reference known */
+    uint8_t seq;                    /* sequence number of the next frame */
+}STRUCT_RADIO_CODEC_t;
+
+/* result of the decoder */
+typedef enum
+{
+    E_RADIO_DECODE_OK,
+    E_RADIO_DECODE_FORMAT,      /* sync, length or varint error */
+    E_RADIO_DECODE_CKSUM,       /* CRC mismatch */
+    E_RADIO_DECODE_NO_KEY       /* delta frame without a reference (lost frame) */
+}ENUM_RADIO_DECODE_t;
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+void radio_codec_init(STRUCT_RADIO_CODEC_t *codec);
+uint32_t radio_codec_encode(STRUCT_RADIO_CODEC_t *codec, const STRUCT_RADIO_SAMPLE_t *samples, uint32_t nb, bool key, uint8_t *frame, uint32_t size);
+ENUM_RADIO_DECODE_t radio_codec_decode(STRUCT_RADIO_CODEC_t *codec, const uint8_t *frame, uint32_t len, STRUCT_RADIO_SAMPLE_t *samples, uint32_t *nb);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* RADIO_INC_RADIO_CODEC_H_ */
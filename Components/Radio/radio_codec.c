@@ -0,0 +1,353 @@
+/** ************************************************************* *
+ * @file        radio_codec.c
+ * @brief       Radio telemetry frames : bit packed deltas of the samples
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "radio_codec.h"
+#include "string.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* bit stream, low bits first */
+typedef struct
+{
+    uint8_t *data;
+    uint32_t size;              /* [byte] */
+    uint32_t pos;               /* [bit] */
+}STRUCT_RADIO_BITS_t;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+/* CRC-16/ARC (poly 0x8005 reflected, init 0), 4 bits at a time.
+ * Same checksum as the hmi frames, without the 2 kB tables */
+static const uint16_t crc16_nibble[16] = {
+    0x0000, 0xCC01, 0xD801, 0x1400, 0xF001, 0x3C00, 0x2800, 0xE401,
+    0xA001, 0x6C00, 0x7800, 0xB401, 0x5000, 0x9C01, 0x8801, 0x4400
+};
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static uint16_t crc16(const uint8_t *data, uint32_t len);
+static uint32_t put_varint(uint8_t *buffer, int32_t value);
+static uint32_t get_varint(const uint8_t *buffer, uint32_t len, int32_t *value);
+static bool put_bits(STRUCT_RADIO_BITS_t *bits, uint32_t value, uint32_t width);
+static bool get_bits(STRUCT_RADIO_BITS_t *bits, uint32_t *value, uint32_t width);
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       CRC-16/ARC of a block
+ * 
+ * @param       data 
+ * @param       len 
+ * @return      uint16_t 
+ * ************************************************************* **/
+static uint16_t crc16(const uint8_t *data, uint32_t len)
+{
+    uint16_t crc = 0u;
+
+    for(uint32_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ crc16_nibble[crc & 0x0Fu];
+        crc = (crc >> 4) ^ crc16_nibble[crc & 0x0Fu];
+    }
+
+    return crc;
+}
+
+/** ************************************************************* *
+ * @brief       write a signed value as a zigzag varint : 7 bits
+ *              per byte, low bits first, bit 7 set when another
+ *              byte follows.
+ * 
+ * @param       buffer  at least RADIO_CODEC_VARINT_MAX bytes 
+ * @param       value 
+ * @return      uint32_t number of bytes written 
+ * ************************************************************* **/
+static uint32_t put_varint(uint8_t *buffer, int32_t value)
+{
+    uint32_t zigzag = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    uint32_t len = 0;
+
+    while(zigzag >= 0x80u)
+    {
+        buffer[len++] = (uint8_t)(zigzag | 0x80u);
+        zigzag >>= 7;
+    }
+    buffer[len++] = (uint8_t)zigzag;
+
+    return len;
+}
+
+/** ************************************************************* *
+ * @brief       read a zigzag varint
+ * 
+ * @param       buffer 
+ * @param       len     bytes available 
+ * @param       value 
+ * @return      uint32_t number of bytes read, 0 if truncated or 
+ *              longer than RADIO_CODEC_VARINT_MAX
+ * ************************************************************* **/
+static uint32_t get_varint(const uint8_t *buffer, uint32_t len, int32_t *value)
+{
+    uint32_t zigzag = 0;
+
+    for(uint32_t i = 0; i < len && i < RADIO_CODEC_VARINT_MAX; i++)
+    {
+        zigzag |= (uint32_t)(buffer[i] & 0x7Fu) << (7u * i);
+        if((buffer[i] & 0x80u) == 0u)
+        {
+            *value = (int32_t)((zigzag >> 1) ^ (0u - (zigzag & 1u)));
+            return i + 1u;
+        }
+    }
+
+    return 0;
+}
+
+/** ************************************************************* *
+ * @brief       append bits to the stream, byte by byte. The stream
+ *              must be cleared first.
+ * 
+ * @param       bits 
+ * @param       value 
+ * @param       width   0 to 32 
+ * @return      true 
+ * @return      false   stream full 
+ * ************************************************************* **/
+static bool put_bits(STRUCT_RADIO_BITS_t *bits, uint32_t value, uint32_t width)
+{
+    if(bits->pos + width > bits->size * 8u) return false;
+
+    while(width > 0u)
+    {
+        uint32_t shift = bits->pos & 7u;
+        uint32_t nb = (8u - shift < width) ? 8u - shift : width;
+
+        bits->data[bits->pos >> 3] |= (uint8_t)((value & ((1u << nb) - 1u)) << shift);
+        value >>= nb;
+        bits->pos += nb;
+        width -= nb;
+    }
+    return true;
+}
+
+/** ************************************************************* *
+ * @brief       read bits from the stream
+ * 
+ * @param       bits 
+ * @param       value 
+ * @param       width   0 to 32 
+ * @return      true 
+ * @return      false   end of the stream 
+ * ************************************************************* **/
+static bool get_bits(STRUCT_RADIO_BITS_t *bits, uint32_t *value, uint32_t width)
+{
+    uint32_t done = 0;
+
+    if(bits->pos + width > bits->size * 8u) return false;
+
+    *value = 0;
+    while(done < width)
+    {
+        uint32_t shift = bits->pos & 7u;
+        uint32_t nb = (8u - shift < width - done) ? 8u - shift : width - done;
+
+        *value |= (uint32_t)((bits->data[bits->pos >> 3] >> shift) & ((1u << nb) - 1u)) << done;
+        bits->pos += nb;
+        done += nb;
+    }
+    return true;
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       reset the state of a link (encoder or decoder)
+ * 
+ * @param       codec 
+ * ************************************************************* **/
+void radio_codec_init(STRUCT_RADIO_CODEC_t *codec)
+{
+    memset(codec, 0, sizeof(STRUCT_RADIO_CODEC_t));
+}
+
+/** ************************************************************* *
+ * @brief       encode a frame of samples. A keyframe must be sent
+ *              first and then periodically, the decoder can't
+ *              resume after a lost frame without it.
+ * 
+ * @param       codec 
+ * @param       samples 
+ * @param       nb      1 to RADIO_CODEC_MAX_SAMPLES 
+ * @param       key     true : keyframe 
+ * @param       frame 
+ * @param       size    at least RADIO_CODEC_FRAME_MAX(nb) 
+ * @return      uint32_t length of the frame, 0 on error 
+ * ************************************************************* **/
+uint32_t radio_codec_encode(STRUCT_RADIO_CODEC_t *codec, const STRUCT_RADIO_SAMPLE_t *samples, uint32_t nb, bool key, uint8_t *frame, uint32_t size)
+{
+    uint32_t len = RADIO_CODEC_HEAD_LEN;
+    uint32_t first = key ? 1u : 0u;     /* first sample sent as a delta */
+    STRUCT_RADIO_BITS_t bits;
+    uint32_t width[E_RADIO_FIELD_NB];
+    bool ok = true;
+    uint16_t crc;
+
+    if(nb == 0u || nb > RADIO_CODEC_MAX_SAMPLES || size < RADIO_CODEC_FRAME_MAX(nb)) return 0;
+
+    frame[0] = RADIO_CODEC_SYNC;
+    frame[1] = (uint8_t)((key ? RADIO_CODEC_KEY : 0u) | nb);
+    frame[2] = codec->seq++;
+
+    /* keyframe : first sample absolute */
+    if(key == true)
+    {
+        for(uint32_t f = 0; f < E_RADIO_FIELD_NB; f++) len += put_varint(&frame[len], samples[0].field[f]);
+    }
+
+    bits.data = &frame[len];
+    bits.size = size - len - RADIO_CODEC_TAIL_LEN;
+    bits.pos  = 0;
+    memset(bits.data, 0, bits.size);
+
+    /* width of each field, the largest zigzag of its deltas */
+    for(uint32_t f = 0; f < E_RADIO_FIELD_NB; f++)
+    {
+        uint32_t max = 0;
+        int32_t ref = codec->last.field[f];
+
+        for(uint32_t s = first; s < nb; s++)
+        {
+            int32_t delta = (int32_t)((uint32_t)samples[s].field[f] - (uint32_t)((s == 0u) ? ref : samples[s - 1u].field[f]));
+
+            max |= ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+        }
+
+        width[f] = 0;
+        while(width[f] < 32u && (max >> width[f]) != 0u) width[f]++;
+        ok &= put_bits(&bits, width[f], RADIO_CODEC_WIDTH_BITS);
+    }
+
+    /* deltas field by field */
+    for(uint32_t f = 0; f < E_RADIO_FIELD_NB; f++)
+    {
+        for(uint32_t s = first; s < nb; s++)
+        {
+            int32_t delta = (int32_t)((uint32_t)samples[s].field[f] - (uint32_t)((s == 0u) ? codec->last.field[f] : samples[s - 1u].field[f]));
+
+            ok &= put_bits(&bits, ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31), width[f]);
+        }
+    }
+    if(ok == false) return 0;
+
+    codec->last = samples[nb - 1u];
+    len += (bits.pos + 7u) / 8u;
+
+    crc = crc16(&frame[1], len - 1u);
+    frame[len++] = (uint8_t)crc;
+    frame[len++] = (uint8_t)(crc >> 8);
+
+    return len;
+}
+
+/** ************************************************************* *
+ * @brief       decode a frame. A delta frame is refused when the
+ *              previous one was lost (sequence gap), until the
+ *              next keyframe.
+ * 
+ * @param       codec 
+ * @param       frame 
+ * @param       len 
+ * @param       samples at least RADIO_CODEC_MAX_SAMPLES 
+ * @param       nb      number of samples decoded 
+ * @return      ENUM_RADIO_DECODE_t 
+ * ************************************************************* **/
+ENUM_RADIO_DECODE_t radio_codec_decode(STRUCT_RADIO_CODEC_t *codec, const uint8_t *frame, uint32_t len, STRUCT_RADIO_SAMPLE_t *samples, uint32_t *nb)
+{
+    uint32_t pos = RADIO_CODEC_HEAD_LEN;
+    uint32_t end;
+    uint32_t count;
+    uint32_t first;
+    bool key;
+    STRUCT_RADIO_BITS_t bits;
+    uint32_t width[E_RADIO_FIELD_NB];
+
+    *nb = 0;
+    if(len < RADIO_CODEC_HEAD_LEN + RADIO_CODEC_TAIL_LEN || frame[0] != RADIO_CODEC_SYNC) return E_RADIO_DECODE_FORMAT;
+
+    end = len - RADIO_CODEC_TAIL_LEN;
+    if(crc16(&frame[1], end - 1u) != (uint16_t)(frame[end] | (frame[end + 1u] << 8))) return E_RADIO_DECODE_CKSUM;
+
+    key   = (frame[1] & RADIO_CODEC_KEY) != 0u;
+    count = frame[1] & RADIO_CODEC_COUNT_MASK;
+    first = key ? 1u : 0u;
+    if(count == 0u) return E_RADIO_DECODE_FORMAT;
+
+    if(key == false && (codec->valid == false || frame[2] != codec->seq))
+    {
+        codec->valid = false;
+        return E_RADIO_DECODE_NO_KEY;
+    }
+
+    /* keyframe : first sample absolute */
+    if(key == true)
+    {
+        for(uint32_t f = 0; f < E_RADIO_FIELD_NB; f++)
+        {
+            uint32_t read = get_varint(&frame[pos], end - pos, &samples[0].field[f]);
+            if(read == 0u) return E_RADIO_DECODE_FORMAT;
+            pos += read;
+        }
+    }
+
+    bits.data = (uint8_t*)&frame[pos];
+    bits.size = end - pos;
+    bits.pos  = 0;
+
+    for(uint32_t f = 0; f < E_RADIO_FIELD_NB; f++)
+    {
+        if(get_bits(&bits, &width[f], RADIO_CODEC_WIDTH_BITS) == false || width[f] > 32u) return E_RADIO_DECODE_FORMAT;
+    }
+
+    for(uint32_t f = 0; f < E_RADIO_FIELD_NB; f++)
+    {
+        for(uint32_t s = first; s < count; s++)
+        {
+            uint32_t zigzag;
+            int32_t ref = (s == 0u) ? codec->last.field[f] : samples[s - 1u].field[f];
+
+            if(get_bits(&bits, &zigzag, width[f]) == false) return E_RADIO_DECODE_FORMAT;
+
+            int32_t delta = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1u);
+            samples[s].field[f] = (int32_t)((uint32_t)ref + (uint32_t)delta);
+        }
+    }
+    if((bits.pos + 7u) / 8u != bits.size) return E_RADIO_DECODE_FORMAT;
+
+    codec->last  = samples[count - 1u];
+    codec->valid = true;
+    codec->seq   = (uint8_t)(frame[2] + 1u);
+    *nb = count;
+
+    return E_RADIO_DECODE_OK;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -21,7 +21,7 @@
 /* ------------------------------------------------------------- --
    types
 -- ------------------------------------------------------------- */
-/* List of commands available for this API. 
+/* List of commands available for this API (same order as ENUM_ACTUATOR_CMD_t). 
  * -> Stop command      : will stop the motors 
  * -> Open/Close command: will run the motors until reach the end */
 typedef enum
@@ -32,7 +32,7 @@ typedef enum
     E_CMD_RECOV_CLOSE
 }ENUM_RECOV_CMD_t;
 
-/* List of system status */
+/* List of system status (same order as ENUM_ACTUATOR_STATUS_t) */
 typedef enum
 {
     E_STATUS_RECOV_NONE,          /* default state */
@@ -55,7 +55,6 @@ typedef STRUCT_RECOV_t STRUCT_RECOV_MNTR_t;
 /* ------------------------------------------------------------- --
    function propotypes
 -- ------------------------------------------------------------- */
-void API_RECOVERY_START(void);
 void API_RECOVERY_SEND_CMD(ENUM_RECOV_CMD_t command);
 bool API_RECOVERY_GET_MNTR(STRUCT_RECOV_MNTR_t* monitoring);
 
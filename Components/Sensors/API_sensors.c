@@ -13,22 +13,54 @@
    include
 -- ------------------------------------------------------------- */
 #include "API_sensors.h"
-#include "freeRtos.h"
+#include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
 
 #include "math.h"
 
+#include "API_trace.h"
+#include "API_health.h"
+#include "API_periodic.h"
+
 #include "MS1_config.h"
 
 /* ------------------------------------------------------------- --
    defines
 -- ------------------------------------------------------------- */
 #define SENSORS_PERIOD_TASK     10u     /* [ms] */
+#define SENSORS_RATE            (1000u / SENSORS_PERIOD_TASK)   /* [Hz] */
+
+/* pre-filters, Butterworth low pass */
+#define SENSORS_IMU_CUTOFF      20u     /* [Hz] order 4 */
+#define SENSORS_BARO_CUTOFF     5u      /* [Hz] order 2 */
+
+/* source of a stream : the sensors, at SENSORS_PERIOD_TASK */
+#define SENSORS_SOURCE_RAW      E_SENSORS_STREAM_NB
+
+/* The sum of a window (value x ratio ^ order) must fit in 31 bits,
+ * the pressure is about 1e6 */
+#define SENSORS_GAIN_MAX        2000u
+
+/* fixed point of the channels */
+#define SENSORS_SCALE_ACCEL     1000.0f /* [mg / g] */
+#define SENSORS_SCALE_GYRO      10.0f   /* [0.1 deg/s / deg/s] */
+#define SENSORS_SCALE_ANGLE     100.0f  /* [0.01 deg / deg] */
+#define SENSORS_SCALE_PRESSURE  10.0f   /* [0.1 Pa / Pa] */
+#define SENSORS_SCALE_TEMP      100.0f  /* [0.01 degC / degC] */
 
 /* ------------------------------------------------------------- --
    types
 -- ------------------------------------------------------------- */
+/* decimation of a stream. A stream is decimated from the sensors or
+ * from a stream above it in the table : the anti-aliasing of the
+ * common band is done once. */
+typedef struct
+{
+    uint8_t     source;         /* ENUM_SENSORS_STREAM_t or SENSORS_SOURCE_RAW */
+    uint8_t     ratio;          /* output period / source period */
+    uint8_t     order;          /* CIC stages */
+}STRUCT_SENSORS_STREAM_CONFIG_t;
 
 /* ------------------------------------------------------------- --
    handles
@@ -36,6 +68,7 @@
 TaskHandle_t TaskHandle_sensors;
 QueueHandle_t QueueHandle_sensors_mpu6050;
 QueueHandle_t QueueHandle_sensors_bmp280;
+QueueHandle_t QueueHandle_sensors_stream[E_SENSORS_STREAM_NB];
 
 /* ------------------------------------------------------------- --
    variables
@@ -43,10 +76,46 @@ QueueHandle_t QueueHandle_sensors_bmp280;
 static STRUCT_SENSORS_MPU6050_t mpu6050 = {0};
 static STRUCT_SENSORS_BMP280_t  bmp280 = {0};
 
+/* pre-filters of the physical values, before the kalman filter (the
+ * raw values are left as read) : accelerations and rates, pressure 
+ * and temperature */
+static const STRUCT_SENSORS_BIQUAD_COEF_t sensors_imu_coef[] = {
+    SENSORS_BIQUAD_LOWPASS(SENSORS_IMU_CUTOFF, SENSORS_RATE, SENSORS_BIQUAD_Q_ORDER4_A),
+    SENSORS_BIQUAD_LOWPASS(SENSORS_IMU_CUTOFF, SENSORS_RATE, SENSORS_BIQUAD_Q_ORDER4_B),
+};
+static const STRUCT_SENSORS_BIQUAD_COEF_t sensors_baro_coef[] = {
+    SENSORS_BIQUAD_LOWPASS(SENSORS_BARO_CUTOFF, SENSORS_RATE, SENSORS_BIQUAD_Q_ORDER2),
+};
+
+static STRUCT_SENSORS_BIQUAD_t sensors_imu_bank;
+static STRUCT_SENSORS_BIQUAD_t sensors_baro_bank;
+
+/* streams, sensors at 100 Hz :
+ * radio    20 Hz   (RADIO_SAMPLE_PERIOD)
+ * hmi      10 Hz   from the radio stream, set by the ground station */
+static const STRUCT_SENSORS_STREAM_CONFIG_t sensors_config[E_SENSORS_STREAM_NB] = {
+    [E_SENSORS_STREAM_RADIO] = {.source = SENSORS_SOURCE_RAW,     .ratio = 5, .order = 3},
+    [E_SENSORS_STREAM_HMI]   = {.source = E_SENSORS_STREAM_RADIO, .ratio = 2, .order = 2},
+};
+
+static STRUCT_SENSORS_DECIM_t sensors_decim[E_SENSORS_STREAM_NB];
+static uint8_t sensors_ratio[E_SENSORS_STREAM_NB];
+static volatile uint8_t sensors_ratio_req[E_SENSORS_STREAM_NB];     /* 0 : no request */
+
+/* last valid values of the sensors, and the outputs of the streams */
+static STRUCT_SENSORS_STREAM_t sensors_input;
+static STRUCT_SENSORS_STREAM_t sensors_output[E_SENSORS_STREAM_NB];
+static bool sensors_ready[E_SENSORS_STREAM_NB];
+
 /* ------------------------------------------------------------- --
    prototypes
 -- ------------------------------------------------------------- */
 static void handler_sensors(void* parameters);
+static void read_mpu6050(void);
+static void read_bmp280(void);
+static void prefilter_imu(MPU6050_t* data);
+static void prefilter_baro(BMP280_t* data);
+static void decimate(void);
 
 /* ============================================================= ==
    tasks functions
@@ -58,33 +127,167 @@ static void handler_sensors(void* parameters);
  * ************************************************************* **/
 static void handler_sensors(void* parameters)
 {
-    TickType_t xLastWakeTime;
-    xLastWakeTime = xTaskGetTickCount();
+    API_PERIODIC_INIT(E_PERIODIC_SENSORS, pdMS_TO_TICKS(SENSORS_PERIOD_TASK));
 
     while(1)
     {
-        /* get and send mpu6050 data */
-        mpu6050.status = MPU6050_Read_All_Kalman();
-        if(mpu6050.status == 0)
+        /* get, filter and send the data of the sensors */
+        read_mpu6050();
+        read_bmp280();
+
+        /* slower streams */
+        sensors_input.time = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        decimate();
+        
+        /* wait until next task period */
+        API_PERIODIC_WAIT(E_PERIODIC_SENSORS);
+    }
+}
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       read the mpu6050, pre-filter the accelerations and
+ *              the rates, then run the kalman filter on them : the 
+ *              angles, the queue and the streams get the filtered
+ *              values. The raw values are left as read (flight log).
+ * 
+ * ************************************************************* **/
+static void read_mpu6050(void)
+{
+    API_TRACE_ENTER(E_TRACE_SENSORS_READ, E_TRACE_SENSOR_MPU6050);
+    mpu6050.status = MPU6050_Read_All();
+    API_TRACE_EXIT(E_TRACE_SENSORS_READ, mpu6050.status);
+    if(mpu6050.status == 0)
+    {
+        mpu6050.data = MPU6050_Get_Struct();
+        prefilter_imu(&mpu6050.data);
+        MPU6050_Kalman(&mpu6050.data);
+        xQueueSend(QueueHandle_sensors_mpu6050, &mpu6050, (TickType_t)0);
+        API_TRACE_MARK(E_TRACE_SENSORS_PUBLISH, E_TRACE_SENSOR_MPU6050);
+
+        sensors_input.value[E_SENSORS_CH_ACCEL_X] = (int32_t)(mpu6050.data.Ax * SENSORS_SCALE_ACCEL);
+        sensors_input.value[E_SENSORS_CH_ACCEL_Y] = (int32_t)(mpu6050.data.Ay * SENSORS_SCALE_ACCEL);
+        sensors_input.value[E_SENSORS_CH_ACCEL_Z] = (int32_t)(mpu6050.data.Az * SENSORS_SCALE_ACCEL);
+        sensors_input.value[E_SENSORS_CH_GYRO_X]  = (int32_t)(mpu6050.data.Gx * SENSORS_SCALE_GYRO);
+        sensors_input.value[E_SENSORS_CH_GYRO_Y]  = (int32_t)(mpu6050.data.Gy * SENSORS_SCALE_GYRO);
+        sensors_input.value[E_SENSORS_CH_GYRO_Z]  = (int32_t)(mpu6050.data.Gz * SENSORS_SCALE_GYRO);
+        sensors_input.value[E_SENSORS_CH_ANGLE_X] = (int32_t)(mpu6050.data.KalmanAngleX * SENSORS_SCALE_ANGLE);
+        sensors_input.value[E_SENSORS_CH_ANGLE_Y] = (int32_t)(mpu6050.data.KalmanAngleY * SENSORS_SCALE_ANGLE);
+        sensors_input.valid |= SENSORS_VALID_IMU;
+    }
+    else
+    {
+        sensors_input.valid &= (uint8_t)~SENSORS_VALID_IMU;
+    }
+}
+
+/** ************************************************************* *
+ * @brief       read the bmp280 and pre-filter the pressure and the
+ *              temperature before the queue and the streams
+ * 
+ * ************************************************************* **/
+static void read_bmp280(void)
+{
+    API_TRACE_ENTER(E_TRACE_SENSORS_READ, E_TRACE_SENSOR_BMP280);
+    bmp280.status = BMP280_Read_All();
+    API_TRACE_EXIT(E_TRACE_SENSORS_READ, bmp280.status);
+    if(bmp280.status == 0)
+    {
+        bmp280.data = BMP280_Get_Struct();
+        prefilter_baro(&bmp280.data);
+        xQueueSend(QueueHandle_sensors_bmp280, &bmp280, (TickType_t)0);
+        API_TRACE_MARK(E_TRACE_SENSORS_PUBLISH, E_TRACE_SENSOR_BMP280);
+
+        sensors_input.value[E_SENSORS_CH_PRESSURE]    = (int32_t)(bmp280.data.pressure * SENSORS_SCALE_PRESSURE);
+        sensors_input.value[E_SENSORS_CH_TEMPERATURE] = (int32_t)(bmp280.data.temperature * SENSORS_SCALE_TEMP);
+        sensors_input.valid |= SENSORS_VALID_BARO;
+    }
+    else
+    {
+        sensors_input.valid &= (uint8_t)~SENSORS_VALID_BARO;
+    }
+}
+
+/** ************************************************************* *
+ * @brief       low pass of the accelerations and of the rates 
+ * 
+ * @param       data 
+ * ************************************************************* **/
+static void prefilter_imu(MPU6050_t* data)
+{
+    float frame[6] = {data->Ax, data->Ay, data->Az, data->Gx, data->Gy, data->Gz};
+
+    sensors_biquad_process(&sensors_imu_bank, frame, frame, 1);
+
+    data->Ax = frame[0];
+    data->Ay = frame[1];
+    data->Az = frame[2];
+    data->Gx = frame[3];
+    data->Gy = frame[4];
+    data->Gz = frame[5];
+}
+
+/** ************************************************************* *
+ * @brief       low pass of the pressure and of the temperature. 
+ *              The filter of the BMP280 stays off. 
+ * 
+ * @param       data 
+ * ************************************************************* **/
+static void prefilter_baro(BMP280_t* data)
+{
+    float frame[2] = {data->pressure, data->temperature};
+
+    sensors_biquad_process(&sensors_baro_bank, frame, frame, 1);
+
+    data->pressure    = frame[0];
+    data->temperature = frame[1];
+}
+
+/** ************************************************************* *
+ * @brief       run the decimators in the order of the table and
+ *              publish the streams at the end of their window. 
+ *              A failed sensor holds its last value and is flagged
+ *              invalid in the streams.
+ * 
+ * ************************************************************* **/
+static void decimate(void)
+{
+    for(uint32_t i = 0; i < E_SENSORS_STREAM_NB; i++)
+    {
+        const STRUCT_SENSORS_STREAM_t* in;
+        uint8_t source = sensors_config[i].source;
+
+        /* new rate */
+        if(sensors_ratio_req[i] != 0u)
         {
-        	mpu6050.data = MPU6050_Get_Struct();
-        	xQueueSend(QueueHandle_sensors_mpu6050, &mpu6050, (TickType_t)0);
+            sensors_ratio[i] = sensors_ratio_req[i];
+            sensors_ratio_req[i] = 0;
+            sensors_decim_init(&sensors_decim[i], sensors_ratio[i], sensors_config[i].order);
         }
 
+        /* the source gave a sample in this period */
+        if(source == SENSORS_SOURCE_RAW) in = &sensors_input;
+        else if(sensors_ready[source] == true) in = &sensors_output[source];
+        else
+        {
+            sensors_ready[i] = false;
+            continue;
+        }
 
-        /* get and send bmp280 data */
-        bmp280.status = BMP280_Read_All();
-        if(bmp280.status == 0)
+        sensors_ready[i] = sensors_decim_push(&sensors_decim[i], in, &sensors_output[i]);
+        if(sensors_ready[i] == true)
         {
-        	bmp280.data = BMP280_Get_Struct();
-        	xQueueSend(QueueHandle_sensors_bmp280, &bmp280, (TickType_t)0);
+            xQueueOverwrite(QueueHandle_sensors_stream[i], &sensors_output[i]);
+            API_TRACE_MARK(E_TRACE_SENSORS_PUBLISH, E_TRACE_SENSOR_STREAM + i);
         }
-        
-        /* wait until next task period */
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(SENSORS_PERIOD_TASK));
     }
 }
 
+/* ============================================================= ==
+   public functions
+== ============================================================= */
 /** ************************************************************* *
  * @brief       
  * 
@@ -95,6 +298,23 @@ void API_SENSORS_START(void)
 
     QueueHandle_sensors_mpu6050 = xQueueCreate(1, sizeof(STRUCT_SENSORS_MPU6050_t));
     QueueHandle_sensors_bmp280  = xQueueCreate(1, sizeof(STRUCT_SENSORS_BMP280_t));
+    API_HEALTH_ADD_QUEUE(QueueHandle_sensors_mpu6050);
+    API_HEALTH_ADD_QUEUE(QueueHandle_sensors_bmp280);
+
+    /* pre-filters, primed by the first sample */
+    sensors_biquad_init(&sensors_imu_bank, sensors_imu_coef, sizeof(sensors_imu_coef) / sizeof(sensors_imu_coef[0]), 6);
+    sensors_biquad_init(&sensors_baro_bank, sensors_baro_coef, sizeof(sensors_baro_coef) / sizeof(sensors_baro_coef[0]), 2);
+
+    /* decimated streams */
+    for(uint32_t i = 0; i < E_SENSORS_STREAM_NB; i++)
+    {
+        QueueHandle_sensors_stream[i] = xQueueCreate(1, sizeof(STRUCT_SENSORS_STREAM_t));
+        API_HEALTH_ADD_QUEUE(QueueHandle_sensors_stream[i]);
+        configASSERT(sensors_config[i].source == SENSORS_SOURCE_RAW || sensors_config[i].source < i);
+
+        sensors_ratio[i] = sensors_config[i].ratio;
+        sensors_decim_init(&sensors_decim[i], sensors_ratio[i], sensors_config[i].order);
+    }
 
     /* init the mpu6050 */
     mpu6050.status = MPU6050_Init();
@@ -103,7 +323,7 @@ void API_SENSORS_START(void)
     bmp280.status = BMP280_Init();
 
     /* create the task */
-    status = xTaskCreate(handler_sensors, "task_sensors", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY_SENSORS, &TaskHandle_sensors);
+    status = xTaskCreate(handler_sensors, "task_sensors", TASK_STACK_SENSORS, NULL, TASK_PRIORITY_SENSORS, &TaskHandle_sensors);
     configASSERT(status == pdPASS);
 }
 
@@ -132,6 +352,59 @@ bool API_SENSORS_GET_BMP280(STRUCT_SENSORS_BMP280_t* data)
     return (xQueueReceive(QueueHandle_sensors_bmp280, data, (TickType_t)0)) ? true : false;
 }
 
+/** ************************************************************* *
+ * @brief       wait for the next sample of a decimated stream. The
+ *              consumer is blocked on the queue of its stream : it
+ *              is woken up at the rate of the stream only. 
+ * 
+ * @param       stream 
+ * @param       data 
+ * @return      true    new sample, see valid for the sensors 
+ * @return      false   unknown stream
+ * ************************************************************* **/
+bool API_SENSORS_WAIT_STREAM(ENUM_SENSORS_STREAM_t stream, STRUCT_SENSORS_STREAM_t* data)
+{
+    if(stream >= E_SENSORS_STREAM_NB) return false;
+
+    return (xQueueReceive(QueueHandle_sensors_stream[stream], data, portMAX_DELAY)) ? true : false;
+}
+
+/** ************************************************************* *
+ * @brief       change the period of a stream, rounded to a 
+ *              multiple of the period of its source. The filter
+ *              restarts : the next samples are invalid.
+ * 
+ * @param       stream 
+ * @param       period  [ms] 
+ * ************************************************************* **/
+void API_SENSORS_SET_PERIOD(ENUM_SENSORS_STREAM_t stream, uint32_t period)
+{
+    uint32_t source = SENSORS_PERIOD_TASK;
+    uint32_t ratio;
+    uint32_t gain;
+
+    if(stream >= E_SENSORS_STREAM_NB) return;
+
+    for(uint8_t i = sensors_config[stream].source; i != SENSORS_SOURCE_RAW; i = sensors_config[i].source)
+    {
+        source *= sensors_ratio[i];
+    }
+
+    ratio = (period + source / 2u) / source;
+    if(ratio == 0u) ratio = 1u;
+    if(ratio > UINT8_MAX) ratio = UINT8_MAX;
+
+    /* largest ratio of the gain */
+    while(ratio > 1u)
+    {
+        gain = 1u;
+        for(uint8_t k = 0; k < sensors_config[stream].order; k++) gain *= ratio;
+        if(gain <= SENSORS_GAIN_MAX) break;
+        ratio--;
+    }
+
+    sensors_ratio_req[stream] = (uint8_t)ratio;
+}
 
 /* ------------------------------------------------------------- --
    end of file
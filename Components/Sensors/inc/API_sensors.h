@@ -19,6 +19,15 @@
 #include "stdbool.h"
 #include "mpu6050.h"
 #include "bmp280.h"
+#include "sensors_decim.h"
+#include "sensors_biquad.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* valid mask of the streams */
+#define SENSORS_VALID_IMU           (1u << 0)
+#define SENSORS_VALID_BARO          (1u << 1)
 
 /* ------------------------------------------------------------- --
    types
@@ -35,6 +44,34 @@ typedef struct
    BMP280_t    data;
 }STRUCT_SENSORS_BMP280_t;
 
+/* channels of the decimated streams, fixed point */
+typedef enum
+{
+   E_SENSORS_CH_ACCEL_X,         /* [mg] */
+   E_SENSORS_CH_ACCEL_Y,
+   E_SENSORS_CH_ACCEL_Z,
+   E_SENSORS_CH_GYRO_X,          /* [0.1 deg/s] */
+   E_SENSORS_CH_GYRO_Y,
+   E_SENSORS_CH_GYRO_Z,
+   E_SENSORS_CH_ANGLE_X,         /* [0.01 deg] kalman */
+   E_SENSORS_CH_ANGLE_Y,
+   E_SENSORS_CH_PRESSURE,        /* [0.1 Pa] */
+   E_SENSORS_CH_TEMPERATURE,     /* [0.01 degC] */
+   E_SENSORS_CH_NB
+}ENUM_SENSORS_CHANNEL_t;
+
+/* decimated streams, one per consumer below the sensor rate.
+ * The application (and the flight log) read the sensors at full
+ * rate with API_SENSORS_GET_MPU6050 and API_SENSORS_GET_BMP280. */
+typedef enum
+{
+   E_SENSORS_STREAM_RADIO,       /* telemetry by radio */
+   E_SENSORS_STREAM_HMI,         /* telemetry by the HMI link */
+   E_SENSORS_STREAM_NB
+}ENUM_SENSORS_STREAM_t;
+
+typedef STRUCT_SENSORS_DECIM_SAMPLE_t STRUCT_SENSORS_STREAM_t;
+
 
 /* ------------------------------------------------------------- --
    function propotypes
@@ -42,6 +79,8 @@ typedef struct
 void API_SENSORS_START(void);
 bool API_SENSORS_GET_MPU6050(STRUCT_SENSORS_MPU6050_t* data);
 bool API_SENSORS_GET_BMP280(STRUCT_SENSORS_BMP280_t* data);
+bool API_SENSORS_WAIT_STREAM(ENUM_SENSORS_STREAM_t stream, STRUCT_SENSORS_STREAM_t* data);
+void API_SENSORS_SET_PERIOD(ENUM_SENSORS_STREAM_t stream, uint32_t period);
 
 /* ------------------------------------------------------------- --
    end of file
@@ -93,6 +93,7 @@ uint8_t MPU6050_Read_Gyro(void);
 uint8_t MPU6050_Read_Temp(void);
 uint8_t MPU6050_Read_All(void);
 uint8_t MPU6050_Read_All_Kalman(void);
+void MPU6050_Kalman(MPU6050_t* data);
 MPU6050_t MPU6050_Get_Struct(void);
 
 
@@ -0,0 +1,93 @@
+/** ************************************************************* *
+ * @file        sensors_biquad.h
+ * @brief       Bank of cascaded biquad filters, single precision,
+ *              direct form II transposed (as arm_biquad_cascade_
+ *              df2T_f32). The channels of a bank share the
+ *              coefficients. No dependency on the RTOS nor on the
+ *              HAL.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef SENSORS_INC_SENSORS_BIQUAD_H_
+#define SENSORS_INC_SENSORS_BIQUAD_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define SENSORS_BIQUAD_STAGES_MAX       2u
+#define SENSORS_BIQUAD_CHANNELS_MAX     6u
+
+/* quality factors of the Butterworth sections */
+#define SENSORS_BIQUAD_Q_ORDER2         0.70710678f
+#define SENSORS_BIQUAD_Q_ORDER4_A       0.54119610f
+#define SENSORS_BIQUAD_Q_ORDER4_B       1.30656296f
+
+/* Coefficients of a low pass section, bilinear transform prewarped
+ * at the cutoff. Constant expressions : the tables are computed by
+ * the compiler. tan() by its Pade approximant, error below 1e-7 up
+ * to fs / 4. */
+#define SENSORS_BIQUAD_TAN(x)           ((x) * (945.0f - 105.0f * (x) * (x) + (x) * (x) * (x) * (x)) \
+                                        / (945.0f - 420.0f * (x) * (x) + 15.0f * (x) * (x) * (x) * (x)))
+#define SENSORS_BIQUAD_K(fc, fs)        SENSORS_BIQUAD_TAN(3.14159265f * (float)(fc) / (float)(fs))
+#define SENSORS_BIQUAD_K2(fc, fs)       (SENSORS_BIQUAD_K(fc, fs) * SENSORS_BIQUAD_K(fc, fs))
+#define SENSORS_BIQUAD_NORM(fc, fs, q)  (1.0f + SENSORS_BIQUAD_K(fc, fs) / (q) + SENSORS_BIQUAD_K2(fc, fs))
+
+#define SENSORS_BIQUAD_LOWPASS(fc, fs, q)                                                                   \
+{                                                                                                           \
+    .b0 = SENSORS_BIQUAD_K2(fc, fs) / SENSORS_BIQUAD_NORM(fc, fs, q),                                       \
+    .b1 = 2.0f * SENSORS_BIQUAD_K2(fc, fs) / SENSORS_BIQUAD_NORM(fc, fs, q),                                \
+    .b2 = SENSORS_BIQUAD_K2(fc, fs) / SENSORS_BIQUAD_NORM(fc, fs, q),                                       \
+    .a1 = 2.0f * (SENSORS_BIQUAD_K2(fc, fs) - 1.0f) / SENSORS_BIQUAD_NORM(fc, fs, q),                       \
+    .a2 = (1.0f - SENSORS_BIQUAD_K(fc, fs) / (q) + SENSORS_BIQUAD_K2(fc, fs)) / SENSORS_BIQUAD_NORM(fc, fs, q) \
+}
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* section : y = b0 x + b1 x[-1] + b2 x[-2] - a1 y[-1] - a2 y[-2] */
+typedef struct
+{
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+}STRUCT_SENSORS_BIQUAD_COEF_t;
+
+/* state of a bank. Structure of arrays : the state of a stage is
+ * contiguous over the channels, the inner loop runs over the
+ * channels and its multiply-accumulates are independent (the FPU
+ * of the M7 issues them back to back). */
+typedef struct
+{
+    const STRUCT_SENSORS_BIQUAD_COEF_t *coef;
+    uint8_t stages;
+    uint8_t channels;
+    bool    primed;
+    float   z1[SENSORS_BIQUAD_STAGES_MAX][SENSORS_BIQUAD_CHANNELS_MAX];
+    float   z2[SENSORS_BIQUAD_STAGES_MAX][SENSORS_BIQUAD_CHANNELS_MAX];
+}STRUCT_SENSORS_BIQUAD_t;
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+void sensors_biquad_init(STRUCT_SENSORS_BIQUAD_t *bank, const STRUCT_SENSORS_BIQUAD_COEF_t *coef, uint8_t stages, uint8_t channels);
+void sensors_biquad_prime(STRUCT_SENSORS_BIQUAD_t *bank, const float *frame);
+void sensors_biquad_process(STRUCT_SENSORS_BIQUAD_t *bank, const float *in, float *out, uint32_t count);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* SENSORS_INC_SENSORS_BIQUAD_H_ */
@@ -0,0 +1,66 @@
+/** ************************************************************* *
+ * @file        sensors_decim.h
+ * @brief       CIC decimator of the sensor channels. The channels
+ *              are fixed point integers, the integrators wrap
+ *              around without loss. No dependency on the RTOS nor
+ *              on the HAL.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef SENSORS_INC_SENSORS_DECIM_H_
+#define SENSORS_INC_SENSORS_DECIM_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+#include "stdbool.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define SENSORS_DECIM_CHANNELS      10u
+#define SENSORS_DECIM_ORDER_MAX     3u
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* sample of the channels, input or output of a decimator */
+typedef struct
+{
+    uint32_t    time;                       /* [ms] last input of the window */
+    uint8_t     valid;                      /* bit mask of the valid sources */
+    int32_t     value[SENSORS_DECIM_CHANNELS];
+}STRUCT_SENSORS_DECIM_SAMPLE_t;
+
+/* state of a decimator : order integrators at the input rate,
+ * order combs at the output rate, gain ratio ^ order.
+ * The sum of a window must fit in 31 bits. */
+typedef struct
+{
+    uint8_t     ratio;
+    uint8_t     order;
+    uint8_t     phase;                      /* inputs in the window */
+    uint8_t     invalid;                    /* sources invalid in the window */
+    uint8_t     history[SENSORS_DECIM_ORDER_MAX];   /* invalid of the previous windows */
+    uint32_t    gain;
+    uint32_t    integ[SENSORS_DECIM_ORDER_MAX][SENSORS_DECIM_CHANNELS];
+    uint32_t    comb[SENSORS_DECIM_ORDER_MAX][SENSORS_DECIM_CHANNELS];
+}STRUCT_SENSORS_DECIM_t;
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+void sensors_decim_init(STRUCT_SENSORS_DECIM_t *decim, uint8_t ratio, uint8_t order);
+bool sensors_decim_push(STRUCT_SENSORS_DECIM_t *decim, const STRUCT_SENSORS_DECIM_SAMPLE_t *in, STRUCT_SENSORS_DECIM_SAMPLE_t *out);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* SENSORS_INC_SENSORS_DECIM_H_ */
@@ -16,6 +16,7 @@
 #include "mpu6050.h"
 #include <math.h>
 #include "i2c.h"
+#include "API_trace.h"
 
 
 /* ------------------------------------------------------------- --
@@ -315,14 +316,30 @@ uint8_t MPU6050_Read_All_Kalman(void)
 {
     if(MPU6050_Read_All()) return HAL_ERROR;
 
+    MPU6050_Kalman(&MPU6050);
+
+    return HAL_OK;
+}
+
+/** ************************************************************* *
+ * @brief       apply the kalman filter to the accelerations and 
+ *              rates of data (pre-filtered by the caller), the 
+ *              angles are written in data
+ * 
+ * @param       data 
+ * ************************************************************* **/
+void MPU6050_Kalman(MPU6050_t* data)
+{
+    API_TRACE_ENTER(E_TRACE_SENSORS_FILTER, 0);
+
     // Kalman angle solve
     float dt = (float) (HAL_GetTick() - timer) / 1000;
     timer = HAL_GetTick();
 
     float roll;
-    float roll_sqrt = sqrt(MPU6050.Accel_X_RAW * MPU6050.Accel_X_RAW + MPU6050.Accel_Z_RAW * MPU6050.Accel_Z_RAW);
+    float roll_sqrt = sqrt(data->Ax * data->Ax + data->Az * data->Az);
     if (roll_sqrt != 0.0) {
-        roll = atan(MPU6050.Accel_Y_RAW / roll_sqrt) * RAD_TO_DEG;
+        roll = atan(data->Ay / roll_sqrt) * RAD_TO_DEG;
     } 
 	else 
 	{
@@ -331,24 +348,25 @@ uint8_t MPU6050_Read_All_Kalman(void)
 
 
 
-    float pitch = atan2(-MPU6050.Accel_X_RAW, MPU6050.Accel_Z_RAW) * RAD_TO_DEG;
+    float pitch = atan2(-data->Ax, data->Az) * RAD_TO_DEG;
 
-    if((pitch < -90 && MPU6050.KalmanAngleY > 90) 
-	|| (pitch > 90 && MPU6050.KalmanAngleY < -90)) 
+    /* the previous angle is the one of the filter : data can be a copy */
+    if((pitch < -90 && KalmanY.angle > 90) 
+	|| (pitch > 90 && KalmanY.angle < -90)) 
 	{
         KalmanY.angle = pitch;
-        MPU6050.KalmanAngleY = pitch;
+        data->KalmanAngleY = pitch;
     } 
 	else 
 	{
-        MPU6050.KalmanAngleY = MPU6050_Kalman_getAngle(&KalmanY, pitch, MPU6050.Gy, dt);
+        data->KalmanAngleY = MPU6050_Kalman_getAngle(&KalmanY, pitch, data->Gy, dt);
     }
 
-    if (fabs(MPU6050.KalmanAngleY) > 90) MPU6050.Gx = -MPU6050.Gx;
+    if (fabs(data->KalmanAngleY) > 90) data->Gx = -data->Gx;
 
-    MPU6050.KalmanAngleX = MPU6050_Kalman_getAngle(&KalmanX, roll, MPU6050.Gy, dt);
+    data->KalmanAngleX = MPU6050_Kalman_getAngle(&KalmanX, roll, data->Gy, dt);
 
-    return HAL_OK;
+    API_TRACE_EXIT(E_TRACE_SENSORS_FILTER, 0);
 }
 
 /** ************************************************************* *
@@ -0,0 +1,113 @@
+/** ************************************************************* *
+ * @file        sensors_biquad.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "sensors_biquad.h"
+#include "string.h"
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       init a bank. The state is primed by the first frame
+ *              processed.
+ * 
+ * @param       bank 
+ * @param       coef        stages sections, in the order of the cascade 
+ * @param       stages      up to SENSORS_BIQUAD_STAGES_MAX 
+ * @param       channels    up to SENSORS_BIQUAD_CHANNELS_MAX 
+ * ************************************************************* **/
+void sensors_biquad_init(STRUCT_SENSORS_BIQUAD_t *bank, const STRUCT_SENSORS_BIQUAD_COEF_t *coef, uint8_t stages, uint8_t channels)
+{
+    memset(bank, 0, sizeof(STRUCT_SENSORS_BIQUAD_t));
+
+    if(stages > SENSORS_BIQUAD_STAGES_MAX) stages = SENSORS_BIQUAD_STAGES_MAX;
+    if(channels > SENSORS_BIQUAD_CHANNELS_MAX) channels = SENSORS_BIQUAD_CHANNELS_MAX;
+
+    bank->coef     = coef;
+    bank->stages   = stages;
+    bank->channels = channels;
+}
+
+/** ************************************************************* *
+ * @brief       set the state as if the frame had always been the
+ *              input : no transient from zero (the pressure is
+ *              about 1e5 Pa). The sections have a gain of 1 at DC.
+ * 
+ * @param       bank 
+ * @param       frame   one value per channel 
+ * ************************************************************* **/
+void sensors_biquad_prime(STRUCT_SENSORS_BIQUAD_t *bank, const float *frame)
+{
+    for(uint8_t s = 0; s < bank->stages; s++)
+    {
+        const STRUCT_SENSORS_BIQUAD_COEF_t *coef = &bank->coef[s];
+
+        for(uint8_t c = 0; c < bank->channels; c++)
+        {
+            bank->z2[s][c] = (coef->b2 - coef->a2) * frame[c];
+            bank->z1[s][c] = (coef->b1 - coef->a1) * frame[c] + bank->z2[s][c];
+        }
+    }
+    bank->primed = true;
+}
+
+/** ************************************************************* *
+ * @brief       filter a burst of frames. A frame is one value per
+ *              channel, the frames follow each other.
+ * 
+ * @param       bank 
+ * @param       in      count frames 
+ * @param       out     count frames, can be in 
+ * @param       count 
+ * ************************************************************* **/
+void sensors_biquad_process(STRUCT_SENSORS_BIQUAD_t *bank, const float *in, float *out, uint32_t count)
+{
+    const uint8_t channels = bank->channels;
+
+    if(count == 0u) return;
+    if(bank->primed == false) sensors_biquad_prime(bank, in);
+
+    for(uint32_t n = 0; n < count; n++)
+    {
+        const float *x = &in[n * channels];
+        float *y = &out[n * channels];
+
+        if(y != x) memcpy(y, x, channels * sizeof(float));
+
+        for(uint8_t s = 0; s < bank->stages; s++)
+        {
+            const float b0 = bank->coef[s].b0;
+            const float b1 = bank->coef[s].b1;
+            const float b2 = bank->coef[s].b2;
+            const float a1 = bank->coef[s].a1;
+            const float a2 = bank->coef[s].a2;
+            float *z1 = bank->z1[s];
+            float *z2 = bank->z2[s];
+
+            for(uint8_t c = 0; c < channels; c++)
+            {
+                float xin = y[c];
+                float yout = b0 * xin + z1[c];
+
+                z1[c] = b1 * xin - a1 * yout + z2[c];
+                z2[c] = b2 * xin - a2 * yout;
+                y[c]  = yout;
+            }
+        }
+    }
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
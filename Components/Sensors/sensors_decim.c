@@ -0,0 +1,114 @@
+/** ************************************************************* *
+ * @file        sensors_decim.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "sensors_decim.h"
+#include "string.h"
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       init a decimator. The first order windows are
+ *              invalid : the filter starts from zero.
+ * 
+ * @param       decim 
+ * @param       ratio   input samples per output sample, 1 : no filter 
+ * @param       order   1 (window average) to SENSORS_DECIM_ORDER_MAX 
+ * ************************************************************* **/
+void sensors_decim_init(STRUCT_SENSORS_DECIM_t *decim, uint8_t ratio, uint8_t order)
+{
+    memset(decim, 0, sizeof(STRUCT_SENSORS_DECIM_t));
+
+    if(ratio == 0u) ratio = 1u;
+    if(order == 0u) order = 1u;
+    if(order > SENSORS_DECIM_ORDER_MAX) order = SENSORS_DECIM_ORDER_MAX;
+    if(ratio == 1u) order = 1u;
+
+    decim->ratio = ratio;
+    decim->order = order;
+    decim->gain  = 1u;
+    for(uint8_t k = 0; k < order; k++) decim->gain *= ratio;
+    memset(decim->history, 0xFF, sizeof(decim->history));
+}
+
+/** ************************************************************* *
+ * @brief       give an input sample. The output is the input
+ *              filtered by order moving sums of ratio samples,
+ *              taken once per window. The first zero of the
+ *              response is the output rate : the aliases of the
+ *              output band are rejected, the order sets by how
+ *              much.
+ *              A source is valid in the output if it was valid in
+ *              all the inputs of the last order windows.
+ * 
+ * @param       decim 
+ * @param       in 
+ * @param       out 
+ * @return      true    end of a window, out is written 
+ * @return      false 
+ * ************************************************************* **/
+bool sensors_decim_push(STRUCT_SENSORS_DECIM_t *decim, const STRUCT_SENSORS_DECIM_SAMPLE_t *in, STRUCT_SENSORS_DECIM_SAMPLE_t *out)
+{
+    uint8_t invalid;
+
+    /* integrators, modulo 2^32 */
+    for(uint32_t c = 0; c < SENSORS_DECIM_CHANNELS; c++)
+    {
+        uint32_t x = (uint32_t)in->value[c];
+
+        for(uint8_t k = 0; k < decim->order; k++)
+        {
+            decim->integ[k][c] += x;
+            x = decim->integ[k][c];
+        }
+    }
+    decim->invalid |= (uint8_t)~in->valid;
+
+    if(++decim->phase < decim->ratio) return false;
+    decim->phase = 0;
+
+    /* combs, the wrap around of the integrators cancels */
+    for(uint32_t c = 0; c < SENSORS_DECIM_CHANNELS; c++)
+    {
+        uint32_t y = decim->integ[decim->order - 1u][c];
+
+        for(uint8_t k = 0; k < decim->order; k++)
+        {
+            uint32_t delayed = decim->comb[k][c];
+            decim->comb[k][c] = y;
+            y -= delayed;
+        }
+
+        /* rounded to the nearest */
+        int32_t sum  = (int32_t)y;
+        int32_t gain = (int32_t)decim->gain;
+        out->value[c] = (sum >= 0) ? (sum + gain / 2) / gain : -((-sum + gain / 2) / gain);
+    }
+
+    /* validity over the memory of the filter */
+    invalid = decim->invalid;
+    for(uint8_t k = 0; k + 1u < decim->order; k++) invalid |= decim->history[k];
+    for(uint8_t k = SENSORS_DECIM_ORDER_MAX - 1u; k > 0u; k--) decim->history[k] = decim->history[k - 1u];
+    decim->history[0] = decim->invalid;
+    decim->invalid    = 0;
+
+    out->time  = in->time;
+    out->valid = (uint8_t)~invalid;
+
+    return true;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,170 @@
+/** ************************************************************* *
+ * @file        API_trace.c
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include "API_trace.h"
+#include "stdbool.h"
+
+#if TRACE_SYSVIEW_ENABLE
+#include "SEGGER_SYSVIEW.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* List of the SystemView modules, one per component */
+typedef enum
+{
+    E_TRACE_MODULE_SENSORS,
+    E_TRACE_MODULE_HMI,
+    E_TRACE_MODULE_ACTUATOR,
+    E_TRACE_MODULE_APPLICATION,
+    E_TRACE_MODULE_NB
+}ENUM_TRACE_MODULE_t;
+
+/* event of a module */
+typedef struct
+{
+    ENUM_TRACE_MODULE_t module;
+    uint8_t             id;             /* event ID in the module */
+}STRUCT_TRACE_EVENT_t;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+/* The description strings follow the SystemView module format :
+ * "M=<module>, <id> <event> <param>=%u, ..." */
+static SEGGER_SYSVIEW_MODULE trace_module[E_TRACE_MODULE_NB] =
+{
+    [E_TRACE_MODULE_SENSORS] =
+    {
+        .sModule   = "M=Sensors, 0 Read sensor=%u, 1 Filter, 2 Publish sensor=%u",
+        .NumEvents = 3
+    },
+    [E_TRACE_MODULE_HMI] =
+    {
+        .sModule   = "M=HMI, 0 Queue ID=%u, 1 Send ID=%u",
+        .NumEvents = 2
+    },
+    [E_TRACE_MODULE_ACTUATOR] =
+    {
+        .sModule   = "M=Actuator, 0 Command cmd=%u, 1 EndStop pin=%u",
+        .NumEvents = 2
+    },
+    [E_TRACE_MODULE_APPLICATION] =
+    {
+        .sModule   = "M=Application, 0 Deploy",
+        .NumEvents = 1
+    }
+};
+
+static const STRUCT_TRACE_EVENT_t trace_event[E_TRACE_NB] =
+{
+    [E_TRACE_SENSORS_READ]    = {E_TRACE_MODULE_SENSORS,     0},
+    [E_TRACE_SENSORS_FILTER]  = {E_TRACE_MODULE_SENSORS,     1},
+    [E_TRACE_SENSORS_PUBLISH] = {E_TRACE_MODULE_SENSORS,     2},
+    [E_TRACE_HMI_QUEUE]       = {E_TRACE_MODULE_HMI,         0},
+    [E_TRACE_HMI_SEND]        = {E_TRACE_MODULE_HMI,         1},
+    [E_TRACE_ACTUATOR_CMD]    = {E_TRACE_MODULE_ACTUATOR,    0},
+    [E_TRACE_ACTUATOR_END]    = {E_TRACE_MODULE_ACTUATOR,    1},
+    [E_TRACE_APP_DEPLOY]      = {E_TRACE_MODULE_APPLICATION, 0}
+};
+
+/* the event offsets are valid once the modules are registered */
+static volatile bool trace_started = false;
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static unsigned int get_event_id(ENUM_TRACE_EVENT_t event);
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       get the SystemView ID of an event
+ * 
+ * @param       event 
+ * @return      unsigned int 
+ * ************************************************************* **/
+static unsigned int get_event_id(ENUM_TRACE_EVENT_t event)
+{
+    return trace_module[trace_event[event].module].EventOffset + trace_event[event].id;
+}
+
+/* ============================================================= ==
+   public functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       register the modules of the components.
+ *              Must be called after SEGGER_SYSVIEW_Conf().
+ * 
+ * ************************************************************* **/
+void API_TRACE_START(void)
+{
+    for(uint8_t i = 0; i < E_TRACE_MODULE_NB; i++)
+    {
+        SEGGER_SYSVIEW_RegisterModule(&trace_module[i]);
+    }
+
+    trace_started = true;
+}
+
+/** ************************************************************* *
+ * @brief       record the start of an event.
+ *              Can be called from an interrupt.
+ * 
+ * @param       event 
+ * @param       value 
+ * ************************************************************* **/
+void API_TRACE_ENTER(ENUM_TRACE_EVENT_t event, uint32_t value)
+{
+    if(trace_started == false || event >= E_TRACE_NB) return;
+
+    SEGGER_SYSVIEW_RecordU32(get_event_id(event), value);
+}
+
+/** ************************************************************* *
+ * @brief       record the end of an event started by 
+ *              API_TRACE_ENTER.
+ *              Can be called from an interrupt.
+ * 
+ * @param       event 
+ * @param       value 
+ * ************************************************************* **/
+void API_TRACE_EXIT(ENUM_TRACE_EVENT_t event, uint32_t value)
+{
+    if(trace_started == false || event >= E_TRACE_NB) return;
+
+    SEGGER_SYSVIEW_RecordEndCallU32(get_event_id(event), value);
+}
+
+/** ************************************************************* *
+ * @brief       record a single point event.
+ *              Can be called from an interrupt.
+ * 
+ * @param       event 
+ * @param       value 
+ * ************************************************************* **/
+void API_TRACE_MARK(ENUM_TRACE_EVENT_t event, uint32_t value)
+{
+    if(trace_started == false || event >= E_TRACE_NB) return;
+
+    SEGGER_SYSVIEW_RecordU32(get_event_id(event), value);
+}
+
+#endif /* TRACE_SYSVIEW_ENABLE */
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,68 @@
+/** ************************************************************* *
+ * @file        API_trace.h
+ * @brief       
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef TRACE_INC_API_TRACE_H_
+#define TRACE_INC_API_TRACE_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "stdint.h"
+
+#include "MS1_config.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* List of the user events shown on the SystemView timeline.
+ * ENTER/EXIT events are displayed as a call with its duration,
+ * MARK events as a single point */
+typedef enum
+{
+    E_TRACE_SENSORS_READ,       /* ENTER/EXIT, value : sensor / status */
+    E_TRACE_SENSORS_FILTER,     /* ENTER/EXIT, kalman filter update */
+    E_TRACE_SENSORS_PUBLISH,    /* MARK, value : sensor */
+    E_TRACE_HMI_QUEUE,          /* MARK, value : data ID */
+    E_TRACE_HMI_SEND,           /* ENTER/EXIT, value : data ID */
+    E_TRACE_ACTUATOR_CMD,       /* MARK, value : user << 8 | command */
+    E_TRACE_ACTUATOR_END,       /* MARK, value : end stop pin */
+    E_TRACE_APP_DEPLOY,         /* MARK, deploy decision, value : apogee evidence */
+    E_TRACE_NB
+}ENUM_TRACE_EVENT_t;
+
+/* List of the sensors for the sensors events */
+typedef enum
+{
+    E_TRACE_SENSOR_MPU6050,
+    E_TRACE_SENSOR_BMP280,
+    E_TRACE_SENSOR_STREAM           /* + ENUM_SENSORS_STREAM_t, decimated stream */
+}ENUM_TRACE_SENSOR_t;
+
+/* ------------------------------------------------------------- --
+   function propotypes
+-- ------------------------------------------------------------- */
+#if TRACE_SYSVIEW_ENABLE
+void API_TRACE_START(void);
+void API_TRACE_ENTER(ENUM_TRACE_EVENT_t event, uint32_t value);
+void API_TRACE_EXIT(ENUM_TRACE_EVENT_t event, uint32_t value);
+void API_TRACE_MARK(ENUM_TRACE_EVENT_t event, uint32_t value);
+#else
+#define API_TRACE_START()
+#define API_TRACE_ENTER(event, value)
+#define API_TRACE_EXIT(event, value)
+#define API_TRACE_MARK(event, value)
+#endif
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* TRACE_INC_API_TRACE_H_ */
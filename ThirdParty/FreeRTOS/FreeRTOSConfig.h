@@ -61,12 +61,25 @@
 #define configIDLE_SHOULD_YIELD			1
 #define configUSE_MUTEXES				1
 #define configQUEUE_REGISTRY_SIZE		8
-#define configCHECK_FOR_STACK_OVERFLOW	0
+#define configCHECK_FOR_STACK_OVERFLOW	2	/* stack pointer and end of the stack at each switch, vApplicationStackOverflowHook in API_health.c */
 #define configUSE_RECURSIVE_MUTEXES		1
 #define configUSE_MALLOC_FAILED_HOOK	0
 #define configUSE_APPLICATION_TASK_TAG	0
 #define configUSE_COUNTING_SEMAPHORES	1
-#define configGENERATE_RUN_TIME_STATS	0
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES	2	/* HMI task : work and end of DMA, caller of a HMI stream */
+#define configGENERATE_RUN_TIME_STATS	1
+
+/* Run time stats clock : DWT cycle counter (SYSCLK). The counter wraps
+every ~89 s at 48 MHz, the statistics must be read as deltas. */
+#if defined( __ICCARM__) || defined(__GNUC__) || defined(__CC_ARM)
+	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()										\
+		do {																			\
+			( *( volatile uint32_t * ) 0xE000EDFCUL ) |= ( 1UL << 24 );	/* DEMCR.TRCENA */	\
+			( *( volatile uint32_t * ) 0xE0001FB0UL )  = 0xC5ACCE55UL;	/* DWT->LAR unlock */	\
+			( *( volatile uint32_t * ) 0xE0001000UL ) |= 1UL;			/* DWT->CTRL.CYCCNTENA */	\
+		} while( 0 )
+	#define portGET_RUN_TIME_COUNTER_VALUE()	( *( volatile uint32_t * ) 0xE0001004UL )	/* DWT->CYCCNT */
+#endif
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
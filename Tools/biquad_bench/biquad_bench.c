@@ -0,0 +1,469 @@
+/** ************************************************************* *
+ * @file        biquad_bench.c
+ * @brief       Host test and benchmark of the biquad bank
+ *              (sensors_biquad.c) with the filters of API_sensors.c.
+ *              The coefficients computed by the compiler and the
+ *              response measured on sines are compared with the
+ *              Butterworth filters computed in double with tan(),
+ *              the bank is checked against a direct form I in
+ *              double, then the time per sample is compared with
+ *              a filter written channel by channel.
+ * 
+ *              build (from this folder) :
+ *              cc -O2 -Wall -Wextra -I../../Components/Sensors/inc
+ *                  biquad_bench.c ../../Components/Sensors/sensors_biquad.c
+ *                  -lm -o biquad_bench
+ * 
+ *              usage :
+ *              biquad_bench        -> exit code 0 when all the checks pass
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "sensors_biquad.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* as API_sensors.c */
+#define SENSORS_RATE            100u    /* [Hz] */
+#define SENSORS_IMU_CUTOFF      20u     /* [Hz] order 4 */
+#define SENSORS_BARO_CUTOFF     5u      /* [Hz] order 2 */
+
+#define TEST_PI                 3.14159265358979323846
+#define TEST_STEP               0.25    /* [Hz] frequency response */
+#define TEST_FLOOR              -60.0   /* [dB] stop band not compared below */
+#define TEST_SETTLE             400u    /* [sample] transient of a sine */
+#define TEST_WINDOW             2000u   /* [sample] whole periods of any integer frequency */
+#define TEST_SEED               0x4D533153u
+
+#define BENCH_BURST             32u     /* [frame] a FIFO burst */
+#define BENCH_LOOPS             200000u
+
+#define CHECK(cond)             check((cond), #cond, __LINE__)
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* specification of a filter of API_sensors.c */
+typedef struct
+{
+    const char *name;
+    const STRUCT_SENSORS_BIQUAD_COEF_t *coef;
+    uint8_t stages;
+    uint8_t channels;
+    double cutoff;              /* [Hz] */
+    double q[SENSORS_BIQUAD_STAGES_MAX];
+}STRUCT_TEST_FILTER_t;
+
+/* section in double */
+typedef struct
+{
+    double b0, b1, b2, a1, a2;
+}STRUCT_TEST_COEF_t;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+/* as API_sensors.c */
+static const STRUCT_SENSORS_BIQUAD_COEF_t imu_coef[] = {
+    SENSORS_BIQUAD_LOWPASS(SENSORS_IMU_CUTOFF, SENSORS_RATE, SENSORS_BIQUAD_Q_ORDER4_A),
+    SENSORS_BIQUAD_LOWPASS(SENSORS_IMU_CUTOFF, SENSORS_RATE, SENSORS_BIQUAD_Q_ORDER4_B),
+};
+static const STRUCT_SENSORS_BIQUAD_COEF_t baro_coef[] = {
+    SENSORS_BIQUAD_LOWPASS(SENSORS_BARO_CUTOFF, SENSORS_RATE, SENSORS_BIQUAD_Q_ORDER2),
+};
+
+static const STRUCT_TEST_FILTER_t filters[] = {
+    {"imu",  imu_coef,  2, 6, SENSORS_IMU_CUTOFF,  {0.54119610014619698, 1.30656296487637653}},
+    {"baro", baro_coef, 1, 2, SENSORS_BARO_CUTOFF, {0.70710678118654752}},
+};
+
+static uint32_t seed = TEST_SEED;
+static uint32_t failures = 0;
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+static void check(bool cond, const char *text, int line)
+{
+    if(cond == true) return;
+
+    printf("FAIL line %d : %s\n", line, text);
+    failures++;
+}
+
+/* xorshift32 */
+static uint32_t random32(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+static double now(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec * 1e9 + (double)time.tv_nsec;
+}
+
+/* time stamp counter, 0 when the host has none */
+static double cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (double)__rdtsc();
+#else
+    return 0.0;
+#endif
+}
+
+/* reference section : bilinear transform prewarped with tan() */
+static STRUCT_TEST_COEF_t reference(double fc, double q)
+{
+    double k = tan(TEST_PI * fc / SENSORS_RATE);
+    double norm = 1.0 + k / q + k * k;
+    STRUCT_TEST_COEF_t coef;
+
+    coef.b0 = k * k / norm;
+    coef.b1 = 2.0 * coef.b0;
+    coef.b2 = coef.b0;
+    coef.a1 = 2.0 * (k * k - 1.0) / norm;
+    coef.a2 = (1.0 - k / q + k * k) / norm;
+    return coef;
+}
+
+/* |H| of a section at f */
+static double gain(const STRUCT_TEST_COEF_t *coef, double f)
+{
+    double w = 2.0 * TEST_PI * f / SENSORS_RATE;
+    double nr = coef->b0 + coef->b1 * cos(w) + coef->b2 * cos(2.0 * w);
+    double ni = -coef->b1 * sin(w) - coef->b2 * sin(2.0 * w);
+    double dr = 1.0 + coef->a1 * cos(w) + coef->a2 * cos(2.0 * w);
+    double di = -coef->a1 * sin(w) - coef->a2 * sin(2.0 * w);
+
+    return sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+}
+
+static STRUCT_TEST_COEF_t widen(const STRUCT_SENSORS_BIQUAD_COEF_t *coef)
+{
+    STRUCT_TEST_COEF_t wide = {coef->b0, coef->b1, coef->b2, coef->a1, coef->a2};
+
+    return wide;
+}
+
+static double decibel(double value)
+{
+    return 20.0 * log10(value + 1e-300);
+}
+
+/* |H| of the cascade, in dB : coefficients of the bank or reference */
+static double response(const STRUCT_TEST_FILTER_t *filter, bool bank, double f)
+{
+    double g = 1.0;
+
+    for(uint8_t s = 0; s < filter->stages; s++)
+    {
+        STRUCT_TEST_COEF_t coef = bank ? widen(&filter->coef[s]) : reference(filter->cutoff, filter->q[s]);
+
+        g *= gain(&coef, f);
+    }
+    return decibel(g);
+}
+
+/* filter written channel by channel, direct form I : the time
+ * reference of the bank */
+static void channel_by_channel(const STRUCT_SENSORS_BIQUAD_COEF_t *coef, uint8_t stages, uint8_t channels,
+                               float state[][SENSORS_BIQUAD_CHANNELS_MAX][4], float *frames, uint32_t count)
+{
+    for(uint8_t c = 0; c < channels; c++)
+    {
+        for(uint8_t s = 0; s < stages; s++)
+        {
+            float *z = state[s][c];
+
+            for(uint32_t n = 0; n < count; n++)
+            {
+                float x = frames[n * channels + c];
+                float y = coef[s].b0 * x + coef[s].b1 * z[0] + coef[s].b2 * z[1] - coef[s].a1 * z[2] - coef[s].a2 * z[3];
+
+                z[1] = z[0];
+                z[0] = x;
+                z[3] = z[2];
+                z[2] = y;
+                frames[n * channels + c] = y;
+            }
+        }
+    }
+}
+
+/* ============================================================= ==
+   tests
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       tan() of the coefficients by its Pade approximant,
+ *              up to fs / 4
+ * 
+ * ************************************************************* **/
+static void test_tan(void)
+{
+    double error = 0.0;
+
+    for(double fc = 0.1; fc <= SENSORS_RATE / 4.0; fc += 0.1)
+    {
+        double x = TEST_PI * fc / SENSORS_RATE;
+        double e = fabs(SENSORS_BIQUAD_TAN(x) - tan(x)) / tan(x);
+
+        if(e > error) error = e;
+    }
+
+    printf("tan         : relative error %.2e up to fs / 4\n", error);
+    CHECK(error < 1e-6);
+}
+
+/** ************************************************************* *
+ * @brief       response of the coefficients of the bank against
+ *              the reference, down to TEST_FLOOR, and -3 dB at the
+ *              cutoff
+ * 
+ * ************************************************************* **/
+static void test_coefficients(void)
+{
+    for(uint32_t i = 0; i < sizeof(filters) / sizeof(filters[0]); i++)
+    {
+        const STRUCT_TEST_FILTER_t *filter = &filters[i];
+        double error = 0.0;
+
+        for(double f = 0.0; f < SENSORS_RATE / 2.0; f += TEST_STEP)
+        {
+            double ref = response(filter, false, f);
+            double e = fabs(response(filter, true, f) - ref);
+
+            if(ref > TEST_FLOOR && e > error) error = e;
+        }
+
+        printf("%-4s coef   : max error %.2e dB, %.3f dB at %.0f Hz (reference %.3f dB)\n", filter->name, error,
+               response(filter, true, filter->cutoff), filter->cutoff, response(filter, false, filter->cutoff));
+
+        CHECK(error < 1e-3);
+        CHECK(fabs(response(filter, true, filter->cutoff) + 3.0103) < 0.01);
+        CHECK(fabs(response(filter, true, 0.0)) < 1e-4);
+    }
+}
+
+/** ************************************************************* *
+ * @brief       sines through the bank, one per channel (several
+ *              frequencies in a burst) : the amplitude at the
+ *              output, by demodulation over whole periods, against
+ *              the reference response
+ * 
+ * ************************************************************* **/
+static void test_sines(void)
+{
+    static float frames[(TEST_SETTLE + TEST_WINDOW) * SENSORS_BIQUAD_CHANNELS_MAX];
+    const uint32_t count = TEST_SETTLE + TEST_WINDOW;
+
+    for(uint32_t i = 0; i < sizeof(filters) / sizeof(filters[0]); i++)
+    {
+        const STRUCT_TEST_FILTER_t *filter = &filters[i];
+        const uint8_t channels = filter->channels;
+        double error = 0.0;
+
+        for(uint32_t f0 = 1u; f0 + channels <= SENSORS_RATE / 2u; f0 += channels)
+        {
+            STRUCT_SENSORS_BIQUAD_t bank;
+
+            for(uint32_t n = 0; n < count; n++)
+            {
+                for(uint8_t c = 0; c < channels; c++)
+                {
+                    frames[n * channels + c] = (float)sin(2.0 * TEST_PI * (f0 + c) * n / SENSORS_RATE);
+                }
+            }
+
+            /* zero state : the first frame is 0 */
+            sensors_biquad_init(&bank, filter->coef, filter->stages, channels);
+            for(uint32_t n = 0; n < count; n += BENCH_BURST)
+            {
+                uint32_t burst = (count - n < BENCH_BURST) ? count - n : BENCH_BURST;
+
+                sensors_biquad_process(&bank, &frames[n * channels], &frames[n * channels], burst);
+            }
+
+            for(uint8_t c = 0; c < channels; c++)
+            {
+                double f = f0 + c;
+                double re = 0.0;
+                double im = 0.0;
+                double ref = response(filter, false, f);
+                double e;
+
+                for(uint32_t n = TEST_SETTLE; n < count; n++)
+                {
+                    re += frames[n * channels + c] * cos(2.0 * TEST_PI * f * n / SENSORS_RATE);
+                    im += frames[n * channels + c] * sin(2.0 * TEST_PI * f * n / SENSORS_RATE);
+                }
+
+                e = fabs(decibel(2.0 * sqrt(re * re + im * im) / TEST_WINDOW) - ref);
+                if(ref > TEST_FLOOR / 2.0 && e > error) error = e;
+            }
+        }
+
+        printf("%-4s sines  : max error %.2e dB down to %.0f dB\n", filter->name, error, TEST_FLOOR / 2.0);
+        CHECK(error < 1e-3);
+    }
+}
+
+/** ************************************************************* *
+ * @brief       noise through the bank and through a direct form I
+ *              in double with the reference coefficients. A burst
+ *              is the same as frame by frame, in place or not.
+ *              The primed bank stays on a constant pressure.
+ * 
+ * ************************************************************* **/
+static void test_noise(void)
+{
+    enum { FRAMES = 4096 };
+    static float in[FRAMES * SENSORS_BIQUAD_CHANNELS_MAX];
+    static float burst[FRAMES * SENSORS_BIQUAD_CHANNELS_MAX];
+    static float single[FRAMES * SENSORS_BIQUAD_CHANNELS_MAX];
+
+    for(uint32_t i = 0; i < sizeof(filters) / sizeof(filters[0]); i++)
+    {
+        const STRUCT_TEST_FILTER_t *filter = &filters[i];
+        const uint8_t channels = filter->channels;
+        STRUCT_SENSORS_BIQUAD_t a;
+        STRUCT_SENSORS_BIQUAD_t b;
+        double z[SENSORS_BIQUAD_STAGES_MAX][SENSORS_BIQUAD_CHANNELS_MAX][4] = {0};
+        double error = 0.0;
+        uint32_t differ = 0;
+
+        for(uint32_t n = 0; n < FRAMES * channels; n++) in[n] = (n < channels) ? 0.0f : (float)((int32_t)(random32() % 2001u) - 1000) / 1000.0f;
+
+        sensors_biquad_init(&a, filter->coef, filter->stages, channels);
+        sensors_biquad_init(&b, filter->coef, filter->stages, channels);
+        memcpy(burst, in, sizeof(burst));
+        sensors_biquad_process(&a, burst, burst, FRAMES);
+        for(uint32_t n = 0; n < FRAMES; n++) sensors_biquad_process(&b, &in[n * channels], &single[n * channels], 1);
+
+        for(uint32_t n = 0; n < FRAMES; n++)
+        {
+            for(uint8_t c = 0; c < channels; c++)
+            {
+                double y = in[n * channels + c];
+
+                for(uint8_t s = 0; s < filter->stages; s++)
+                {
+                    STRUCT_TEST_COEF_t coef = reference(filter->cutoff, filter->q[s]);
+                    double *w = z[s][c];
+                    double x = y;
+
+                    y = coef.b0 * x + coef.b1 * w[0] + coef.b2 * w[1] - coef.a1 * w[2] - coef.a2 * w[3];
+                    w[1] = w[0];
+                    w[0] = x;
+                    w[3] = w[2];
+                    w[2] = y;
+                }
+
+                if(fabs(burst[n * channels + c] - y) > error) error = fabs(burst[n * channels + c] - y);
+                if(burst[n * channels + c] != single[n * channels + c]) differ++;
+            }
+        }
+
+        printf("%-4s noise  : max error %.2e for a full scale of 1\n", filter->name, error);
+        CHECK(error < 1e-5);
+        CHECK(differ == 0u);
+    }
+
+    /* primed on the pressure at the ground : no transient */
+    {
+        STRUCT_SENSORS_BIQUAD_t bank;
+        float frame[2];
+        double deviation = 0.0;
+
+        sensors_biquad_init(&bank, baro_coef, 1, 2);
+        for(uint32_t n = 0; n < 1000u; n++)
+        {
+            frame[0] = 101325.0f;
+            frame[1] = 20.0f;
+            sensors_biquad_process(&bank, frame, frame, 1);
+            if(fabs(frame[0] - 101325.0) > deviation) deviation = fabs(frame[0] - 101325.0);
+        }
+
+        /* rounding of the states, below the noise of the BMP280 (1.3 Pa) */
+        printf("baro prime  : max deviation %.3f Pa on 101325 Pa\n", deviation);
+        CHECK(deviation < 0.5);
+    }
+}
+
+/** ************************************************************* *
+ * @brief       time per sample of a channel : bursts of the imu
+ *              bank against the filter written channel by channel
+ * 
+ * ************************************************************* **/
+static void bench(void)
+{
+    static float frames[BENCH_BURST * SENSORS_BIQUAD_CHANNELS_MAX];
+    static float state[SENSORS_BIQUAD_STAGES_MAX][SENSORS_BIQUAD_CHANNELS_MAX][4];
+    const STRUCT_TEST_FILTER_t *filter = &filters[0];
+    const double samples = (double)BENCH_LOOPS * BENCH_BURST * filter->channels;
+    STRUCT_SENSORS_BIQUAD_t bank;
+    double start_ns, start_cy;
+    double bank_ns, bank_cy;
+    double ref_ns, ref_cy;
+
+    for(uint32_t n = 0; n < sizeof(frames) / sizeof(frames[0]); n++) frames[n] = (float)(n % 7u);
+
+    sensors_biquad_init(&bank, filter->coef, filter->stages, filter->channels);
+    start_ns = now();
+    start_cy = cycles();
+    for(uint32_t i = 0; i < BENCH_LOOPS; i++) sensors_biquad_process(&bank, frames, frames, BENCH_BURST);
+    bank_cy = (cycles() - start_cy) / samples;
+    bank_ns = (now() - start_ns) / samples;
+
+    start_ns = now();
+    start_cy = cycles();
+    for(uint32_t i = 0; i < BENCH_LOOPS; i++) channel_by_channel(filter->coef, filter->stages, filter->channels, state, frames, BENCH_BURST);
+    ref_cy = (cycles() - start_cy) / samples;
+    ref_ns = (now() - start_ns) / samples;
+
+    printf("imu bank    : %.2f ns, %.1f cycles per sample (burst of %u frames, %u stages)\n", bank_ns, bank_cy, BENCH_BURST, filter->stages);
+    printf("per channel : %.2f ns, %.1f cycles per sample (x%.2f)\n", ref_ns, ref_cy, bank_ns > 0.0 ? ref_ns / bank_ns : 0.0);
+}
+
+/* ============================================================= ==
+   main
+== ============================================================= */
+int main(void)
+{
+    test_tan();
+    test_coefficients();
+    test_sines();
+    test_noise();
+    bench();
+
+    printf("%s (%u failures)\n", failures == 0u ? "PASS" : "FAIL", failures);
+    return failures == 0u ? 0 : 1;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,247 @@
+/** ************************************************************* *
+ * @file        cksum_test.c
+ * @brief       Host test of the TinyFrame checksum (tf_cksum.c)
+ *              built with the slice-by-4 tables (TF_CKSUM_HW 0).
+ *              TF_CksumBlock and TF_CksumAdd are compared with a
+ *              bitwise CRC-16/ARC over random lengths, alignments
+ *              and chained blocks, then the throughput of both is
+ *              measured.
+ * 
+ *              build (from this folder) :
+ *              cc -O2 -Wall -Wextra -DTF_CKSUM_HW=0 -Isim
+ *                  -I../../Components/HMI/inc cksum_test.c
+ *                  ../../Components/HMI/tf_cksum.c -o cksum_test
+ * 
+ *              usage :
+ *              cksum_test          -> exit code 0 when all the checks pass
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "tf_cksum.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define TEST_SIZE_MAX           1024u   /* [byte] max block length */
+#define TEST_RANDOM_BLOCKS      100000u
+#define TEST_SEED               0x4D533153u
+
+#define BENCH_SIZE              128u    /* [byte] a frame of the radio link */
+#define BENCH_LOOPS             200000u
+
+#define CHECK(cond)             check((cond), #cond, __LINE__)
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+static uint8_t buffer[TEST_SIZE_MAX + 8u];
+static uint32_t seed = TEST_SEED;
+
+static uint32_t failures = 0;
+
+/* ============================================================= ==
+   host stubs
+== ============================================================= */
+uint32_t sim_counter(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)now.tv_sec * 1000000000u + (uint32_t)now.tv_nsec;
+}
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+static void check(bool cond, const char *text, int line)
+{
+    if(cond == true) return;
+
+    printf("FAIL line %d : %s\n", line, text);
+    failures++;
+}
+
+/* xorshift32 */
+static uint32_t random32(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+static void fill(void)
+{
+    for(uint32_t i = 0; i < sizeof(buffer); i++) buffer[i] = (uint8_t)random32();
+}
+
+/* CRC-16/ARC, one bit at a time : independent of the tables */
+static TF_CKSUM reference(TF_CKSUM cksum, const uint8_t *data, uint32_t len)
+{
+    while(len--)
+    {
+        cksum ^= *data++;
+        for(int bit = 0; bit < 8; bit++)
+        {
+            cksum = (cksum & 1u) ? (cksum >> 1) ^ 0xA001u : cksum >> 1;
+        }
+    }
+
+    return cksum;
+}
+
+static TF_CKSUM bytewise(TF_CKSUM cksum, const uint8_t *data, uint32_t len)
+{
+    while(len--) cksum = TF_CksumAdd(cksum, *data++);
+
+    return cksum;
+}
+
+/* ============================================================= ==
+   tests
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       check value of the CRC-16/ARC catalogue
+ * 
+ * ************************************************************* **/
+static void test_check_value(void)
+{
+    static const uint8_t text[] = "123456789";
+
+    CHECK(reference(0u, text, 9u) == 0xBB3Du);
+    CHECK(TF_CksumEnd(bytewise(TF_CksumStart(), text, 9u)) == 0xBB3Du);
+    CHECK(TF_CksumEnd(TF_CksumBlock(TF_CksumStart(), text, 9u)) == 0xBB3Du);
+}
+
+/** ************************************************************* *
+ * @brief       every length up to 64 at every alignment of a word
+ *              (and one past), then random lengths and alignments
+ * 
+ * ************************************************************* **/
+static void test_lengths(void)
+{
+    uint32_t errors = 0;
+
+    fill();
+    for(uint32_t offset = 0; offset < 8u; offset++)
+    {
+        for(uint32_t len = 0; len <= 64u; len++)
+        {
+            TF_CKSUM ref = reference(0u, &buffer[offset], len);
+
+            if(TF_CksumBlock(0u, &buffer[offset], len) != ref) errors++;
+            if(bytewise(0u, &buffer[offset], len) != ref) errors++;
+        }
+    }
+    CHECK(errors == 0u);
+
+    errors = 0;
+    for(uint32_t i = 0; i < TEST_RANDOM_BLOCKS; i++)
+    {
+        uint32_t len    = random32() % (TEST_SIZE_MAX + 1u);
+        uint32_t offset = random32() & 7u;
+        TF_CKSUM init   = (TF_CKSUM)random32();
+
+        if((i & 1023u) == 0u) fill();
+        if(TF_CksumBlock(init, &buffer[offset], len) != reference(init, &buffer[offset], len)) errors++;
+    }
+    CHECK(errors == 0u);
+}
+
+/** ************************************************************* *
+ * @brief       a block split at any point : the running checksum
+ *              of the first part seeds the second (header then
+ *              payload in TinyFrame)
+ * 
+ * ************************************************************* **/
+static void test_chained(void)
+{
+    uint32_t errors = 0;
+
+    fill();
+    for(uint32_t i = 0; i < 10000u; i++)
+    {
+        uint32_t len    = random32() % (TEST_SIZE_MAX + 1u);
+        uint32_t split  = len ? random32() % (len + 1u) : 0u;
+        uint32_t offset = random32() & 7u;
+        TF_CKSUM cksum;
+
+        cksum = bytewise(TF_CksumStart(), &buffer[offset], split);
+        cksum = TF_CksumBlock(cksum, &buffer[offset + split], len - split);
+
+        if(cksum != reference(0u, &buffer[offset], len)) errors++;
+    }
+    CHECK(errors == 0u);
+}
+
+/** ************************************************************* *
+ * @brief       the target self test, run on the host counter
+ * 
+ * ************************************************************* **/
+static void test_bench(void)
+{
+    STRUCT_TF_CKSUM_BENCH_t bench;
+
+    TF_CksumInit();
+    CHECK(TF_CksumBench(&bench) == true);
+    CHECK(bench.bytes > 0u);
+}
+
+/** ************************************************************* *
+ * @brief       throughput of the byte table and of the block
+ *              checksum over frames of BENCH_SIZE bytes
+ * 
+ * ************************************************************* **/
+static void bench(void)
+{
+    volatile TF_CKSUM sink = 0;
+    uint32_t start;
+    double bytes_ns;
+    double block_ns;
+
+    fill();
+
+    start = sim_counter();
+    for(uint32_t i = 0; i < BENCH_LOOPS; i++) sink ^= bytewise(0u, &buffer[i & 3u], BENCH_SIZE);
+    bytes_ns = (double)(sim_counter() - start) / ((double)BENCH_LOOPS * BENCH_SIZE);
+
+    start = sim_counter();
+    for(uint32_t i = 0; i < BENCH_LOOPS; i++) sink ^= TF_CksumBlock(0u, &buffer[i & 3u], BENCH_SIZE);
+    block_ns = (double)(sim_counter() - start) / ((double)BENCH_LOOPS * BENCH_SIZE);
+
+    printf("byte table   : %.3f ns/byte\n", bytes_ns);
+    printf("slice-by-4   : %.3f ns/byte (x%.2f)\n", block_ns, block_ns > 0.0 ? bytes_ns / block_ns : 0.0);
+    (void)sink;
+}
+
+/* ============================================================= ==
+   main
+== ============================================================= */
+int main(void)
+{
+    test_check_value();
+    test_lengths();
+    test_chained();
+    test_bench();
+    bench();
+
+    printf("%s (%u failures)\n", failures == 0u ? "PASS" : "FAIL", failures);
+    return failures == 0u ? 0 : 1;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
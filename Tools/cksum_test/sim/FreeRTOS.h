@@ -0,0 +1,35 @@
+/** ************************************************************* *
+ * @file        FreeRTOS.h
+ * @brief       Host stub of the cksum_test : the run time counter
+ *              is the cycle counter of the host (nanoseconds).
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef CKSUM_TEST_FREERTOS_H_
+#define CKSUM_TEST_FREERTOS_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include <stdint.h>
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define portGET_RUN_TIME_COUNTER_VALUE()    sim_counter()
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+uint32_t sim_counter(void);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* CKSUM_TEST_FREERTOS_H_ */
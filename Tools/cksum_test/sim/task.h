@@ -0,0 +1,31 @@
+/** ************************************************************* *
+ * @file        task.h
+ * @brief       Host stub of the cksum_test, see FreeRTOS.h
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef CKSUM_TEST_TASK_H_
+#define CKSUM_TEST_TASK_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "FreeRTOS.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* one task : nothing to protect */
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* CKSUM_TEST_TASK_H_ */
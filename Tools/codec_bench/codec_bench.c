@@ -0,0 +1,508 @@
+/** ************************************************************* *
+ * @file        codec_bench.c
+ * @brief       Host benchmark of the log codec (log_codec.c) : the
+ *              imu and baro records of a log are packed by blocks
+ *              of LOG_CODEC_SAMPLES as the datalogger does, then
+ *              decoded and compared. Gives the ratio to the raw
+ *              records, in bytes and in pages of the flash (flight
+ *              time per chip), and the encode and decode time of
+ *              a block.
+ *              The log is a dump of the flash (as log_decoder), or
+ *              a simulated flight : imu at 1 kHz, baro at 100 Hz,
+ *              10 s on the pad, 3 s of boost with the vibrations of
+ *              the motor, coast and descent under the parachute.
+ * 
+ *              build (from this folder) :
+ *              cc -O2 -Wall -Wextra -I../../Components/Datalogger/inc
+ *                  codec_bench.c ../../Components/Datalogger/log_page.c
+ *                  ../../Components/Datalogger/log_codec.c -lm
+ *                  -o codec_bench
+ * 
+ *              usage :
+ *              codec_bench [image] -> exit code 0 when all the checks pass
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "log_format.h"
+#include "log_page.h"
+#include "log_codec.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define TRACE_MAX               (1u << 20)  /* [record] */
+#define TRACE_SEED              0x4D533153u
+
+/* simulated flight */
+#define FLIGHT_DURATION         120000u     /* [ms] */
+#define FLIGHT_BARO_PERIOD      10u         /* [ms] */
+#define FLIGHT_ACCEL_G          2048.0      /* [LSB/g] +-16 g */
+#define FLIGHT_GYRO_DPS         16.4        /* [LSB/(deg/s)] +-2000 deg/s */
+
+#define BENCH_ROUNDS            20u         /* encodes of the whole trace */
+#define RANDOM_BLOCKS           10000u      /* incompressible blocks */
+
+#define CHECK(cond)             check((cond), #cond, __LINE__)
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* blocks of a record type */
+typedef struct
+{
+    const char* name;
+    unsigned long records;
+    unsigned long raw;          /* [byte] records as is */
+    unsigned long packed;       /* [byte] E_LOG_REC_PACK records */
+    unsigned long blocks;
+    unsigned long errors;       /* blocks not decoded as encoded */
+    uint32_t size_max;          /* [byte] largest block */
+}STRUCT_BENCH_TYPE_t;
+
+/* pages of the log, records appended as the datalogger */
+typedef struct
+{
+    unsigned long pages;
+    uint32_t fill;              /* [byte] */
+}STRUCT_BENCH_PAGES_t;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+static STRUCT_LOG_RECORD_t trace[TRACE_MAX];
+static uint32_t trace_nb = 0;
+
+static STRUCT_BENCH_TYPE_t types[E_LOG_REC_BARO + 1u] = {
+    [E_LOG_REC_IMU]  = {.name = "imu"},
+    [E_LOG_REC_BARO] = {.name = "baro"},
+};
+
+static uint32_t seed = TRACE_SEED;
+static uint32_t failures = 0;
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+static void check(bool cond, const char *text, int line)
+{
+    if(cond == true) return;
+
+    printf("FAIL line %d : %s\n", line, text);
+    failures++;
+}
+
+/* xorshift32 */
+static uint32_t random32(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+/* about gaussian noise, standard deviation sigma */
+static double noise(double sigma)
+{
+    int32_t sum = 0;
+
+    for(int i = 0; i < 4; i++) sum += (int32_t)(random32() % 2001u) - 1000;
+
+    return (double)sum * sigma / 1155.0;
+}
+
+static int16_t saturate(double value)
+{
+    if(value > INT16_MAX) return INT16_MAX;
+    if(value < INT16_MIN) return INT16_MIN;
+    return (int16_t)lround(value);
+}
+
+static double now(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec * 1e9 + (double)time.tv_nsec;
+}
+
+/* record appended to a page, a new page when it doesn't fit */
+static void page_add(STRUCT_BENCH_PAGES_t *pages, uint32_t size)
+{
+    if(pages->pages == 0u || pages->fill + size > LOG_PAGE_DATA)
+    {
+        pages->pages++;
+        pages->fill = 0;
+    }
+    pages->fill += size;
+}
+
+/** ************************************************************* *
+ * @brief       simulated flight, records as the application writes
+ *              them (raw axes of the MPU6050, kalman angles, baro
+ *              in Pa and cm)
+ * 
+ * ************************************************************* **/
+static void simulate(void)
+{
+    double alt = 0.0;
+    double vel = 0.0;
+
+    for(uint32_t t = 0; t < FLIGHT_DURATION && trace_nb + 2u <= TRACE_MAX; t++)
+    {
+        double s = (double)t / 1000.0;
+        double accel = 1.0;     /* [g] along the axis of the rocket */
+        double vibration = 0.01;
+        double spin = 0.0;      /* [deg/s] roll */
+        double tilt = 0.0;      /* [deg] */
+        STRUCT_LOG_RECORD_t *rec = &trace[trace_nb++];
+
+        if(s < 10.0)            { }
+        else if(s < 13.0)       { accel = 12.0; vibration = 0.5; spin = 90.0; tilt = (s - 10.0) * 1.5; }
+        else if(vel > 0.0)      { accel = 0.0; vibration = 0.05; spin = 60.0; tilt = 4.5 + (s - 13.0) * 0.6; }
+        else                    { accel = 1.0; vibration = 0.1; spin = 20.0 * sin(s); tilt = 15.0 + 10.0 * sin(s / 2.0); }
+
+        vel += ((accel - 1.0) * 9.81) * 0.001;
+        if(s >= 13.0 && vel <= 0.0) vel = -8.0;
+        alt += vel * 0.001;
+        if(alt < 0.0) { alt = 0.0; vel = 0.0; }
+
+        rec->head.type     = E_LOG_REC_IMU;
+        rec->head.size     = sizeof(STRUCT_LOG_IMU_t);
+        rec->head.reserved = 0;
+        rec->head.time     = t;
+        rec->data.imu.accel[0] = saturate((noise(vibration) + 0.002) * FLIGHT_ACCEL_G);
+        rec->data.imu.accel[1] = saturate((noise(vibration) - 0.004) * FLIGHT_ACCEL_G);
+        rec->data.imu.accel[2] = saturate((accel + noise(vibration)) * FLIGHT_ACCEL_G);
+        rec->data.imu.gyro[0]  = saturate((noise(0.05) + 0.3) * FLIGHT_GYRO_DPS);
+        rec->data.imu.gyro[1]  = saturate((noise(0.05) - 0.2) * FLIGHT_GYRO_DPS);
+        rec->data.imu.gyro[2]  = saturate((spin + noise(0.05 + vibration)) * FLIGHT_GYRO_DPS);
+        rec->data.imu.angle_x  = saturate(tilt * 100.0 + noise(5.0));
+        rec->data.imu.angle_y  = saturate(tilt * 25.0 + noise(5.0));
+
+        if((t % FLIGHT_BARO_PERIOD) == 0u)
+        {
+            double h = alt + noise(0.3);
+
+            rec = &trace[trace_nb++];
+            rec->head.type     = E_LOG_REC_BARO;
+            rec->head.size     = sizeof(STRUCT_LOG_BARO_t);
+            rec->head.reserved = 0;
+            rec->head.time     = t;
+            rec->data.baro.pressure    = (int32_t)lround(101325.0 * pow(1.0 - h / 44330.0, 5.255));
+            rec->data.baro.altitude    = (int32_t)lround(h * 100.0);
+            rec->data.baro.temperature = saturate((20.0 - alt * 0.0065) * 100.0 + noise(2.0));
+            rec->data.baro.reserved    = 0;
+        }
+    }
+}
+
+/** ************************************************************* *
+ * @brief       imu and baro records of a dump of the flash, the
+ *              blocks of the datalogger decoded
+ * 
+ * @param       path 
+ * @return      int     0 ok, -1 error 
+ * ************************************************************* **/
+static int load(const char *path)
+{
+    static uint8_t page[LOG_PAGE_SIZE];
+    FILE *file = fopen(path, "rb");
+
+    if(file == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    while(fread(page, 1, sizeof(page), file) == sizeof(page))
+    {
+        STRUCT_LOG_PAGE_HEAD_t page_head;
+        uint32_t pos = 0;
+
+        if(log_page_check(page) != E_LOG_PAGE_VALID) continue;
+        memcpy(&page_head, page, sizeof(page_head));
+
+        while(pos + sizeof(STRUCT_LOG_HEAD_t) <= page_head.used)
+        {
+            STRUCT_LOG_RECORD_t record;
+            const uint8_t *data = &page[sizeof(page_head) + pos + sizeof(STRUCT_LOG_HEAD_t)];
+
+            memcpy(&record.head, &page[sizeof(page_head) + pos], sizeof(record.head));
+            pos += sizeof(STRUCT_LOG_HEAD_t) + record.head.size;
+            if(pos > page_head.used || trace_nb + LOG_CODEC_SAMPLES > TRACE_MAX) break;
+
+            if(record.head.type == E_LOG_REC_PACK)
+            {
+                trace_nb += log_codec_decode(data, record.head.size, record.head.time, &trace[trace_nb], LOG_CODEC_SAMPLES);
+            }
+            else if(log_codec_supported(record.head.type) && record.head.size <= sizeof(record.data))
+            {
+                memset(&record.data, 0, sizeof(record.data));
+                memcpy(&record.data, data, record.head.size);
+                trace[trace_nb++] = record;
+            }
+        }
+    }
+
+    fclose(file);
+    return 0;
+}
+
+/* samples decoded as encoded : header and payload */
+static bool same(const STRUCT_LOG_RECORD_t *a, const STRUCT_LOG_RECORD_t *b)
+{
+    return a->head.type == b->head.type && a->head.size == b->head.size && a->head.time == b->head.time
+        && memcmp(&a->data, &b->data, a->head.size) == 0;
+}
+
+/** ************************************************************* *
+ * @brief       one block : encoded, decoded and compared, counted
+ *              in the statistics of its type
+ * 
+ * @param       samples 
+ * @param       count 
+ * @param       pages   pages of the packed log 
+ * ************************************************************* **/
+static void pack(const STRUCT_LOG_RECORD_t *samples, uint32_t count, STRUCT_BENCH_PAGES_t *pages)
+{
+    STRUCT_BENCH_TYPE_t *type = &types[samples[0].head.type];
+    STRUCT_LOG_RECORD_t decoded[LOG_CODEC_SAMPLES];
+    uint8_t block[LOG_CODEC_SIZE_MAX] __attribute__((aligned(4)));
+    uint32_t len = log_codec_encode(samples, count, block, sizeof(block));
+    bool ok = len > 0u && len <= UINT8_MAX;
+
+    if(ok == true) ok = log_codec_decode(block, len, samples[0].head.time, decoded, LOG_CODEC_SAMPLES) == count;
+    for(uint32_t i = 0; i < count && ok == true; i++) ok = same(&samples[i], &decoded[i]);
+
+    type->blocks++;
+    type->errors += (ok == true) ? 0u : 1u;
+    type->packed += sizeof(STRUCT_LOG_HEAD_t) + len;
+    if(len > type->size_max) type->size_max = len;
+
+    page_add(pages, sizeof(STRUCT_LOG_HEAD_t) + len);
+}
+
+/* ============================================================= ==
+   tests
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       the trace in blocks of the same type, in the order
+ *              of the records (store() of the datalogger) : exact
+ *              round trip, ratio in bytes and in pages
+ * 
+ * @param       simulated   the flight of simulate() 
+ * ************************************************************* **/
+static void test_ratio(bool simulated)
+{
+    static STRUCT_LOG_RECORD_t waiting[E_LOG_REC_BARO + 1u][LOG_CODEC_SAMPLES];
+    uint32_t waiting_nb[E_LOG_REC_BARO + 1u] = {0};
+    STRUCT_BENCH_PAGES_t raw = {0};
+    STRUCT_BENCH_PAGES_t packed = {0};
+    unsigned long raw_bytes = 0;
+    unsigned long packed_bytes = 0;
+
+    for(uint32_t i = 0; i < trace_nb; i++)
+    {
+        uint8_t t = trace[i].head.type;
+        uint32_t size = sizeof(STRUCT_LOG_HEAD_t) + trace[i].head.size;
+
+        types[t].records++;
+        types[t].raw += size;
+        page_add(&raw, size);
+
+        waiting[t][waiting_nb[t]++] = trace[i];
+        if(waiting_nb[t] == LOG_CODEC_SAMPLES)
+        {
+            pack(waiting[t], LOG_CODEC_SAMPLES, &packed);
+            waiting_nb[t] = 0;
+        }
+    }
+    for(uint8_t t = E_LOG_REC_IMU; t <= E_LOG_REC_BARO; t++)
+    {
+        if(waiting_nb[t] > 0u) pack(waiting[t], waiting_nb[t], &packed);
+    }
+
+    for(uint8_t t = E_LOG_REC_IMU; t <= E_LOG_REC_BARO; t++)
+    {
+        STRUCT_BENCH_TYPE_t *type = &types[t];
+
+        if(type->records == 0u) continue;
+        printf("%-4s : %8lu records, %9lu -> %9lu bytes (x%.2f), %lu blocks, largest %u bytes\n",
+               type->name, type->records, type->raw, type->packed,
+               type->packed > 0u ? (double)type->raw / (double)type->packed : 0.0, type->blocks, type->size_max);
+
+        CHECK(type->errors == 0u);
+        CHECK(type->size_max <= LOG_CODEC_SIZE_MAX);
+        raw_bytes += type->raw;
+        packed_bytes += type->packed;
+    }
+
+    printf("log  : %lu -> %lu bytes, %lu -> %lu pages of %u bytes, flight time per flash x%.2f\n",
+           raw_bytes, packed_bytes, raw.pages, packed.pages, LOG_PAGE_SIZE,
+           packed.pages > 0u ? (double)raw.pages / (double)packed.pages : 0.0);
+
+    /* 2 to 4 times more flight per flash */
+    if(simulated == true) CHECK(raw.pages >= 2u * packed.pages);
+}
+
+/** ************************************************************* *
+ * @brief       incompressible blocks (random fields and times) :
+ *              never larger than LOG_CODEC_SIZE_MAX, nor than the
+ *              length of a record, exact round trip
+ * 
+ * ************************************************************* **/
+static void test_random(void)
+{
+    STRUCT_LOG_RECORD_t samples[LOG_CODEC_SAMPLES];
+    STRUCT_LOG_RECORD_t decoded[LOG_CODEC_SAMPLES];
+    uint8_t block[LOG_CODEC_SIZE_MAX] __attribute__((aligned(4)));
+    uint32_t errors = 0;
+    uint32_t size_max = 0;
+
+    for(uint32_t n = 0; n < RANDOM_BLOCKS; n++)
+    {
+        uint8_t type = (n & 1u) ? E_LOG_REC_IMU : E_LOG_REC_BARO;
+        uint32_t count = 1u + random32() % LOG_CODEC_SAMPLES;
+        uint32_t len;
+
+        memset(samples, 0, sizeof(samples));
+        for(uint32_t i = 0; i < count; i++)
+        {
+            samples[i].head.type = type;
+            samples[i].head.time = random32();
+            if(type == E_LOG_REC_IMU)
+            {
+                samples[i].head.size = sizeof(STRUCT_LOG_IMU_t);
+                for(uint32_t b = 0; b < sizeof(STRUCT_LOG_IMU_t); b++) ((uint8_t*)&samples[i].data)[b] = (uint8_t)random32();
+            }
+            else
+            {
+                samples[i].head.size = sizeof(STRUCT_LOG_BARO_t);
+                samples[i].data.baro.pressure    = (int32_t)random32();
+                samples[i].data.baro.altitude    = (int32_t)random32();
+                samples[i].data.baro.temperature = (int16_t)random32();
+            }
+        }
+
+        len = log_codec_encode(samples, count, block, sizeof(block));
+        if(len == 0u || len > UINT8_MAX || log_codec_decode(block, len, samples[0].head.time, decoded, LOG_CODEC_SAMPLES) != count) { errors++; continue; }
+        for(uint32_t i = 0; i < count; i++) if(same(&samples[i], &decoded[i]) == false) errors++;
+        if(len > size_max) size_max = len;
+    }
+
+    CHECK(errors == 0u);
+    CHECK(size_max <= LOG_CODEC_SIZE_MAX);
+    printf("random : largest block %u bytes (bound %u)\n", size_max, (unsigned)LOG_CODEC_SIZE_MAX);
+}
+
+/** ************************************************************* *
+ * @brief       time of the imu blocks (the most frequent and the
+ *              largest) : mean over the trace, then mean over
+ *              incompressible blocks, the bound of the codec
+ * 
+ * ************************************************************* **/
+static void bench(void)
+{
+    static uint8_t encoded[TRACE_MAX / LOG_CODEC_SAMPLES][LOG_CODEC_SIZE_MAX] __attribute__((aligned(4)));
+    static uint32_t lengths[TRACE_MAX / LOG_CODEC_SAMPLES];
+    static STRUCT_LOG_RECORD_t imu[TRACE_MAX];
+    STRUCT_LOG_RECORD_t decoded[LOG_CODEC_SAMPLES];
+    volatile uint32_t sink = 0;
+    uint32_t imu_nb = 0;
+    uint32_t nb;
+    double encode_ns;
+    double decode_ns;
+    double random_ns;
+    double start;
+
+    for(uint32_t i = 0; i < trace_nb; i++)
+    {
+        if(trace[i].head.type == E_LOG_REC_IMU) imu[imu_nb++] = trace[i];
+    }
+    nb = imu_nb / LOG_CODEC_SAMPLES;
+    if(nb == 0u) return;
+
+    start = now();
+    for(uint32_t round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for(uint32_t n = 0; n < nb; n++)
+        {
+            lengths[n] = log_codec_encode(&imu[n * LOG_CODEC_SAMPLES], LOG_CODEC_SAMPLES, encoded[n], sizeof(encoded[n]));
+        }
+    }
+    encode_ns = (now() - start) / ((double)BENCH_ROUNDS * nb);
+
+    start = now();
+    for(uint32_t round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for(uint32_t n = 0; n < nb; n++)
+        {
+            sink += log_codec_decode(encoded[n], lengths[n], imu[n * LOG_CODEC_SAMPLES].head.time, decoded, LOG_CODEC_SAMPLES);
+        }
+    }
+    decode_ns = (now() - start) / ((double)BENCH_ROUNDS * nb);
+
+    /* random payloads and times : widest channels */
+    for(uint32_t i = 0; i < nb * LOG_CODEC_SAMPLES; i++)
+    {
+        imu[i].head.time = random32();
+        for(uint32_t b = 0; b < sizeof(STRUCT_LOG_IMU_t); b++) ((uint8_t*)&imu[i].data)[b] = (uint8_t)random32();
+    }
+
+    start = now();
+    for(uint32_t round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for(uint32_t n = 0; n < nb; n++)
+        {
+            sink += log_codec_encode(&imu[n * LOG_CODEC_SAMPLES], LOG_CODEC_SAMPLES, encoded[n], sizeof(encoded[n]));
+        }
+    }
+    random_ns = (now() - start) / ((double)BENCH_ROUNDS * nb);
+
+    printf("imu block of %u : encode %.0f ns (%.1f ns per sample), incompressible %.0f ns, decode %.0f ns\n",
+           LOG_CODEC_SAMPLES, encode_ns, encode_ns / LOG_CODEC_SAMPLES, random_ns, decode_ns);
+    (void)sink;
+}
+
+/* ============================================================= ==
+   main
+== ============================================================= */
+int main(int argc, char** argv)
+{
+    if(argc > 1)
+    {
+        if(load(argv[1]) != 0) return EXIT_FAILURE;
+        printf("%s : %u imu and baro records\n", argv[1], trace_nb);
+    }
+    else
+    {
+        simulate();
+        printf("simulated flight : %u imu and baro records\n", trace_nb);
+    }
+
+    test_ratio(argc <= 1);
+    test_random();
+    if(trace_nb > 0u) bench();
+
+    printf("%s (%u failures)\n", failures == 0u ? "PASS" : "FAIL", failures);
+    return failures == 0u ? 0 : 1;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,305 @@
+/** ************************************************************* *
+ * @file        fsm_test.c
+ * @brief       Host test of the flight state machine (flight_fsm.c).
+ *              Every (phase, event) pair is dispatched with the
+ *              guards false and true and compared with the expected
+ *              transition table of this file, the guards are checked
+ *              at their bounds and across the wrap around of the
+ *              time, then the dispatch time is measured for every
+ *              pair.
+ * 
+ *              build (from this folder) :
+ *              cc -O2 -Wall -Wextra -I../../Components/Application/inc
+ *                  fsm_test.c ../../Components/Application/flight_fsm.c
+ *                  -o fsm_test
+ * 
+ *              usage :
+ *              fsm_test            -> exit code 0 when all the checks pass
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "flight_fsm.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* as flight_fsm.c */
+#define BOOST_TIME              3000u   /* [ms] */
+#define WINDOW_OUT_TIME         10000u  /* [ms] */
+#define LANDED_TIME             30000u  /* [ms] */
+#define LANDED_ALTITUDE         20.0f   /* [m] */
+
+#define BENCH_LOOPS             1000000u
+
+#define CHECK(cond)             check((cond), #cond, __LINE__)
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* expected result of a dispatch */
+typedef struct
+{
+    ENUM_FLIGHT_ACTION_t action;
+    ENUM_FLIGHT_PHASE_t next;
+}STRUCT_EXPECTED_t;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+#define NONE(phase)             {E_FLIGHT_ACT_NONE, phase}
+
+/* [phase][event][guards false, guards true] */
+static const STRUCT_EXPECTED_t expected[E_FLIGHT_NB][E_FLIGHT_EVT_NB][2] = {
+    [E_FLIGHT_IDLE] = {
+        [E_FLIGHT_EVT_ARM]     = {{E_FLIGHT_ACT_PHASE, E_FLIGHT_ARMED}, {E_FLIGHT_ACT_PHASE, E_FLIGHT_ARMED}},
+        [E_FLIGHT_EVT_DISARM]  = {NONE(E_FLIGHT_IDLE), NONE(E_FLIGHT_IDLE)},
+        [E_FLIGHT_EVT_LIFTOFF] = {NONE(E_FLIGHT_IDLE), NONE(E_FLIGHT_IDLE)},
+        [E_FLIGHT_EVT_TICK]    = {NONE(E_FLIGHT_IDLE), NONE(E_FLIGHT_IDLE)},
+    },
+    [E_FLIGHT_ARMED] = {
+        [E_FLIGHT_EVT_ARM]     = {NONE(E_FLIGHT_ARMED), NONE(E_FLIGHT_ARMED)},
+        [E_FLIGHT_EVT_DISARM]  = {{E_FLIGHT_ACT_PHASE, E_FLIGHT_IDLE}, {E_FLIGHT_ACT_PHASE, E_FLIGHT_IDLE}},
+        [E_FLIGHT_EVT_LIFTOFF] = {{E_FLIGHT_ACT_LIFTOFF, E_FLIGHT_BOOST}, {E_FLIGHT_ACT_LIFTOFF, E_FLIGHT_BOOST}},
+        [E_FLIGHT_EVT_TICK]    = {NONE(E_FLIGHT_ARMED), NONE(E_FLIGHT_ARMED)},
+    },
+    [E_FLIGHT_BOOST] = {
+        [E_FLIGHT_EVT_ARM]     = {NONE(E_FLIGHT_BOOST), NONE(E_FLIGHT_BOOST)},
+        [E_FLIGHT_EVT_DISARM]  = {NONE(E_FLIGHT_BOOST), NONE(E_FLIGHT_BOOST)},
+        [E_FLIGHT_EVT_LIFTOFF] = {NONE(E_FLIGHT_BOOST), NONE(E_FLIGHT_BOOST)},
+        [E_FLIGHT_EVT_TICK]    = {NONE(E_FLIGHT_BOOST), {E_FLIGHT_ACT_BURNOUT, E_FLIGHT_COAST}},
+    },
+    [E_FLIGHT_COAST] = {
+        [E_FLIGHT_EVT_ARM]     = {NONE(E_FLIGHT_COAST), NONE(E_FLIGHT_COAST)},
+        [E_FLIGHT_EVT_DISARM]  = {NONE(E_FLIGHT_COAST), NONE(E_FLIGHT_COAST)},
+        [E_FLIGHT_EVT_LIFTOFF] = {NONE(E_FLIGHT_COAST), NONE(E_FLIGHT_COAST)},
+        [E_FLIGHT_EVT_TICK]    = {NONE(E_FLIGHT_COAST), {E_FLIGHT_ACT_DEPLOY, E_FLIGHT_APOGEE}},
+    },
+    [E_FLIGHT_APOGEE] = {
+        [E_FLIGHT_EVT_ARM]     = {NONE(E_FLIGHT_APOGEE), NONE(E_FLIGHT_APOGEE)},
+        [E_FLIGHT_EVT_DISARM]  = {NONE(E_FLIGHT_APOGEE), NONE(E_FLIGHT_APOGEE)},
+        [E_FLIGHT_EVT_LIFTOFF] = {NONE(E_FLIGHT_APOGEE), NONE(E_FLIGHT_APOGEE)},
+        [E_FLIGHT_EVT_TICK]    = {{E_FLIGHT_ACT_DESCENT, E_FLIGHT_DESCENT}, {E_FLIGHT_ACT_DESCENT, E_FLIGHT_DESCENT}},
+    },
+    [E_FLIGHT_DESCENT] = {
+        [E_FLIGHT_EVT_ARM]     = {NONE(E_FLIGHT_DESCENT), NONE(E_FLIGHT_DESCENT)},
+        [E_FLIGHT_EVT_DISARM]  = {NONE(E_FLIGHT_DESCENT), NONE(E_FLIGHT_DESCENT)},
+        [E_FLIGHT_EVT_LIFTOFF] = {NONE(E_FLIGHT_DESCENT), NONE(E_FLIGHT_DESCENT)},
+        [E_FLIGHT_EVT_TICK]    = {NONE(E_FLIGHT_DESCENT), {E_FLIGHT_ACT_PHASE, E_FLIGHT_LANDED}},
+    },
+    [E_FLIGHT_LANDED] = {
+        [E_FLIGHT_EVT_ARM]     = {NONE(E_FLIGHT_LANDED), NONE(E_FLIGHT_LANDED)},
+        [E_FLIGHT_EVT_DISARM]  = {NONE(E_FLIGHT_LANDED), NONE(E_FLIGHT_LANDED)},
+        [E_FLIGHT_EVT_LIFTOFF] = {NONE(E_FLIGHT_LANDED), NONE(E_FLIGHT_LANDED)},
+        [E_FLIGHT_EVT_TICK]    = {NONE(E_FLIGHT_LANDED), NONE(E_FLIGHT_LANDED)},
+    },
+};
+
+static const char* const event_names[E_FLIGHT_EVT_NB] = {"ARM", "DISARM", "LIFTOFF", "TICK"};
+
+static uint32_t failures = 0;
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+static void check(bool cond, const char *text, int line)
+{
+    if(cond == true) return;
+
+    printf("FAIL line %d : %s\n", line, text);
+    failures++;
+}
+
+/* context of the guards : all false or all true for a phase entered
+ * (and a liftoff) at start */
+static STRUCT_FLIGHT_CTX_t context(uint32_t start, bool guards)
+{
+    STRUCT_FLIGHT_CTX_t ctx;
+
+    ctx.now      = guards ? start + LANDED_TIME + WINDOW_OUT_TIME : start;
+    ctx.altitude = guards ? 0.0f : 1000.0f;
+    ctx.apogee   = guards;
+
+    return ctx;
+}
+
+/* one step of a flight, the action and the phase */
+static bool step(STRUCT_FLIGHT_t *fsm, ENUM_FLIGHT_EVENT_t event, uint32_t now, float altitude, bool apogee,
+                 ENUM_FLIGHT_ACTION_t action, ENUM_FLIGHT_PHASE_t phase)
+{
+    STRUCT_FLIGHT_CTX_t ctx = {.now = now, .altitude = altitude, .apogee = apogee};
+
+    return flight_fsm_dispatch(fsm, event, &ctx) == action && fsm->phase == phase;
+}
+
+/* ============================================================= ==
+   tests
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       every (phase, event) pair, guards false and true :
+ *              action, next phase, entry time and liftoff time
+ * 
+ * ************************************************************* **/
+static void test_table(void)
+{
+    const uint32_t start = 1000u;
+    uint32_t errors = 0;
+
+    for(uint32_t p = 0; p < E_FLIGHT_NB; p++)
+    {
+        for(uint32_t e = 0; e < E_FLIGHT_EVT_NB; e++)
+        {
+            for(uint32_t g = 0; g < 2u; g++)
+            {
+                const STRUCT_EXPECTED_t *exp = &expected[p][e][g];
+                STRUCT_FLIGHT_CTX_t ctx = context(start, g != 0u);
+                STRUCT_FLIGHT_t fsm;
+                ENUM_FLIGHT_ACTION_t action;
+                bool moved = (exp->action != E_FLIGHT_ACT_NONE);
+
+                flight_fsm_init(&fsm, (ENUM_FLIGHT_PHASE_t)p, start);
+                action = flight_fsm_dispatch(&fsm, (ENUM_FLIGHT_EVENT_t)e, &ctx);
+
+                if(action != exp->action || fsm.phase != exp->next
+                || fsm.entered != (moved ? ctx.now : start)
+                || fsm.liftoff != ((moved && e == E_FLIGHT_EVT_LIFTOFF) ? ctx.now : start))
+                {
+                    printf("  %-7s + %-7s (guards %s) : action %d phase %s, expected %d %s\n",
+                           flight_fsm_name((ENUM_FLIGHT_PHASE_t)p), event_names[e], g ? "true" : "false",
+                           action, flight_fsm_name(fsm.phase), exp->action, flight_fsm_name(exp->next));
+                    errors++;
+                }
+            }
+        }
+    }
+    CHECK(errors == 0u);
+}
+
+/** ************************************************************* *
+ * @brief       the guards at their bounds, apogee before the end
+ *              of the window
+ * 
+ * ************************************************************* **/
+static void test_guards(void)
+{
+    STRUCT_FLIGHT_t fsm;
+
+    /* burnout */
+    flight_fsm_init(&fsm, E_FLIGHT_BOOST, 0u);
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, BOOST_TIME - 1u, 500.0f, true, E_FLIGHT_ACT_NONE, E_FLIGHT_BOOST));
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, BOOST_TIME, 500.0f, false, E_FLIGHT_ACT_BURNOUT, E_FLIGHT_COAST));
+
+    /* end of the window, from the liftoff (not from the burnout) */
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, WINDOW_OUT_TIME - 1u, 900.0f, false, E_FLIGHT_ACT_NONE, E_FLIGHT_COAST));
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, WINDOW_OUT_TIME, 900.0f, false, E_FLIGHT_ACT_DEPLOY_LATE, E_FLIGHT_APOGEE));
+
+    /* the vote wins over the window */
+    flight_fsm_init(&fsm, E_FLIGHT_COAST, 0u);
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, WINDOW_OUT_TIME, 900.0f, true, E_FLIGHT_ACT_DEPLOY, E_FLIGHT_APOGEE));
+
+    /* landing : time from the descent entry and altitude */
+    flight_fsm_init(&fsm, E_FLIGHT_DESCENT, 5000u);
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, 5000u + LANDED_TIME - 1u, 0.0f, false, E_FLIGHT_ACT_NONE, E_FLIGHT_DESCENT));
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, 5000u + LANDED_TIME, LANDED_ALTITUDE, false, E_FLIGHT_ACT_NONE, E_FLIGHT_DESCENT));
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, 5000u + LANDED_TIME, LANDED_ALTITUDE - 0.1f, false, E_FLIGHT_ACT_PHASE, E_FLIGHT_LANDED));
+
+    /* phase out of range */
+    fsm.phase = E_FLIGHT_NB;
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, 0u, 0.0f, true, E_FLIGHT_ACT_NONE, E_FLIGHT_NB));
+}
+
+/** ************************************************************* *
+ * @brief       a whole flight with the liftoff 2 s before the wrap
+ *              around of the time (49.7 days of uptime)
+ * 
+ * ************************************************************* **/
+static void test_flight_wrap(void)
+{
+    const uint32_t t0 = 0xFFFFFFFFu - 2000u;
+    STRUCT_FLIGHT_t fsm;
+
+    flight_fsm_init(&fsm, E_FLIGHT_IDLE, t0 - 60000u);
+    CHECK(step(&fsm, E_FLIGHT_EVT_ARM, t0 - 50000u, 0.0f, false, E_FLIGHT_ACT_PHASE, E_FLIGHT_ARMED));
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, t0 - 1u, 0.0f, true, E_FLIGHT_ACT_NONE, E_FLIGHT_ARMED));
+    CHECK(step(&fsm, E_FLIGHT_EVT_LIFTOFF, t0, 0.0f, false, E_FLIGHT_ACT_LIFTOFF, E_FLIGHT_BOOST));
+    CHECK(fsm.liftoff == t0);
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, t0 + 2000u, 200.0f, false, E_FLIGHT_ACT_NONE, E_FLIGHT_BOOST));
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, t0 + BOOST_TIME, 300.0f, false, E_FLIGHT_ACT_BURNOUT, E_FLIGHT_COAST));
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, t0 + 8000u, 900.0f, true, E_FLIGHT_ACT_DEPLOY, E_FLIGHT_APOGEE));
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, t0 + 8001u, 900.0f, false, E_FLIGHT_ACT_DESCENT, E_FLIGHT_DESCENT));
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, t0 + 20000u, 10.0f, false, E_FLIGHT_ACT_NONE, E_FLIGHT_DESCENT));
+    CHECK(step(&fsm, E_FLIGHT_EVT_TICK, t0 + 8001u + LANDED_TIME, 10.0f, false, E_FLIGHT_ACT_PHASE, E_FLIGHT_LANDED));
+    CHECK(step(&fsm, E_FLIGHT_EVT_ARM, t0 + 40000u, 0.0f, true, E_FLIGHT_ACT_NONE, E_FLIGHT_LANDED));
+}
+
+/** ************************************************************* *
+ * @brief       dispatch time of every (phase, event) pair, the
+ *              guards true (longest scan)
+ * 
+ * ************************************************************* **/
+static void bench(void)
+{
+    volatile uint32_t sink = 0;
+    double worst = 0.0;
+
+    printf("dispatch [ns]  ");
+    for(uint32_t e = 0; e < E_FLIGHT_EVT_NB; e++) printf("%8s", event_names[e]);
+    printf("\n");
+
+    for(uint32_t p = 0; p < E_FLIGHT_NB; p++)
+    {
+        printf("  %-12s ", flight_fsm_name((ENUM_FLIGHT_PHASE_t)p));
+        for(uint32_t e = 0; e < E_FLIGHT_EVT_NB; e++)
+        {
+            STRUCT_FLIGHT_CTX_t ctx = context(0u, true);
+            STRUCT_FLIGHT_t fsm;
+            struct timespec t0;
+            struct timespec t1;
+            double ns;
+
+            clock_gettime(CLOCK_MONOTONIC, &t0);
+            for(uint32_t n = 0; n < BENCH_LOOPS; n++)
+            {
+                flight_fsm_init(&fsm, (ENUM_FLIGHT_PHASE_t)p, 0u);
+                sink += flight_fsm_dispatch(&fsm, (ENUM_FLIGHT_EVENT_t)e, &ctx);
+            }
+            clock_gettime(CLOCK_MONOTONIC, &t1);
+
+            ns = ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / BENCH_LOOPS;
+            if(ns > worst) worst = ns;
+            printf("%8.1f", ns);
+        }
+        printf("\n");
+    }
+    printf("worst case     : %.1f ns (init included)\n", worst);
+    (void)sink;
+}
+
+/* ============================================================= ==
+   main
+== ============================================================= */
+int main(void)
+{
+    test_table();
+    test_guards();
+    test_flight_wrap();
+    bench();
+
+    printf("%s (%u failures)\n", failures == 0u ? "PASS" : "FAIL", failures);
+    return failures == 0u ? 0 : 1;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,517 @@
+/** ************************************************************* *
+ * @file        gnss_fuzz.c
+ * @brief       Host fuzz test of the GNSS parser (API_gnss.c, built
+ *              in this file on stubbed registers). The bytes are
+ *              written in the DMA ring by chunks of random size :
+ *              valid, truncated, bad checksum and oversized NMEA
+ *              sentences, UBX NAV-PVT, random bytes and overrun of
+ *              the ring. Then the parse time of a burst of the
+ *              receiver is measured.
+ * 
+ *              build (from this folder) :
+ *              cc -O2 -Wall -Wextra -Wno-unused-parameter
+ *                  -Wno-pointer-to-int-cast -Isim
+ *                  -I../../Components/GNSS/inc
+ *                  -I../../Components/Configuration gnss_fuzz.c
+ *                  -o gnss_fuzz
+ *              (add -g -fsanitize=address,undefined to check the
+ *              accesses of the fuzz)
+ * 
+ *              usage :
+ *              gnss_fuzz           -> exit code 0 when all the checks pass
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../Components/GNSS/API_gnss.c"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define FUZZ_SEED               0x4D533153u
+#define FUZZ_ROUNDS             20000u
+#define FUZZ_CHUNK_MAX          128u    /* [byte] bytes between two parses */
+
+#define BENCH_BURSTS            20000u
+
+#define CHECK(cond)             check((cond), #cond, __LINE__)
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+/* stubbed registers */
+SIM_RCC_t sim_rcc;
+SIM_GPIO_t sim_gpioc;
+SIM_GPIO_t sim_gpiod;
+SIM_DMA_t sim_dma1;
+SIM_DMA_STREAM_t sim_dma1_stream0;
+SIM_USART_t sim_uart5;
+
+/* mailbox of the fix */
+static STRUCT_GNSS_GPS_t sim_gps;
+static bool sim_gps_full = false;
+static uint32_t sim_published = 0;
+
+static uint32_t sim_head = 0;           /* free running index of the DMA */
+static uint32_t seed = FUZZ_SEED;
+
+static uint32_t failures = 0;
+
+/* sentences of a burst of the receiver (u-blox NEO-M8, 1 Hz) */
+static const char *burst[] = {
+    "GPRMC,123519.00,A,4807.03800,N,01131.00000,E,22.4,84.4,230394,,,A",
+    "GPVTG,84.4,T,,M,22.4,N,41.5,K,A",
+    "GPGGA,123519.00,4807.03800,N,01131.00000,E,1,08,0.90,545.4,M,46.9,M,,",
+    "GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1",
+    "GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45",
+    "GPGLL,4807.03800,N,01131.00000,E,123519.00,A,A",
+};
+
+/* ============================================================= ==
+   host stubs
+== ============================================================= */
+TickType_t xTaskGetTickCount(void) { return 0u; }
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait) { (void)clear; (void)wait; return 0u; }
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken) { (void)task; (void)woken; }
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack, void* parameters, uint32_t priority, TaskHandle_t* handle)
+{
+    (void)function; (void)name; (void)stack; (void)parameters; (void)priority;
+    *handle = NULL;
+    return pdPASS;
+}
+
+QueueHandle_t xQueueCreate(uint32_t length, uint32_t size)
+{
+    (void)length; (void)size;
+    return &sim_gps;
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item)
+{
+    (void)queue;
+    memcpy(&sim_gps, item, sizeof(sim_gps));
+    sim_gps_full = true;
+    sim_published++;
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t wait)
+{
+    (void)queue; (void)wait;
+    if(sim_gps_full == false) return pdFALSE;
+
+    memcpy(item, &sim_gps, sizeof(sim_gps));
+    sim_gps_full = false;
+    return pdTRUE;
+}
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+static void check(bool cond, const char *text, int line)
+{
+    if(cond == true) return;
+
+    printf("FAIL line %d : %s\n", line, text);
+    failures++;
+}
+
+/* xorshift32 */
+static uint32_t random32(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+/* write the bytes in the ring as the DMA, the parser runs after each
+ * chunk (the wake up of the task) */
+static void feed(const uint8_t *data, uint32_t len, uint32_t chunk_max)
+{
+    while(len > 0u)
+    {
+        uint32_t chunk = 1u + random32() % chunk_max;
+
+        if(chunk > len) chunk = len;
+        for(uint32_t i = 0; i < chunk; i++) RING(sim_head++) = data[i];
+
+        parse(sim_head);
+        data += chunk;
+        len  -= chunk;
+    }
+}
+
+/* "$body*hh\r\n", returns the length */
+static uint32_t sentence(char *out, const char *body, bool corrupt)
+{
+    uint8_t cksum = 0;
+
+    for(const char *c = body; *c != '\0'; c++) cksum ^= (uint8_t)*c;
+    if(corrupt == true) cksum ^= 0x5Au;
+
+    return (uint32_t)sprintf(out, "$%s*%02X\r\n", body, cksum);
+}
+
+static void feed_sentence(const char *body, bool corrupt)
+{
+    char text[256];
+    uint32_t len = sentence(text, body, corrupt);
+
+    feed((const uint8_t*)text, len, FUZZ_CHUNK_MAX);
+}
+
+static bool get_fix(STRUCT_GNSS_GPS_t *gps)
+{
+    return API_GNSS_GET_GPS(gps);
+}
+
+static void reset(void)
+{
+    memset(&gnss_gps, 0, sizeof(gnss_gps));
+    memset(&gnss_stats, 0, sizeof(gnss_stats));
+    gnss_tail = sim_head;
+    sim_gps_full = false;
+}
+
+/* UBX NAV-PVT : 3D fix, 12 satellites */
+static uint32_t nav_pvt(uint8_t *out, bool corrupt)
+{
+    uint8_t *payload = &out[6];
+    uint8_t ck_a = 0;
+    uint8_t ck_b = 0;
+
+    memset(out, 0, GNSS_UBX_NAV_PVT_LEN + 8u);
+    out[0] = GNSS_UBX_SYNC1;
+    out[1] = GNSS_UBX_SYNC2;
+    out[2] = 0x01u;
+    out[3] = 0x07u;
+    out[4] = GNSS_UBX_NAV_PVT_LEN;
+
+    payload[8]  = 12u;                  /* 12:35:19 */
+    payload[9]  = 35u;
+    payload[10] = 19u;
+    payload[20] = 3u;
+    payload[21] = 0x01u;
+    payload[23] = 12u;
+    memcpy(&payload[24], &(int32_t){ 115166667}, 4);
+    memcpy(&payload[28], &(int32_t){ 481173000}, 4);
+    memcpy(&payload[36], &(int32_t){ 545400}, 4);
+
+    for(uint32_t i = 2; i < GNSS_UBX_NAV_PVT_LEN + 6u; i++)
+    {
+        ck_a += out[i];
+        ck_b += ck_a;
+    }
+    out[GNSS_UBX_NAV_PVT_LEN + 6u] = ck_a;
+    out[GNSS_UBX_NAV_PVT_LEN + 7u] = corrupt ? (uint8_t)~ck_b : ck_b;
+
+    return GNSS_UBX_NAV_PVT_LEN + 8u;
+}
+
+/* ============================================================= ==
+   tests
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       burst of the receiver : GGA published with the speed
+ *              of the RMC, the other types ignored
+ * 
+ * ************************************************************* **/
+static void test_valid(void)
+{
+    STRUCT_GNSS_GPS_t gps;
+
+    reset();
+    for(uint32_t i = 0; i < sizeof(burst) / sizeof(burst[0]); i++) feed_sentence(burst[i], false);
+
+    CHECK(get_fix(&gps) == true);
+    CHECK(gps.fix == E_GNSS_FIX_3D);
+    CHECK(gps.sats == 8u);
+    CHECK(gps.hdop == 90u);
+    CHECK(gps.time == 45319000u);
+    CHECK(gps.lat == 481173000);
+    CHECK(gps.lon == 115166666);
+    CHECK(gps.alt == 545400);
+    CHECK(gps.speed == 11523u);
+    CHECK(gnss_stats.nmea == 2u);
+    CHECK(gnss_stats.ignored == 4u);
+    CHECK(gnss_stats.errors == 0u);
+    CHECK(gnss_tail == sim_head);
+}
+
+/** ************************************************************* *
+ * @brief       RMC with the warning status : the speed is not used
+ * 
+ * ************************************************************* **/
+static void test_rmc_warning(void)
+{
+    STRUCT_GNSS_GPS_t gps;
+
+    reset();
+    feed_sentence(burst[0], false);
+    feed_sentence("GPRMC,123520.00,V,,,,,50.0,,230394,,,N", false);
+    feed_sentence(burst[2], false);
+
+    CHECK(get_fix(&gps) == true);
+    CHECK(gps.speed == 11523u);
+    CHECK(gnss_stats.errors == 0u);
+}
+
+/** ************************************************************* *
+ * @brief       bad checksum : no fix, an error
+ * 
+ * ************************************************************* **/
+static void test_checksum(void)
+{
+    STRUCT_GNSS_GPS_t gps;
+
+    reset();
+    feed_sentence(burst[2], true);
+    CHECK(get_fix(&gps) == false);
+    CHECK(gnss_stats.errors == 1u);
+
+    /* checksum digits missing or not hexadecimal */
+    feed((const uint8_t*)"$GPGGA,1*\r\n", 11u, FUZZ_CHUNK_MAX);
+    feed((const uint8_t*)"$GPGGA,1*G0\r\n", 13u, FUZZ_CHUNK_MAX);
+    CHECK(get_fix(&gps) == false);
+    CHECK(gnss_stats.errors == 3u);
+}
+
+/** ************************************************************* *
+ * @brief       a sentence cut at every length, followed by a valid
+ *              one : the valid one is always decoded
+ * 
+ * ************************************************************* **/
+static void test_truncated(void)
+{
+    STRUCT_GNSS_GPS_t gps;
+    char text[256];
+    uint32_t len = sentence(text, burst[2], false);
+    uint32_t lost = 0;
+
+    for(uint32_t cut = 1; cut < len - 2u; cut++)
+    {
+        reset();
+        feed((const uint8_t*)text, cut, FUZZ_CHUNK_MAX);
+        feed_sentence(burst[2], false);
+
+        if(get_fix(&gps) == false || gps.lat != 481173000) lost++;
+        if(gnss_tail != sim_head) lost++;
+    }
+    CHECK(lost == 0u);
+}
+
+/** ************************************************************* *
+ * @brief       oversized : no line end within GNSS_NMEA_MAX bytes,
+ *              and a field with too many digits (saturated)
+ * 
+ * ************************************************************* **/
+static void test_oversized(void)
+{
+    STRUCT_GNSS_GPS_t gps;
+    char body[256];
+
+    reset();
+    strcpy(body, "GPGGA,");
+    memset(&body[6], '1', 120u);
+    body[126] = '\0';
+    feed_sentence(body, false);
+    feed_sentence(burst[2], false);
+    CHECK(gnss_stats.errors == 1u);
+    CHECK(get_fix(&gps) == true);
+    CHECK(gps.alt == 545400);
+
+    reset();
+    feed_sentence("GPGGA,123519.00,4807.03800,N,01131.00000,E,1,08,0.90,99999999999999999999", false);
+    CHECK(get_fix(&gps) == true);
+    CHECK(gps.alt == INT32_MAX);
+}
+
+/** ************************************************************* *
+ * @brief       UBX NAV-PVT valid and corrupted
+ * 
+ * ************************************************************* **/
+static void test_ubx(void)
+{
+    STRUCT_GNSS_GPS_t gps;
+    uint8_t msg[GNSS_UBX_NAV_PVT_LEN + 8u];
+    uint32_t len;
+
+    reset();
+    len = nav_pvt(msg, true);
+    feed(msg, len, FUZZ_CHUNK_MAX);
+    CHECK(get_fix(&gps) == false);
+
+    len = nav_pvt(msg, false);
+    feed(msg, len, FUZZ_CHUNK_MAX);
+    CHECK(get_fix(&gps) == true);
+    CHECK(gps.fix == E_GNSS_FIX_3D);
+    CHECK(gps.sats == 12u);
+    CHECK(gps.lat == 481173000);
+    CHECK(gps.time == 45319000u);
+    CHECK(gnss_stats.ubx == 1u);
+    CHECK(gnss_tail == sim_head);
+}
+
+/** ************************************************************* *
+ * @brief       random mix of valid, corrupted, truncated sentences
+ *              and random bytes : every valid sentence which
+ *              follows a line end is decoded, the parser never
+ *              stays behind the DMA
+ * 
+ * ************************************************************* **/
+static void test_fuzz(void)
+{
+    STRUCT_GNSS_GPS_t gps;
+    uint8_t noise[64];
+    char text[256];
+    uint32_t len;
+    uint32_t lost = 0;
+
+    reset();
+    for(uint32_t round = 0; round < FUZZ_ROUNDS; round++)
+    {
+        switch(random32() % 5u)
+        {
+        case 0: /* random bytes */
+            len = random32() % sizeof(noise);
+            for(uint32_t i = 0; i < len; i++) noise[i] = (uint8_t)random32();
+            feed(noise, len, FUZZ_CHUNK_MAX);
+            break;
+
+        case 1: /* truncated */
+            len = sentence(text, burst[random32() % 6u], false);
+            feed((const uint8_t*)text, random32() % len, FUZZ_CHUNK_MAX);
+            break;
+
+        case 2: /* bit flip */
+            len = sentence(text, burst[random32() % 6u], false);
+            text[1u + random32() % (len - 1u)] ^= (char)(1u << (random32() % 8u));
+            feed((const uint8_t*)text, len, FUZZ_CHUNK_MAX);
+            break;
+
+        case 3: /* UBX */
+            len = nav_pvt((uint8_t*)text, (random32() & 1u) != 0u);
+            feed((const uint8_t*)text, len, FUZZ_CHUNK_MAX);
+            break;
+
+        default: /* valid */
+            feed_sentence(burst[random32() % 6u], false);
+            break;
+        }
+
+        /* resynchronisation : a line end then a fix */
+        if((round & 63u) == 63u)
+        {
+            sim_gps_full = false;
+            feed((const uint8_t*)"\r\n", 2u, FUZZ_CHUNK_MAX);
+            feed_sentence(burst[2], false);
+            if(get_fix(&gps) == false || gps.alt != 545400) lost++;
+        }
+        if(sim_head - gnss_tail > GNSS_RING_SIZE) lost++;
+    }
+    CHECK(lost == 0u);
+    CHECK(gnss_stats.errors > 0u);
+}
+
+/** ************************************************************* *
+ * @brief       the task is late by more than a turn of the ring :
+ *              the overwritten bytes are skipped
+ * 
+ * ************************************************************* **/
+static void test_overrun(void)
+{
+    STRUCT_GNSS_GPS_t gps;
+    uint8_t msg[GNSS_UBX_NAV_PVT_LEN + 8u];
+    uint8_t noise[GNSS_RING_SIZE];
+    uint32_t len;
+
+    reset();
+
+    /* first half of a UBX frame, parser waiting */
+    len = nav_pvt(msg, false);
+    feed(msg, len / 2u, FUZZ_CHUNK_MAX);
+    CHECK(gnss_tail != sim_head);
+
+    /* more than a turn of the ring without parse */
+    for(uint32_t i = 0; i < sizeof(noise); i++) noise[i] = (uint8_t)(' ' + random32() % 64u);
+    for(uint32_t i = 0; i < sizeof(noise); i++) RING(sim_head++) = noise[i];
+    parse(sim_head);
+    CHECK(sim_head - gnss_tail <= GNSS_NMEA_MAX);
+    CHECK(gnss_stats.skipped >= len / 2u);
+
+    feed((const uint8_t*)"\r\n", 2u, FUZZ_CHUNK_MAX);
+    feed_sentence(burst[2], false);
+    CHECK(get_fix(&gps) == true);
+}
+
+/** ************************************************************* *
+ * @brief       parse time of a burst of the receiver, parsed at
+ *              once (idle line)
+ * 
+ * ************************************************************* **/
+static void bench(void)
+{
+    STRUCT_GNSS_GPS_t gps;
+    char text[1024];
+    uint32_t len = 0;
+    struct timespec t0;
+    struct timespec t1;
+    double ns;
+
+    for(uint32_t i = 0; i < sizeof(burst) / sizeof(burst[0]); i++) len += sentence(&text[len], burst[i], false);
+
+    reset();
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for(uint32_t n = 0; n < BENCH_BURSTS; n++)
+    {
+        for(uint32_t i = 0; i < len; i++) RING(sim_head + i) = (uint8_t)text[i];
+        sim_head += len;
+        parse(sim_head);
+        (void)get_fix(&gps);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    ns = (double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec);
+
+    CHECK(gnss_stats.nmea == 2u * BENCH_BURSTS);
+    printf("burst of %u bytes : %.0f ns (%.2f ns/byte, copy included)\n",
+           len, ns / BENCH_BURSTS, ns / ((double)BENCH_BURSTS * len));
+}
+
+/* ============================================================= ==
+   main
+== ============================================================= */
+int main(void)
+{
+    API_GNSS_START();
+
+    test_valid();
+    test_rmc_warning();
+    test_checksum();
+    test_truncated();
+    test_oversized();
+    test_ubx();
+    test_fuzz();
+    test_overrun();
+    bench();
+
+    printf("%s (%u failures)\n", failures == 0u ? "PASS" : "FAIL", failures);
+    return failures == 0u ? 0 : 1;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,46 @@
+/** ************************************************************* *
+ * @file        FreeRTOS.h
+ * @brief       Host stub of the gnss_fuzz : no scheduler, the
+ *              parser of API_gnss.c is called by the test.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef GNSS_FUZZ_FREERTOS_H_
+#define GNSS_FUZZ_FREERTOS_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define configASSERT(x)                     assert(x)
+#define configMINIMAL_STACK_SIZE            128u
+
+#define pdFALSE                             0
+#define pdTRUE                              1
+#define pdPASS                              1
+#define pdMS_TO_TICKS(ms)                   ((TickType_t)(ms))
+
+#define portYIELD_FROM_ISR(x)               (void)(x)
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* GNSS_FUZZ_FREERTOS_H_ */
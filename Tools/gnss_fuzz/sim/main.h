@@ -0,0 +1,89 @@
+/** ************************************************************* *
+ * @file        main.h
+ * @brief       Host stub of the gnss_fuzz : the registers used by
+ *              API_gnss.c are plain variables of the test.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef GNSS_FUZZ_MAIN_H_
+#define GNSS_FUZZ_MAIN_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include <stdint.h>
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+typedef struct { volatile uint32_t AHB1ENR, APB1ENR; } SIM_RCC_t;
+typedef struct { volatile uint32_t MODER, PUPDR, AFR[2]; } SIM_GPIO_t;
+typedef struct { volatile uint32_t LISR, LIFCR; } SIM_DMA_t;
+typedef struct { volatile uint32_t CR, NDTR, PAR, M0AR, FCR; } SIM_DMA_STREAM_t;
+typedef struct { volatile uint32_t CR1, CR3, BRR, ISR, ICR, RDR; } SIM_USART_t;
+
+typedef enum { UART5_IRQn, DMA1_Stream0_IRQn } IRQn_Type;
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define RCC                     (&sim_rcc)
+#define GPIOC                   (&sim_gpioc)
+#define GPIOD                   (&sim_gpiod)
+#define DMA1                    (&sim_dma1)
+#define DMA1_Stream0            (&sim_dma1_stream0)
+#define UART5                   (&sim_uart5)
+
+#define RCC_AHB1ENR_GPIOCEN     (1u << 2)
+#define RCC_AHB1ENR_GPIODEN     (1u << 3)
+#define RCC_AHB1ENR_DMA1EN      (1u << 21)
+#define RCC_APB1ENR_UART5EN     (1u << 20)
+
+#define DMA_SxCR_EN             (1u << 0)
+#define DMA_SxCR_HTIE           (1u << 3)
+#define DMA_SxCR_TCIE           (1u << 4)
+#define DMA_SxCR_CIRC           (1u << 8)
+#define DMA_SxCR_MINC           (1u << 10)
+#define DMA_SxCR_CHSEL_Pos      25u
+
+#define DMA_LISR_HTIF0          (1u << 4)
+#define DMA_LISR_TCIF0          (1u << 5)
+#define DMA_LIFCR_CFEIF0        (1u << 0)
+#define DMA_LIFCR_CDMEIF0       (1u << 2)
+#define DMA_LIFCR_CTEIF0        (1u << 3)
+#define DMA_LIFCR_CHTIF0        (1u << 4)
+#define DMA_LIFCR_CTCIF0        (1u << 5)
+
+#define USART_CR1_UE            (1u << 0)
+#define USART_CR1_RE            (1u << 2)
+#define USART_CR1_TE            (1u << 3)
+#define USART_CR1_IDLEIE        (1u << 4)
+#define USART_CR3_DMAR          (1u << 6)
+#define USART_ISR_ORE           (1u << 3)
+#define USART_ISR_IDLE          (1u << 4)
+#define USART_ICR_ORECF         (1u << 3)
+#define USART_ICR_IDLECF        (1u << 4)
+
+#define HAL_NVIC_SetPriority(irq, pre, sub)     ((void)(irq), (void)(pre), (void)(sub))
+#define HAL_NVIC_EnableIRQ(irq)                 ((void)(irq))
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+extern SIM_RCC_t sim_rcc;
+extern SIM_GPIO_t sim_gpioc;
+extern SIM_GPIO_t sim_gpiod;
+extern SIM_DMA_t sim_dma1;
+extern SIM_DMA_STREAM_t sim_dma1_stream0;
+extern SIM_USART_t sim_uart5;
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* GNSS_FUZZ_MAIN_H_ */
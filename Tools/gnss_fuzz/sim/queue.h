@@ -0,0 +1,37 @@
+/** ************************************************************* *
+ * @file        queue.h
+ * @brief       Host stub of the gnss_fuzz : the mailbox of the
+ *              fix, implemented by the test.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef GNSS_FUZZ_QUEUE_H_
+#define GNSS_FUZZ_QUEUE_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "FreeRTOS.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+typedef void* QueueHandle_t;
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+QueueHandle_t xQueueCreate(uint32_t length, uint32_t size);
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t wait);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* GNSS_FUZZ_QUEUE_H_ */
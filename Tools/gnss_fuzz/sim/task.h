@@ -0,0 +1,45 @@
+/** ************************************************************* *
+ * @file        task.h
+ * @brief       Host stub of the gnss_fuzz, see FreeRTOS.h
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef GNSS_FUZZ_TASK_H_
+#define GNSS_FUZZ_TASK_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "FreeRTOS.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* one task : nothing to protect */
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+TickType_t xTaskGetTickCount(void);
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack, void* parameters, uint32_t priority, TaskHandle_t* handle);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* GNSS_FUZZ_TASK_H_ */
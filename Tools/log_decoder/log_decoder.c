@@ -0,0 +1,347 @@
+/** ************************************************************* *
+ * @file        log_decoder.c
+ * @brief       Host decoder of the flight log dumped by the
+ *              datalogger (HMI_ID_LOG_DUMP). The image is mapped
+ *              in memory and decoded in one pass, without any
+ *              allocation per record. One CSV file per record type.
+ * 
+ *              The input is the raw log : the ground station
+ *              writes each chunk of the dump at its offset.
+ * 
+ *              build (from this folder) :
+ *              cc -O2 -I../../Components/Datalogger/inc -I../../Components/Application/inc
+ *                  log_decoder.c ../../Components/Datalogger/log_page.c
+ *                  ../../Components/Datalogger/log_codec.c
+ *                  ../../Components/Application/flight_fsm.c -o log_decoder
+ * 
+ *              usage :
+ *              log_decoder <image> [prefix]
+ *              -> prefix_imu.csv, prefix_baro.csv, prefix_phase.csv,
+ *                 prefix_boot.csv, prefix_latency.csv
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "log_format.h"
+#include "log_page.h"
+#include "log_codec.h"
+#include "flight_fsm.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define DECODER_PATH_SIZE           512u
+#define DECODER_BUFFER_SIZE         (1u << 20)  /* [byte] stdio buffer of each output */
+
+/* same scales as the application */
+#define DECODER_ANGLE               100.0       /* [0.01 deg / deg] */
+#define DECODER_ALTITUDE            100.0       /* [cm / m] */
+#define DECODER_TEMP                100.0       /* [0.01 degC / degC] */
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* one output per record type */
+typedef struct
+{
+    const char* name;
+    const char* header;
+    FILE* file;
+    unsigned long records;
+}STRUCT_DECODER_OUT_t;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+static STRUCT_DECODER_OUT_t out_imu   = {.name = "imu",   .header = "time_ms,ax,ay,az,gx,gy,gz,angle_x_deg,angle_y_deg"};
+static STRUCT_DECODER_OUT_t out_baro  = {.name = "baro",  .header = "time_ms,pressure_pa,altitude_m,temperature_c"};
+static STRUCT_DECODER_OUT_t out_phase = {.name = "phase", .header = "time_ms,phase,name"};
+static STRUCT_DECODER_OUT_t out_boot  = {.name = "boot",  .header = "time_ms,seq,reset"};
+static STRUCT_DECODER_OUT_t out_latency = {.name = "latency", .header = "time_ms,point,count,last_us,max_us"};
+
+/* gain of the codec */
+static unsigned long packed_raw = 0;        /* [byte] records before the compression */
+static unsigned long packed_bytes = 0;      /* [byte] blocks */
+
+/* ------------------------------------------------------------- --
+   prototypes
+-- ------------------------------------------------------------- */
+static int open_out(STRUCT_DECODER_OUT_t* out, const char* prefix);
+static void close_out(STRUCT_DECODER_OUT_t* out);
+static int decode_record(const STRUCT_LOG_HEAD_t* head, const uint8_t* data, uint32_t seq);
+static int decode_page(const uint8_t* page);
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       create the CSV file of a record type
+ * 
+ * @param       out 
+ * @param       prefix 
+ * @return      int     0 ok, -1 error 
+ * ************************************************************* **/
+static int open_out(STRUCT_DECODER_OUT_t* out, const char* prefix)
+{
+    char path[DECODER_PATH_SIZE];
+
+    snprintf(path, sizeof(path), "%s_%s.csv", prefix, out->name);
+    out->file = fopen(path, "w");
+    if(out->file == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+
+    setvbuf(out->file, NULL, _IOFBF, DECODER_BUFFER_SIZE);
+    fprintf(out->file, "%s\n", out->header);
+    return 0;
+}
+
+/** ************************************************************* *
+ * @brief       close the CSV file of a record type
+ * 
+ * @param       out 
+ * ************************************************************* **/
+static void close_out(STRUCT_DECODER_OUT_t* out)
+{
+    if(out->file != NULL) fclose(out->file);
+    out->file = NULL;
+}
+
+/** ************************************************************* *
+ * @brief       write a record in the CSV file of its type
+ * 
+ * @param       head 
+ * @param       data    payload, head->size bytes 
+ * @param       seq     sequence number of the page 
+ * @return      int     0 ok, -1 corrupted record 
+ * ************************************************************* **/
+static int decode_record(const STRUCT_LOG_HEAD_t* head, const uint8_t* data, uint32_t seq)
+{
+    switch(head->type)
+    {
+        case E_LOG_REC_IMU :
+        {
+            STRUCT_LOG_IMU_t rec;
+            if(head->size != sizeof(rec)) return -1;
+            memcpy(&rec, data, sizeof(rec));
+
+            fprintf(out_imu.file, "%u,%d,%d,%d,%d,%d,%d,%.2f,%.2f\n", head->time,
+                    rec.accel[0], rec.accel[1], rec.accel[2], rec.gyro[0], rec.gyro[1], rec.gyro[2],
+                    rec.angle_x / DECODER_ANGLE, rec.angle_y / DECODER_ANGLE);
+            out_imu.records++;
+        }
+        break;
+
+        case E_LOG_REC_BARO :
+        {
+            STRUCT_LOG_BARO_t rec;
+            if(head->size != sizeof(rec)) return -1;
+            memcpy(&rec, data, sizeof(rec));
+
+            fprintf(out_baro.file, "%u,%d,%.2f,%.2f\n", head->time,
+                    rec.pressure, rec.altitude / DECODER_ALTITUDE, rec.temperature / DECODER_TEMP);
+            out_baro.records++;
+        }
+        break;
+
+        case E_LOG_REC_PHASE :
+        {
+            STRUCT_LOG_PHASE_t rec;
+            if(head->size != sizeof(rec)) return -1;
+            memcpy(&rec, data, sizeof(rec));
+
+            fprintf(out_phase.file, "%u,%u,%s\n", head->time, rec.phase,
+                    (rec.phase < E_FLIGHT_NB) ? flight_fsm_name((ENUM_FLIGHT_PHASE_t)rec.phase) : "?");
+            out_phase.records++;
+        }
+        break;
+
+        case E_LOG_REC_BOOT :
+        {
+            STRUCT_LOG_BOOT_t rec;
+            if(head->size != sizeof(rec)) return -1;
+            memcpy(&rec, data, sizeof(rec));
+
+            fprintf(out_boot.file, "%u,%u,0x%08X\n", head->time, seq, rec.reset);
+            out_boot.records++;
+        }
+        break;
+
+        case E_LOG_REC_LATENCY :
+        {
+            STRUCT_LOG_LATENCY_t rec;
+            if(head->size != sizeof(rec)) return -1;
+            memcpy(&rec, data, sizeof(rec));
+
+            fprintf(out_latency.file, "%u,%u,%u,%u,%u\n", head->time, rec.point, rec.count, rec.last, rec.max);
+            out_latency.records++;
+        }
+        break;
+
+        /* block of imu or baro records, decoded on the stack */
+        case E_LOG_REC_PACK :
+        {
+            STRUCT_LOG_RECORD_t samples[LOG_CODEC_SAMPLES];
+            uint32_t nb = log_codec_decode(data, head->size, head->time, samples, LOG_CODEC_SAMPLES);
+
+            if(nb == 0u) return -1;
+            for(uint32_t i = 0; i < nb; i++)
+            {
+                if(decode_record(&samples[i].head, (const uint8_t*)&samples[i].data, seq) != 0) return -1;
+                packed_raw += sizeof(STRUCT_LOG_HEAD_t) + samples[i].head.size;
+            }
+            packed_bytes += sizeof(STRUCT_LOG_HEAD_t) + head->size;
+        }
+        break;
+
+        /* unknown record of a newer firmware : skipped */
+        default : break;
+    }
+
+    return 0;
+}
+
+/** ************************************************************* *
+ * @brief       decode the records of a valid page. The records are
+ *              read with memcpy : the image is mapped at any address.
+ * 
+ * @param       page    LOG_PAGE_SIZE bytes 
+ * @return      int     0 ok, -1 corrupted record (rest of the 
+ *                      page ignored)
+ * ************************************************************* **/
+static int decode_page(const uint8_t* page)
+{
+    STRUCT_LOG_PAGE_HEAD_t page_head;
+    uint32_t pos = 0;
+
+    memcpy(&page_head, page, sizeof(page_head));
+    page += sizeof(page_head);
+
+    while(pos + sizeof(STRUCT_LOG_HEAD_t) <= page_head.used)
+    {
+        STRUCT_LOG_HEAD_t head;
+
+        memcpy(&head, &page[pos], sizeof(head));
+        if(head.type == E_LOG_REC_END) return 0;
+        if(pos + sizeof(head) + head.size > page_head.used) return -1;
+
+        if(decode_record(&head, &page[pos + sizeof(head)], page_head.seq) != 0) return -1;
+        pos += sizeof(head) + head.size;
+    }
+
+    return 0;
+}
+
+/* ============================================================= ==
+   main
+== ============================================================= */
+int main(int argc, char** argv)
+{
+    const char* prefix = (argc > 2) ? argv[2] : "log";
+    unsigned long pages = 0;
+    unsigned long corrupted = 0;
+    unsigned long torn = 0;
+    struct timespec start, end;
+    struct stat st;
+    const uint8_t* image;
+    int fd;
+
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage : %s <image> [prefix]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    fd = open(argv[1], O_RDONLY);
+    if(fd < 0 || fstat(fd, &st) != 0)
+    {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+    if(st.st_size == 0)
+    {
+        fprintf(stderr, "%s : empty log\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    image = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(image == MAP_FAILED)
+    {
+        perror("mmap");
+        return EXIT_FAILURE;
+    }
+    madvise((void*)image, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    if(open_out(&out_imu, prefix) != 0 || open_out(&out_baro, prefix) != 0 || open_out(&out_phase, prefix) != 0
+    || open_out(&out_boot, prefix) != 0 || open_out(&out_latency, prefix) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    /* the log ends at the end of the image (or a truncated page). A
+     * page torn by a power cut is followed by the next boot, the
+     * erased pages of a sector damaged by a cut erase are skipped */
+    for(off_t offset = 0; offset + (off_t)LOG_PAGE_SIZE <= st.st_size; offset += LOG_PAGE_SIZE)
+    {
+        const uint8_t* page = &image[offset];
+        ENUM_LOG_PAGE_t state = log_page_check(page);
+
+        if(state == E_LOG_PAGE_ERASED) continue;
+        pages++;
+
+        switch(state)
+        {
+            case E_LOG_PAGE_VALID :
+                if(decode_page(page) != 0) corrupted++;
+            break;
+
+            case E_LOG_PAGE_TORN :      torn++;         break;
+            default :                   corrupted++;    break;
+        }
+    }
+
+    close_out(&out_imu);
+    close_out(&out_baro);
+    close_out(&out_phase);
+    close_out(&out_boot);
+    close_out(&out_latency);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    fprintf(stderr, "%lu pages (%lu torn, %lu corrupted) : %lu imu, %lu baro, %lu phase, %lu boot, %lu latency in %.3f s\n",
+            pages, torn, corrupted, out_imu.records, out_baro.records, out_phase.records, out_boot.records, out_latency.records,
+            (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9);
+    if(packed_bytes > 0u)
+    {
+        fprintf(stderr, "compression : %lu bytes of records in %lu bytes of blocks (x%.2f)\n",
+                packed_raw, packed_bytes, (double)packed_raw / (double)packed_bytes);
+    }
+
+    munmap((void*)image, (size_t)st.st_size);
+    close(fd);
+    return (corrupted == 0u) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
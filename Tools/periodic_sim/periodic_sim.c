@@ -0,0 +1,272 @@
+/** ************************************************************* *
+ * @file        periodic_sim.c
+ * @brief       Host test of the periodic tasks (API_periodic) on a
+ *              simulated kernel : nominal load, overload and
+ *              recovery, wake up jitter, early wake up by a
+ *              notification. Checks the histograms, the deadline
+ *              misses and the fault event.
+ * 
+ *              build (from this folder) :
+ *              cc -O2 -Wall -Wextra -Isim -I../../Components/Periodic/inc
+ *                  -I../../Components/Configuration periodic_sim.c
+ *                  ../../Components/Periodic/API_periodic.c -o periodic_sim
+ * 
+ *              usage :
+ *              periodic_sim        -> exit code 0 when all the checks pass
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "API_periodic.h"
+#include "MS1_config.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define SIM_CYCLES_PER_US       (SystemCoreClock / 1000000u)
+#define SIM_CYCLES_PER_TICK     (SystemCoreClock / configTICK_RATE_HZ)
+
+#define CHECK(cond)             check((cond), #cond, __LINE__)
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+/* simulated time, the tick is derived from the cycle counter */
+uint32_t SystemCoreClock = 48000000u;
+uint32_t sim_cycles = 0;
+
+static uint32_t sim_wake_delay = 0;     /* [cycle] latency of the wake up */
+static TickType_t sim_notify_at = 0;    /* tick of the next notification, 0 : none */
+
+static uint32_t fault_count = 0;
+static ENUM_PERIODIC_ID_t fault_id = E_PERIODIC_NB;
+
+static uint32_t failures = 0;
+
+/* ============================================================= ==
+   simulated kernel
+== ============================================================= */
+TickType_t xTaskGetTickCount(void)
+{
+    return sim_cycles / SIM_CYCLES_PER_TICK;
+}
+
+/* as FreeRTOS : no delay when the wake time is not in the future */
+BaseType_t xTaskDelayUntil(TickType_t *previous, TickType_t increment)
+{
+    TickType_t wake = *previous + increment;
+
+    *previous = wake;
+    if((int32_t)(wake - xTaskGetTickCount()) <= 0) return pdFALSE;
+
+    sim_cycles = wake * SIM_CYCLES_PER_TICK + sim_wake_delay;
+    return pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    (void)clear;
+    if(sim_notify_at != 0u && sim_notify_at - now <= wait)
+    {
+        sim_cycles = sim_notify_at * SIM_CYCLES_PER_TICK;
+        sim_notify_at = 0;
+        return 1u;
+    }
+
+    sim_cycles = (now + wait) * SIM_CYCLES_PER_TICK;
+    return 0u;
+}
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+static void check(bool cond, const char *text, int line)
+{
+    if(cond == true) return;
+
+    printf("FAIL line %d : %s\n", line, text);
+    failures++;
+}
+
+static void on_fault(ENUM_PERIODIC_ID_t ID, uint32_t misses)
+{
+    (void)misses;
+    fault_count++;
+    fault_id = ID;
+}
+
+/* body of an iteration */
+static void run(uint32_t us)
+{
+    sim_cycles += us * SIM_CYCLES_PER_US;
+}
+
+/* ============================================================= ==
+   tests
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       20 % load : no miss, every execution in the
+ *              [1/8, 1/4[ bucket, no jitter
+ * 
+ * ************************************************************* **/
+static void test_nominal(void)
+{
+    STRUCT_PERIODIC_STATS_t stats;
+
+    fault_count = 0;
+    API_PERIODIC_INIT(E_PERIODIC_SENSORS, 10);
+    for(int i = 0; i < 100; i++)
+    {
+        run(2000);
+        API_PERIODIC_WAIT(E_PERIODIC_SENSORS);
+    }
+    API_PERIODIC_GET_STATS(E_PERIODIC_SENSORS, &stats);
+
+    CHECK(stats.iterations == 100u);
+    CHECK(stats.misses == 0u);
+    CHECK(stats.exec_hist[3] == 100u);
+    CHECK(stats.exec_max == 2000u);
+    CHECK(stats.jitter_max == 0u);
+    CHECK(stats.jitter_hist[0] == 99u);
+    CHECK(fault_count == 0u);
+}
+
+/** ************************************************************* *
+ * @brief       two streaks of overload (150 % load) : each overrun
+ *              is a miss, the late iterations which catch up too,
+ *              one fault per streak, no miss once caught up
+ * 
+ * ************************************************************* **/
+static void test_overload(void)
+{
+    STRUCT_PERIODIC_STATS_t stats;
+    uint32_t misses;
+
+    fault_count = 0;
+    API_PERIODIC_INIT(E_PERIODIC_BATTERY, 10);
+
+    for(int streak = 0; streak < 2; streak++)
+    {
+        for(int i = 0; i < 10; i++) { run(2000); API_PERIODIC_WAIT(E_PERIODIC_BATTERY); }
+        for(int i = 0; i < 5; i++)  { run(15000); API_PERIODIC_WAIT(E_PERIODIC_BATTERY); }
+    }
+    API_PERIODIC_GET_STATS(E_PERIODIC_BATTERY, &stats);
+
+    /* 5 overruns per streak. The first one ends 25 ms late : 3 more
+     * late iterations of 2 ms to catch up (8 ms each) */
+    CHECK(stats.exec_hist[PERIODIC_NB_BUCKETS - 1u] == 10u);
+    CHECK(stats.exec_max == 15000u);
+    CHECK(stats.misses == 5u + 3u + 5u);
+    CHECK(fault_count == 2u);
+    CHECK(fault_id == E_PERIODIC_BATTERY);
+
+    /* back to nominal */
+    misses = stats.misses;
+    for(int i = 0; i < 20; i++) { run(2000); API_PERIODIC_WAIT(E_PERIODIC_BATTERY); }
+    API_PERIODIC_GET_STATS(E_PERIODIC_BATTERY, &stats);
+    CHECK(stats.misses - misses == 3u);
+
+    misses = stats.misses;
+    for(int i = 0; i < 20; i++) { run(2000); API_PERIODIC_WAIT(E_PERIODIC_BATTERY); }
+    API_PERIODIC_GET_STATS(E_PERIODIC_BATTERY, &stats);
+    CHECK(stats.misses == misses);
+    CHECK(fault_count == 2u);
+}
+
+/** ************************************************************* *
+ * @brief       wake up 1 ms late every other period : jitter of
+ *              1 ms, [1/16, 1/8[ bucket of a 10 ms period
+ * 
+ * ************************************************************* **/
+static void test_jitter(void)
+{
+    STRUCT_PERIODIC_STATS_t stats;
+
+    API_PERIODIC_INIT(E_PERIODIC_HEALTH, 10);
+    for(int i = 0; i < 50; i++)
+    {
+        sim_wake_delay = (i & 1) ? 1000u * SIM_CYCLES_PER_US : 0u;
+        run(500);
+        API_PERIODIC_WAIT(E_PERIODIC_HEALTH);
+    }
+    sim_wake_delay = 0;
+    API_PERIODIC_GET_STATS(E_PERIODIC_HEALTH, &stats);
+
+    CHECK(stats.misses == 0u);
+    CHECK(stats.jitter_max == 1000u);
+    CHECK(stats.jitter_hist[2] == 49u);
+}
+
+/** ************************************************************* *
+ * @brief       a notification ends the wait early without counting
+ *              an iteration. The timeout of the wait is not a miss
+ *              (application : period of one tick).
+ * 
+ * ************************************************************* **/
+static void test_notify(void)
+{
+    STRUCT_PERIODIC_STATS_t stats;
+    TickType_t start;
+
+    API_PERIODIC_INIT(E_PERIODIC_RADIO, 10);
+    start = xTaskGetTickCount();
+
+    run(1000);
+    sim_notify_at = start + 4u;
+    API_PERIODIC_WAIT_NOTIFY(E_PERIODIC_RADIO);
+    CHECK(xTaskGetTickCount() == start + 4u);
+
+    run(1000);
+    API_PERIODIC_WAIT_NOTIFY(E_PERIODIC_RADIO);
+    CHECK(xTaskGetTickCount() == start + 10u);
+
+    API_PERIODIC_GET_STATS(E_PERIODIC_RADIO, &stats);
+    CHECK(stats.iterations == 1u);
+    CHECK(stats.misses == 0u);
+
+    fault_count = 0;
+    API_PERIODIC_INIT(E_PERIODIC_APPLICATION, 1);
+    for(int i = 0; i < 100; i++)
+    {
+        run(200);
+        API_PERIODIC_WAIT_NOTIFY(E_PERIODIC_APPLICATION);
+    }
+    API_PERIODIC_GET_STATS(E_PERIODIC_APPLICATION, &stats);
+    CHECK(stats.iterations == 100u);
+    CHECK(stats.misses == 0u);
+    CHECK(fault_count == 0u);
+}
+
+/* ============================================================= ==
+   main
+== ============================================================= */
+int main(void)
+{
+    API_PERIODIC_SET_FAULT(on_fault);
+
+    test_nominal();
+    test_overload();
+    test_jitter();
+    test_notify();
+
+    printf("%s (%u failures)\n", failures == 0u ? "PASS" : "FAIL", failures);
+    return failures == 0u ? 0 : 1;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,48 @@
+/** ************************************************************* *
+ * @file        FreeRTOS.h
+ * @brief       Simulated kernel of the periodic_sim host test :
+ *              the tick and the cycle counter are advanced by the
+ *              test, the delays return at once.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef PERIODIC_SIM_FREERTOS_H_
+#define PERIODIC_SIM_FREERTOS_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define configTICK_RATE_HZ                  1000u
+#define configASSERT(x)                     assert(x)
+
+#define pdFALSE                             0
+#define pdTRUE                              1
+#define pdMS_TO_TICKS(ms)                   ((TickType_t)(ms))
+
+#define portGET_RUN_TIME_COUNTER_VALUE()    (sim_cycles)
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+extern uint32_t SystemCoreClock;
+extern uint32_t sim_cycles;
+
+#endif /* PERIODIC_SIM_FREERTOS_H_ */
@@ -0,0 +1,34 @@
+/** ************************************************************* *
+ * @file        task.h
+ * @brief       Simulated kernel of the periodic_sim host test.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef PERIODIC_SIM_TASK_H_
+#define PERIODIC_SIM_TASK_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "FreeRTOS.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* one task : nothing to protect */
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+TickType_t xTaskGetTickCount(void);
+BaseType_t xTaskDelayUntil(TickType_t *previous, TickType_t increment);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait);
+
+#endif /* PERIODIC_SIM_TASK_H_ */
@@ -0,0 +1,371 @@
+/** ************************************************************* *
+ * @file        powercut_test.c
+ * @brief       Host test of the power cuts of the flight log
+ *              (API_datalogger.c, built in this file on a simulated
+ *              flash). The power is cut at every byte of a page
+ *              program and at every byte of the erase, then the log
+ *              is mounted again : the sealed pages must still be
+ *              valid, the head after the last of them, and the
+ *              next pages programmed on erased bytes only.
+ *              The sectors are shrunk to 4 KB (64 pages in the log)
+ *              to cut the erase at every byte.
+ * 
+ *              build (from this folder) :
+ *              cc -O2 -Wall -Wextra -Wno-unused-parameter -Isim
+ *                  -I../../Components/Datalogger/inc
+ *                  -I../../Components/Configuration powercut_test.c
+ *                  ../../Components/Datalogger/log_page.c
+ *                  ../../Components/Datalogger/log_codec.c
+ *                  -o powercut_test
+ * 
+ *              usage :
+ *              powercut_test       -> exit code 0 when all the checks pass
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <setjmp.h>
+
+#define LOG_FLASH_SECTOR_SIZE   (4u * 1024u)    /* [byte] 16 pages */
+
+#include "../../Components/Datalogger/API_datalogger.c"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define SIM_NO_CUT              UINT32_MAX
+#define SIM_SECTOR_PAGES        (LOG_FLASH_SECTOR_SIZE / LOG_PAGE_SIZE)
+#define SIM_SEED                0x4D533153u
+
+#define CHECK(cond)             check((cond), #cond, __LINE__)
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+/* stubbed registers */
+SIM_RCC_t sim_rcc;
+
+/* simulated flash : NOR, a program clears bits, an erase sets them */
+static uint8_t sim_flash[LOG_FLASH_SIZE];
+static uint8_t sim_image[LOG_FLASH_SIZE];   /* flash before the cut */
+static uint32_t sim_budget = SIM_NO_CUT;    /* [byte] written before the power cut */
+static uint32_t sim_overwrites = 0;         /* bytes programmed while not erased */
+static jmp_buf sim_reset;
+
+static uint32_t seed = SIM_SEED;
+static uint32_t sample = 0;
+
+static uint32_t failures = 0;
+
+/* ============================================================= ==
+   host stubs
+== ============================================================= */
+TickType_t xTaskGetTickCount(void) { return sample; }
+BaseType_t xTaskNotifyWait(uint32_t clear_entry, uint32_t clear_exit, uint32_t* value, TickType_t wait) { (void)clear_entry; (void)clear_exit; (void)value; (void)wait; return pdFALSE; }
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action) { (void)task; (void)value; (void)action; return pdPASS; }
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t wait) { (void)queue; (void)item; (void)wait; return pdFALSE; }
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t wait) { (void)queue; (void)item; (void)wait; return pdFALSE; }
+QueueHandle_t xQueueCreate(uint32_t length, uint32_t size) { (void)length; (void)size; return NULL; }
+bool API_HMI_STREAM(TYPE_HMI_ID_t dataID, const uint8_t* data, uint32_t len) { (void)dataID; (void)data; (void)len; return true; }
+void API_HEALTH_ADD_QUEUE(QueueHandle_t queue) { (void)queue; }
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack, void* parameters, uint32_t priority, TaskHandle_t* handle)
+{
+    (void)function; (void)name; (void)stack; (void)parameters; (void)priority;
+    *handle = NULL;
+    return pdPASS;
+}
+
+/* ============================================================= ==
+   simulated flash
+== ============================================================= */
+/* xorshift32 */
+static uint32_t random32(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+/* one byte written, or the power cut : the byte is left between the
+ * old and the new value, the firmware stops there */
+static void sim_write(uint32_t offset, uint8_t value, uint8_t partial)
+{
+    if(sim_budget == 0u)
+    {
+        sim_flash[offset] = partial;
+        sim_budget = SIM_NO_CUT;
+        longjmp(sim_reset, 1);
+    }
+
+    if(sim_budget != SIM_NO_CUT) sim_budget--;
+    sim_flash[offset] = value;
+}
+
+const uint8_t* log_flash_map(uint32_t offset)
+{
+    return &sim_flash[offset];
+}
+
+/* same checks as log_flash.c, programmed byte by byte */
+bool log_flash_program(uint32_t offset, const uint8_t *data, uint32_t len)
+{
+    if((offset & 3u) != 0u || (len & 3u) != 0u || offset + len > LOG_FLASH_SIZE) return false;
+
+    for(uint32_t i = 0; i < len; i++)
+    {
+        uint8_t old = sim_flash[offset + i];
+
+        if(old != LOG_ERASED) sim_overwrites++;
+        sim_write(offset + i, old & data[i], old & (data[i] | (uint8_t)random32()));
+    }
+
+    return true;
+}
+
+/* same order as log_flash.c : the last sector first. A sector is
+ * erased byte by byte, in order. */
+bool log_flash_erase(void)
+{
+    for(uint32_t sector = LOG_FLASH_SECTORS; sector > 0u; sector--)
+    {
+        uint32_t base = (sector - 1u) * LOG_FLASH_SECTOR_SIZE;
+
+        for(uint32_t i = 0; i < LOG_FLASH_SECTOR_SIZE; i++)
+        {
+            sim_write(base + i, LOG_ERASED, sim_flash[base + i] | (uint8_t)random32());
+        }
+    }
+
+    return true;
+}
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+static void check(bool cond, const char *text, int line)
+{
+    if(cond == true) return;
+
+    printf("FAIL line %d : %s\n", line, text);
+    failures++;
+}
+
+/* run a write of the firmware, the power is cut after budget bytes */
+static void power_cut(void (*write)(void), uint32_t budget)
+{
+    sim_budget = budget;
+    if(setjmp(sim_reset) == 0) write();
+    sim_budget = SIM_NO_CUT;
+}
+
+static void erase(void)
+{
+    log_flash_erase();
+}
+
+/* reset of the target : the task starts with the mount */
+static void reboot(void)
+{
+    memset(&datalogger_stats, 0, sizeof(datalogger_stats));
+    mount();
+}
+
+/* records in the page buffer until it is full, not programmed */
+static void fill_page(void)
+{
+    STRUCT_LOG_HEAD_t head = {.type = E_LOG_REC_IMU, .size = sizeof(STRUCT_LOG_IMU_t), .reserved = 0};
+    STRUCT_LOG_IMU_t imu;
+
+    while(datalogger_fill + sizeof(head) + sizeof(imu) <= LOG_PAGE_DATA)
+    {
+        for(uint32_t i = 0; i < 3u; i++)
+        {
+            imu.accel[i] = (int16_t)random32();
+            imu.gyro[i]  = (int16_t)random32();
+        }
+        imu.angle_x = (int16_t)sample;
+        imu.angle_y = (int16_t)~sample;
+        head.time   = sample++;
+
+        append(&head, &imu);
+    }
+}
+
+/* erased flash, then a log of the given number of sealed pages */
+static void make_log(uint32_t pages)
+{
+    memset(sim_flash, LOG_ERASED, sizeof(sim_flash));
+    reboot();
+
+    for(uint32_t i = 0; i < pages; i++)
+    {
+        fill_page();
+        flush();
+    }
+}
+
+/* pages [0, pages[ valid and in order */
+static bool sealed(uint32_t pages)
+{
+    for(uint32_t i = 0; i < pages; i++)
+    {
+        STRUCT_LOG_PAGE_HEAD_t head;
+
+        memcpy(&head, &sim_flash[i * LOG_PAGE_SIZE], sizeof(head));
+        if(log_page_check(&sim_flash[i * LOG_PAGE_SIZE]) != E_LOG_PAGE_VALID || head.seq != i) return false;
+    }
+    return true;
+}
+
+/* a page written after the mount : sealed at the head, on erased
+ * bytes only */
+static bool resume(void)
+{
+    uint32_t page = datalogger_head / LOG_PAGE_SIZE;
+    STRUCT_LOG_PAGE_HEAD_t head;
+
+    if(datalogger_head >= LOG_FLASH_SIZE) return true;
+
+    sim_overwrites = 0;
+    fill_page();
+    flush();
+
+    memcpy(&head, &sim_flash[page * LOG_PAGE_SIZE], sizeof(head));
+    return sim_overwrites == 0u && head.seq == page && log_page_check(&sim_flash[page * LOG_PAGE_SIZE]) == E_LOG_PAGE_VALID;
+}
+
+/* ============================================================= ==
+   tests
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       power cut at every byte of the program of a page
+ *              (body, crc, sequence number) : in the middle of a
+ *              sector, on the last page of a sector, on the first
+ *              page of a sector. The head is after the last sealed
+ *              page, after the cut page when it was touched (torn
+ *              pages get a sequence number).
+ * 
+ * ************************************************************* **/
+static void test_program(void)
+{
+    static const uint32_t logs[] = {5u, SIM_SECTOR_PAGES - 1u, SIM_SECTOR_PAGES};
+    uint32_t errors = 0;
+    uint32_t outcome[E_LOG_PAGE_CORRUPTED + 1u] = {0};
+
+    for(uint32_t l = 0; l < sizeof(logs) / sizeof(logs[0]); l++)
+    {
+        uint32_t base = logs[l];
+
+        make_log(base);
+        memcpy(sim_image, sim_flash, sizeof(sim_image));
+
+        for(uint32_t cut = 0; cut <= LOG_PAGE_SIZE; cut++)
+        {
+            ENUM_LOG_PAGE_t state;
+            uint32_t expected;
+
+            memcpy(sim_flash, sim_image, sizeof(sim_flash));
+            reboot();
+            fill_page();
+
+            power_cut(flush, (cut < LOG_PAGE_SIZE) ? cut : SIM_NO_CUT);
+
+            state = log_page_check(&sim_flash[base * LOG_PAGE_SIZE]);
+            outcome[state]++;
+            expected = (state == E_LOG_PAGE_ERASED) ? base : base + 1u;
+
+            sim_overwrites = 0;
+            reboot();
+
+            if(sealed(base) == false) errors++;
+            if(cut == LOG_PAGE_SIZE && state != E_LOG_PAGE_VALID) errors++;
+            if(datalogger_head != expected * LOG_PAGE_SIZE || datalogger_seq != expected) errors++;
+            if(datalogger_stats.torn != ((state == E_LOG_PAGE_TORN) ? 1u : 0u)) errors++;
+            if(sim_overwrites != 0u) errors++;
+            if(resume() == false) errors++;
+        }
+    }
+    CHECK(errors == 0u);
+
+    printf("program cut  : %u valid, %u erased, %u torn, %u corrupted pages\n",
+           outcome[E_LOG_PAGE_VALID], outcome[E_LOG_PAGE_ERASED], outcome[E_LOG_PAGE_TORN], outcome[E_LOG_PAGE_CORRUPTED]);
+}
+
+/** ************************************************************* *
+ * @brief       power cut at every byte of the erase of a log which
+ *              ends in the middle of a sector, then of a full log.
+ *              The sealed pages below the damaged sector are kept
+ *              and the head is after them, at most at the start of
+ *              the next sector : no erased sector is lost, the
+ *              next pages are programmed on erased bytes.
+ * 
+ * ************************************************************* **/
+static void test_erase(void)
+{
+    static const uint32_t logs[] = {2u * SIM_SECTOR_PAGES + SIM_SECTOR_PAGES / 2u, LOG_FLASH_PAGES};
+    uint32_t errors = 0;
+    uint32_t skipped = 0;
+
+    for(uint32_t l = 0; l < sizeof(logs) / sizeof(logs[0]); l++)
+    {
+        uint32_t pages = logs[l];
+
+        make_log(pages);
+        memcpy(sim_image, sim_flash, sizeof(sim_image));
+
+        for(uint32_t cut = 0; cut <= LOG_FLASH_SIZE; cut++)
+        {
+            /* sector erased at the cut, LOG_FLASH_SECTORS : no cut */
+            uint32_t sector = (cut < LOG_FLASH_SIZE) ? LOG_FLASH_SECTORS - 1u - cut / LOG_FLASH_SECTOR_SIZE : 0u;
+            uint32_t kept = sector * SIM_SECTOR_PAGES;
+
+            if(kept > pages) kept = pages;
+
+            memcpy(sim_flash, sim_image, sizeof(sim_flash));
+            power_cut(erase, (cut < LOG_FLASH_SIZE) ? cut : SIM_NO_CUT);
+
+            sim_overwrites = 0;
+            reboot();
+
+            if(sealed(kept) == false) errors++;
+            if(datalogger_head < kept * LOG_PAGE_SIZE) errors++;
+            if(datalogger_head > (sector + 1u) * LOG_FLASH_SECTOR_SIZE) errors++;
+            if(cut == LOG_FLASH_SIZE && datalogger_head != 0u) errors++;
+            if(log_page_erased(&sim_flash[datalogger_head], LOG_FLASH_SIZE - datalogger_head) == false) errors++;
+            if(sim_overwrites != 0u) errors++;
+            skipped += datalogger_stats.torn;
+            if(resume() == false) errors++;
+        }
+    }
+    CHECK(errors == 0u);
+
+    printf("erase cut    : %u cuts, %u torn pages or sectors skipped\n", 2u * (LOG_FLASH_SIZE + 1u), skipped);
+}
+
+/* ============================================================= ==
+   main
+== ============================================================= */
+int main(void)
+{
+    test_program();
+    test_erase();
+
+    printf("%s (%u failures)\n", failures == 0u ? "PASS" : "FAIL", failures);
+    return failures == 0u ? 0 : 1;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
@@ -0,0 +1,41 @@
+/** ************************************************************* *
+ * @file        API_HMI.h
+ * @brief       Host stub of the powercut_test : the dump of the
+ *              log, implemented by the test.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef POWERCUT_TEST_API_HMI_H_
+#define POWERCUT_TEST_API_HMI_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define HMI_ID_LOG_DUMP         (TYPE_HMI_ID_t)0x70
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+typedef uint8_t TYPE_HMI_ID_t;
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+bool API_HMI_STREAM(TYPE_HMI_ID_t dataID, const uint8_t* data, uint32_t len);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* POWERCUT_TEST_API_HMI_H_ */
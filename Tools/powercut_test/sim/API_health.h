@@ -0,0 +1,30 @@
+/** ************************************************************* *
+ * @file        API_health.h
+ * @brief       Host stub of the powercut_test : the queue watch,
+ *              implemented by the test.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef POWERCUT_TEST_API_HEALTH_H_
+#define POWERCUT_TEST_API_HEALTH_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "queue.h"
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+void API_HEALTH_ADD_QUEUE(QueueHandle_t queue);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* POWERCUT_TEST_API_HEALTH_H_ */
@@ -0,0 +1,46 @@
+/** ************************************************************* *
+ * @file        FreeRTOS.h
+ * @brief       Host stub of the powercut_test : no scheduler, the
+ *              mount and the pages of API_datalogger.c are called
+ *              by the test.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef POWERCUT_TEST_FREERTOS_H_
+#define POWERCUT_TEST_FREERTOS_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define configASSERT(x)                     assert(x)
+#define configMINIMAL_STACK_SIZE            128u
+
+#define pdFALSE                             0
+#define pdTRUE                              1
+#define pdPASS                              1
+#define pdMS_TO_TICKS(ms)                   ((TickType_t)(ms))
+#define portTICK_PERIOD_MS                  1u
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* POWERCUT_TEST_FREERTOS_H_ */
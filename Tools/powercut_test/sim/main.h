@@ -0,0 +1,41 @@
+/** ************************************************************* *
+ * @file        main.h
+ * @brief       Host stub of the powercut_test : the reset flags
+ *              read by the boot record are a plain variable.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef POWERCUT_TEST_MAIN_H_
+#define POWERCUT_TEST_MAIN_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include <stdint.h>
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+typedef struct { volatile uint32_t CSR; } SIM_RCC_t;
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define RCC                     (&sim_rcc)
+#define RCC_CSR_RMVF            (1u << 24)
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+extern SIM_RCC_t sim_rcc;
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* POWERCUT_TEST_MAIN_H_ */
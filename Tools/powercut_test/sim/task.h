@@ -0,0 +1,47 @@
+/** ************************************************************* *
+ * @file        task.h
+ * @brief       Host stub of the powercut_test : kernel calls of
+ *              the datalogger task, implemented by the test.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef POWERCUT_TEST_TASK_H_
+#define POWERCUT_TEST_TASK_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "FreeRTOS.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* one task : nothing to protect */
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+typedef enum { eSetBits } eNotifyAction;
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+TickType_t xTaskGetTickCount(void);
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack, void* parameters, uint32_t priority, TaskHandle_t* handle);
+BaseType_t xTaskNotifyWait(uint32_t clear_entry, uint32_t clear_exit, uint32_t* value, TickType_t wait);
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* POWERCUT_TEST_TASK_H_ */
@@ -0,0 +1,317 @@
+/** ************************************************************* *
+ * @file        prefilter_test.c
+ * @brief       Host test of the order of the filters of the sensors
+ *              task (API_sensors.c, built in this file on stubbed
+ *              I2C and queues) : the biquad bank runs on the values
+ *              read from the MPU6050 before the kalman filter, the
+ *              queue and the streams.
+ *              The rocket is tilted by 30 deg and shaken at 40 Hz on
+ *              an axis of the accelerometer and of the gyroscope :
+ *              the kalman angle fed by the raw values is off by
+ *              about 3 deg, fed by the pre-filtered values it stays
+ *              on the tilt.
+ * 
+ *              build (from this folder) :
+ *              cc -O2 -Wall -Wextra -Wno-unused-parameter -Isim
+ *                  -I../../Components/Sensors/inc
+ *                  -I../../Components/Periodic/inc
+ *                  -I../../Components/Health/inc
+ *                  -I../../Components/Configuration prefilter_test.c
+ *                  ../../Components/Sensors/mpu6050.c
+ *                  ../../Components/Sensors/sensors_biquad.c
+ *                  ../../Components/Sensors/sensors_decim.c
+ *                  -lm -o prefilter_test
+ * 
+ *              usage :
+ *              prefilter_test      -> exit code 0 when all the checks pass
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "i2c.h"
+#include "../../Components/Sensors/API_sensors.c"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define TEST_PI                 3.14159265358979323846
+#define TEST_TILT               30.0    /* [deg] pitch */
+#define TEST_SHAKE              40.0    /* [Hz] vibration of the motor */
+#define TEST_SHAKE_ACCEL        0.5     /* [g] */
+#define TEST_SHAKE_GYRO         50.0    /* [deg/s] */
+#define TEST_PRESSURE           101325.0f   /* [Pa] */
+#define TEST_DURATION           10000u  /* [ms] */
+#define TEST_SETTLE             8000u   /* [ms] transient of the kalman filter */
+
+#define TEST_ANGLE_MAX          0.5     /* [deg] kalman angle off the tilt */
+#define TEST_ACCEL_MAX          0.01    /* [g] vibration left in the queue */
+
+#define SIM_ACCEL_LSB           2048.0  /* [LSB/g] +-16 g */
+#define SIM_GYRO_LSB            16.4    /* [LSB/(deg/s)] +-2000 deg/s */
+
+#define SIM_QUEUES              8u
+#define SIM_ITEM_MAX            128u    /* [byte] */
+
+#define MPU6050_REG_WHO_AM_I    0x75
+#define MPU6050_REG_ACCEL       0x3B
+
+#define CHECK(cond)             check((cond), #cond, __LINE__)
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+/* queue of one item */
+typedef struct
+{
+    uint32_t size;
+    bool full;
+    uint8_t item[SIM_ITEM_MAX];
+}SIM_QUEUE_t;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+I2C_HandleTypeDef hi2c2;
+
+static SIM_QUEUE_t sim_queues[SIM_QUEUES];
+static uint32_t sim_queues_nb = 0;
+static uint32_t sim_time = 0;           /* [ms] */
+
+/* values of the MPU6050 registers */
+static int16_t sim_accel[3];
+static int16_t sim_gyro[3];
+
+static uint32_t failures = 0;
+
+/* ============================================================= ==
+   stubs
+== ============================================================= */
+TickType_t xTaskGetTickCount(void)
+{
+    return sim_time;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return sim_time;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack, void* parameters, uint32_t priority, TaskHandle_t* handle)
+{
+    *handle = NULL;
+    return pdPASS;
+}
+
+QueueHandle_t xQueueCreate(uint32_t length, uint32_t size)
+{
+    assert(sim_queues_nb < SIM_QUEUES && size <= SIM_ITEM_MAX);
+
+    sim_queues[sim_queues_nb].size = size;
+    return &sim_queues[sim_queues_nb++];
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t wait)
+{
+    SIM_QUEUE_t *q = queue;
+
+    if(q->full == true) return pdFALSE;
+
+    memcpy(q->item, item, q->size);
+    q->full = true;
+    return pdTRUE;
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item)
+{
+    SIM_QUEUE_t *q = queue;
+
+    memcpy(q->item, item, q->size);
+    q->full = true;
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t wait)
+{
+    SIM_QUEUE_t *q = queue;
+
+    if(q->full == false) return pdFALSE;
+
+    memcpy(item, q->item, q->size);
+    q->full = false;
+    return pdTRUE;
+}
+
+void API_HEALTH_ADD_QUEUE(QueueHandle_t queue)
+{
+}
+
+void API_PERIODIC_INIT(ENUM_PERIODIC_ID_t ID, TickType_t period)
+{
+}
+
+void API_PERIODIC_WAIT(ENUM_PERIODIC_ID_t ID)
+{
+}
+
+/* registers of the MPU6050, big endian */
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef* hi2c, uint16_t address, uint16_t reg, uint16_t size, uint8_t* data, uint16_t len, uint32_t timeout)
+{
+    int16_t regs[7] = {sim_accel[0], sim_accel[1], sim_accel[2], 0, sim_gyro[0], sim_gyro[1], sim_gyro[2]};
+
+    if(reg == MPU6050_REG_WHO_AM_I)
+    {
+        data[0] = 0x68;
+        return HAL_OK;
+    }
+    if(reg != MPU6050_REG_ACCEL || len > sizeof(regs)) return HAL_ERROR;
+
+    for(uint16_t i = 0; i < len; i++)
+    {
+        uint16_t word = (uint16_t)regs[i / 2u];
+
+        data[i] = (i & 1u) ? (uint8_t)word : (uint8_t)(word >> 8);
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef* hi2c, uint16_t address, uint16_t reg, uint16_t size, uint8_t* data, uint16_t len, uint32_t timeout)
+{
+    return HAL_OK;
+}
+
+uint8_t BMP280_Init(void)
+{
+    return 0;
+}
+
+uint8_t BMP280_Read_All(void)
+{
+    return 0;
+}
+
+BMP280_t BMP280_Get_Struct(void)
+{
+    BMP280_t data = {0};
+
+    data.pressure    = TEST_PRESSURE;
+    data.temperature = 20.0f;
+    return data;
+}
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+static void check(bool cond, const char *text, int line)
+{
+    if(cond == true) return;
+
+    printf("FAIL line %d : %s\n", line, text);
+    failures++;
+}
+
+static int16_t saturate(double value)
+{
+    if(value > INT16_MAX) return INT16_MAX;
+    if(value < INT16_MIN) return INT16_MIN;
+    return (int16_t)lround(value);
+}
+
+/* ============================================================= ==
+   tests
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       periods of the sensors task on the shaken rocket :
+ *              angles of the queue and of the hmi stream, vibration
+ *              left in the queue, raw values as read
+ * 
+ * ************************************************************* **/
+static void test_order(void)
+{
+    STRUCT_SENSORS_MPU6050_t imu;
+    STRUCT_SENSORS_STREAM_t stream;
+    double angle_err = 0.0;
+    double stream_err = 0.0;
+    double accel_min = 1e9, accel_max = -1e9;
+    int16_t raw_min = INT16_MAX, raw_max = INT16_MIN;
+    uint32_t samples = 0;
+    uint32_t streams = 0;
+
+    API_SENSORS_START();
+
+    for(sim_time = SENSORS_PERIOD_TASK; sim_time <= TEST_DURATION; sim_time += SENSORS_PERIOD_TASK)
+    {
+        double t = sim_time / 1000.0;
+        double shake = sin(2.0 * TEST_PI * TEST_SHAKE * t + 0.3);
+        double tilt = TEST_TILT * TEST_PI / 180.0;
+
+        sim_accel[0] = saturate((-sin(tilt) + TEST_SHAKE_ACCEL * shake) * SIM_ACCEL_LSB);
+        sim_accel[1] = 0;
+        sim_accel[2] = saturate(cos(tilt) * SIM_ACCEL_LSB);
+        sim_gyro[0]  = 0;
+        sim_gyro[1]  = saturate(TEST_SHAKE_GYRO * shake * SIM_GYRO_LSB);
+        sim_gyro[2]  = 0;
+
+        /* a period of the task */
+        read_mpu6050();
+        read_bmp280();
+        sensors_input.time = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        decimate();
+
+        CHECK(API_SENSORS_GET_MPU6050(&imu) == true);
+        if(sim_time < TEST_SETTLE) continue;
+
+        samples++;
+        angle_err = fmax(angle_err, fabs(imu.data.KalmanAngleY - TEST_TILT));
+        accel_min = fmin(accel_min, imu.data.Ax);
+        accel_max = fmax(accel_max, imu.data.Ax);
+        if(imu.data.Accel_X_RAW < raw_min) raw_min = imu.data.Accel_X_RAW;
+        if(imu.data.Accel_X_RAW > raw_max) raw_max = imu.data.Accel_X_RAW;
+
+        if(API_SENSORS_WAIT_STREAM(E_SENSORS_STREAM_HMI, &stream) == true)
+        {
+            streams++;
+            CHECK(stream.valid == (SENSORS_VALID_IMU | SENSORS_VALID_BARO));
+            stream_err = fmax(stream_err, fabs(stream.value[E_SENSORS_CH_ANGLE_Y] / SENSORS_SCALE_ANGLE - TEST_TILT));
+        }
+    }
+
+    printf("kalman angle      : %.3f deg off the tilt (max)\n", angle_err);
+    printf("hmi stream angle  : %.3f deg off the tilt (max)\n", stream_err);
+    printf("accel x in queue  : %.4f g peak to peak\n", accel_max - accel_min);
+    printf("accel x raw       : %.4f g peak to peak\n", (raw_max - raw_min) / SIM_ACCEL_LSB);
+
+    CHECK(samples > 0u && streams > 0u);
+    CHECK(angle_err < TEST_ANGLE_MAX);
+    CHECK(stream_err < TEST_ANGLE_MAX);
+    CHECK(accel_max - accel_min < TEST_ACCEL_MAX);
+
+    /* the raw values are left as read for the flight log */
+    CHECK((raw_max - raw_min) / SIM_ACCEL_LSB > TEST_SHAKE_ACCEL);
+}
+
+/* ============================================================= ==
+   main
+== ============================================================= */
+int main(void)
+{
+    test_order();
+
+    printf("%s (%u failures)\n", (failures == 0u) ? "PASS" : "FAIL", failures);
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
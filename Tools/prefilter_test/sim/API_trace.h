@@ -0,0 +1,26 @@
+/** ************************************************************* *
+ * @file        API_trace.h
+ * @brief       Host stub of the prefilter_test : no trace.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef PREFILTER_TEST_API_TRACE_H_
+#define PREFILTER_TEST_API_TRACE_H_
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define API_TRACE_ENTER(event, value)
+#define API_TRACE_EXIT(event, value)
+#define API_TRACE_MARK(event, value)
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* PREFILTER_TEST_API_TRACE_H_ */
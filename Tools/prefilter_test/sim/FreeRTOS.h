@@ -0,0 +1,46 @@
+/** ************************************************************* *
+ * @file        FreeRTOS.h
+ * @brief       Host stub of the prefilter_test : no scheduler, the
+ *              periods of the sensors task are called by the test.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef PREFILTER_TEST_FREERTOS_H_
+#define PREFILTER_TEST_FREERTOS_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+#define configASSERT(x)                     assert(x)
+#define configMINIMAL_STACK_SIZE            128u
+
+#define pdFALSE                             0
+#define pdTRUE                              1
+#define pdPASS                              1
+#define pdMS_TO_TICKS(ms)                   ((TickType_t)(ms))
+#define portTICK_PERIOD_MS                  1u
+#define portMAX_DELAY                       (TickType_t)0xFFFFFFFFu
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* PREFILTER_TEST_FREERTOS_H_ */
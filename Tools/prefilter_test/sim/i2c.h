@@ -0,0 +1,43 @@
+/** ************************************************************* *
+ * @file        i2c.h
+ * @brief       Host stub of the prefilter_test : the registers of
+ *              the MPU6050 are read from the samples of the test.
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef PREFILTER_TEST_I2C_H_
+#define PREFILTER_TEST_I2C_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include <stdint.h>
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+typedef enum { HAL_OK, HAL_ERROR } HAL_StatusTypeDef;
+typedef struct { int dummy; } I2C_HandleTypeDef;
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+extern I2C_HandleTypeDef hi2c2;
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+uint32_t HAL_GetTick(void);
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef* hi2c, uint16_t address, uint16_t reg, uint16_t size, uint8_t* data, uint16_t len, uint32_t timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef* hi2c, uint16_t address, uint16_t reg, uint16_t size, uint8_t* data, uint16_t len, uint32_t timeout);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* PREFILTER_TEST_I2C_H_ */
@@ -0,0 +1,36 @@
+/** ************************************************************* *
+ * @file        task.h
+ * @brief       Host stub of the prefilter_test, see FreeRTOS.h
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+#ifndef PREFILTER_TEST_TASK_H_
+#define PREFILTER_TEST_TASK_H_
+
+/* ------------------------------------------------------------- --
+   includes
+-- ------------------------------------------------------------- */
+#include "FreeRTOS.h"
+
+/* ------------------------------------------------------------- --
+   types
+-- ------------------------------------------------------------- */
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+/* ------------------------------------------------------------- --
+   function prototypes
+-- ------------------------------------------------------------- */
+TickType_t xTaskGetTickCount(void);
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack, void* parameters, uint32_t priority, TaskHandle_t* handle);
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */
+
+#endif /* PREFILTER_TEST_TASK_H_ */
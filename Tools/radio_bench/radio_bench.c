@@ -0,0 +1,397 @@
+/** ************************************************************* *
+ * @file        radio_bench.c
+ * @brief       Host test and benchmark of the radio telemetry codec
+ *              (radio_codec.c) : encode / decode round trip over a
+ *              simulated flight, lost, corrupted and truncated
+ *              frames, then the size of the frames against the
+ *              fixed width samples and the encode / decode time.
+ *              The framing is the one of the radio task : 10 samples
+ *              at 20 Hz per frame, a keyframe every 4 frames. The
+ *              frames must be at most a third of the raw samples.
+ * 
+ *              build (from this folder) :
+ *              cc -O2 -Wall -Wextra -I../../Components/Radio/inc
+ *                  radio_bench.c ../../Components/Radio/radio_codec.c
+ *                  -o radio_bench
+ * 
+ *              usage :
+ *              radio_bench         -> exit code 0 when all the checks pass
+ * 
+ * @date        2026-10-19
+ * @author      Quentin Bakrim (quentin.bakrim@hotmail.fr)
+ * 
+ * Mines Space
+ * 
+ * ************************************************************* **/
+
+/* ------------------------------------------------------------- --
+   include
+-- ------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "radio_codec.h"
+
+/* ------------------------------------------------------------- --
+   defines
+-- ------------------------------------------------------------- */
+/* as API_radio.c */
+#define FRAME_SAMPLES           10u
+#define KEYFRAME_PERIOD         4u
+#define SAMPLE_PERIOD           50u     /* [ms] */
+#define RAW_SAMPLE_SIZE         12u     /* [byte] fixed width sample */
+#define RATIO_MIN               3u      /* raw samples / frames */
+
+#define FLIGHT_DURATION         120000u /* [ms] */
+#define FLIGHT_SAMPLES          (FLIGHT_DURATION / SAMPLE_PERIOD)
+#define FLIGHT_FRAMES           (FLIGHT_SAMPLES / FRAME_SAMPLES)
+
+#define BENCH_LOOPS             200u
+#define TEST_SEED               0x4D533153u
+
+#define CHECK(cond)             check((cond), #cond, __LINE__)
+
+/* ------------------------------------------------------------- --
+   variables
+-- ------------------------------------------------------------- */
+static STRUCT_RADIO_SAMPLE_t flight[FLIGHT_SAMPLES];
+
+static uint8_t frames[FLIGHT_FRAMES][RADIO_CODEC_FRAME_MAX(FRAME_SAMPLES)];
+static uint32_t lengths[FLIGHT_FRAMES];
+
+static uint32_t seed = TEST_SEED;
+static uint32_t failures = 0;
+
+/* ============================================================= ==
+   private functions
+== ============================================================= */
+static void check(bool cond, const char *text, int line)
+{
+    if(cond == true) return;
+
+    printf("FAIL line %d : %s\n", line, text);
+    failures++;
+}
+
+/* xorshift32 */
+static uint32_t random32(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+/* about gaussian noise, standard deviation sigma */
+static int32_t noise(int32_t sigma)
+{
+    int32_t sum = 0;
+
+    for(int i = 0; i < 4; i++) sum += (int32_t)(random32() % 2001u) - 1000;
+
+    return sum * sigma / 1155;
+}
+
+static bool same(const STRUCT_RADIO_SAMPLE_t *a, const STRUCT_RADIO_SAMPLE_t *b)
+{
+    return memcmp(a, b, sizeof(STRUCT_RADIO_SAMPLE_t)) == 0;
+}
+
+/** ************************************************************* *
+ * @brief       telemetry of a flight : 10 s on the pad, 3 s of
+ *              boost, coast to about 1 km, descent at 8 m/s under
+ *              the parachute. Noise of the sensors after the
+ *              decimation (0.05 deg, 0.3 m, 3 mV).
+ * 
+ * ************************************************************* **/
+static void simulate(void)
+{
+    float alt = 0.0f;
+    float vel = 0.0f;
+    int32_t phase = 0;
+    int32_t actuators = 0;
+
+    for(uint32_t i = 0; i < FLIGHT_SAMPLES; i++)
+    {
+        float t = (float)(i * SAMPLE_PERIOD) / 1000.0f;
+        float dt = (float)SAMPLE_PERIOD / 1000.0f;
+        float tilt = 0.0f;
+
+        if(t < 10.0f)           { phase = 1; }
+        else if(t < 13.0f)      { phase = 2; vel += 110.0f * dt; tilt = (t - 10.0f) * 150.0f; }
+        else if(vel > 0.0f)     { phase = 3; vel -= 9.81f * dt; tilt = 450.0f + (t - 13.0f) * 60.0f; }
+        else if(alt > 0.0f)     { phase = 4; vel = -8.0f; actuators = 3; tilt = 1500.0f; }
+        else                    { phase = 5; vel = 0.0f; alt = 0.0f; actuators = 3 | (3 << 4); tilt = 9000.0f; }
+        alt += vel * dt;
+        if(alt < 0.0f) alt = 0.0f;
+
+        flight[i].field[E_RADIO_FIELD_ANGLE_X]   = (int32_t)tilt + noise(5);
+        flight[i].field[E_RADIO_FIELD_ANGLE_Y]   = (int32_t)(tilt / 4.0f) + noise(5);
+        flight[i].field[E_RADIO_FIELD_ALTITUDE]  = (int32_t)(alt * 10.0f) + noise(3);
+        flight[i].field[E_RADIO_FIELD_PHASE]     = phase;
+        flight[i].field[E_RADIO_FIELD_BATTERY]   = 7400 - (int32_t)(i / 40u) + noise(3);
+        flight[i].field[E_RADIO_FIELD_ACTUATORS] = actuators;
+    }
+}
+
+/* encode the flight as the radio task */
+static uint32_t encode_flight(void)
+{
+    STRUCT_RADIO_CODEC_t codec;
+    uint32_t total = 0;
+
+    radio_codec_init(&codec);
+    for(uint32_t n = 0; n < FLIGHT_FRAMES; n++)
+    {
+        lengths[n] = radio_codec_encode(&codec, &flight[n * FRAME_SAMPLES], FRAME_SAMPLES,
+                                        (n % KEYFRAME_PERIOD) == 0u, frames[n], sizeof(frames[n]));
+        total += lengths[n];
+    }
+
+    return total;
+}
+
+/* ============================================================= ==
+   tests
+== ============================================================= */
+/** ************************************************************* *
+ * @brief       every frame of the flight decodes to its samples
+ * 
+ * ************************************************************* **/
+static void test_round_trip(void)
+{
+    STRUCT_RADIO_CODEC_t codec;
+    STRUCT_RADIO_SAMPLE_t samples[RADIO_CODEC_MAX_SAMPLES];
+    uint32_t nb;
+    uint32_t errors = 0;
+
+    encode_flight();
+    radio_codec_init(&codec);
+    for(uint32_t n = 0; n < FLIGHT_FRAMES; n++)
+    {
+        if(lengths[n] == 0u) { errors++; continue; }
+        if(radio_codec_decode(&codec, frames[n], lengths[n], samples, &nb) != E_RADIO_DECODE_OK) { errors++; continue; }
+        if(nb != FRAME_SAMPLES) { errors++; continue; }
+
+        for(uint32_t s = 0; s < nb; s++)
+        {
+            if(same(&samples[s], &flight[n * FRAME_SAMPLES + s]) == false) errors++;
+        }
+    }
+    CHECK(errors == 0u);
+}
+
+/** ************************************************************* *
+ * @brief       extreme values and deltas (wrap around of the
+ *              32 bits), every number of samples per frame
+ * 
+ * ************************************************************* **/
+static void test_extremes(void)
+{
+    static const int32_t values[] = {0, 1, -1, 63, -64, 64, -65, 8191, -8192, INT32_MAX, INT32_MIN, INT32_MAX - 1, INT32_MIN + 1};
+    const uint32_t nv = sizeof(values) / sizeof(values[0]);
+    STRUCT_RADIO_CODEC_t enc;
+    STRUCT_RADIO_CODEC_t dec;
+    STRUCT_RADIO_SAMPLE_t in[RADIO_CODEC_MAX_SAMPLES];
+    STRUCT_RADIO_SAMPLE_t out[RADIO_CODEC_MAX_SAMPLES];
+    uint8_t frame[RADIO_CODEC_FRAME_MAX(RADIO_CODEC_MAX_SAMPLES)];
+    uint32_t len;
+    uint32_t nb;
+    uint32_t errors = 0;
+
+    radio_codec_init(&enc);
+    radio_codec_init(&dec);
+    for(uint32_t n = 0; n < 1000u; n++)
+    {
+        uint32_t count = 1u + n % RADIO_CODEC_MAX_SAMPLES;
+
+        for(uint32_t s = 0; s < count; s++)
+        {
+            for(uint32_t f = 0; f < E_RADIO_FIELD_NB; f++) in[s].field[f] = values[random32() % nv];
+        }
+
+        len = radio_codec_encode(&enc, in, count, (n % 7u) == 0u, frame, sizeof(frame));
+        if(len == 0u || len > RADIO_CODEC_FRAME_MAX(count)) { errors++; continue; }
+        if(radio_codec_decode(&dec, frame, len, out, &nb) != E_RADIO_DECODE_OK || nb != count) { errors++; continue; }
+        if(memcmp(in, out, count * sizeof(STRUCT_RADIO_SAMPLE_t)) != 0) errors++;
+    }
+    CHECK(errors == 0u);
+
+    /* out of range : no frame */
+    CHECK(radio_codec_encode(&enc, in, 0u, true, frame, sizeof(frame)) == 0u);
+    CHECK(radio_codec_encode(&enc, in, RADIO_CODEC_MAX_SAMPLES + 1u, true, frame, sizeof(frame)) == 0u);
+    CHECK(radio_codec_encode(&enc, in, 2u, true, frame, RADIO_CODEC_FRAME_MAX(2u) - 1u) == 0u);
+}
+
+/** ************************************************************* *
+ * @brief       10 % of the frames lost : the delta frames are
+ *              refused after a gap up to the next keyframe, every
+ *              frame accepted decodes to its samples
+ * 
+ * ************************************************************* **/
+static void test_lost(void)
+{
+    STRUCT_RADIO_CODEC_t codec;
+    STRUCT_RADIO_SAMPLE_t samples[RADIO_CODEC_MAX_SAMPLES];
+    uint32_t nb;
+    uint32_t errors = 0;
+    uint32_t lost = 0;
+    uint32_t refused = 0;
+    uint32_t resume_max = 0;          /* [frame] longest outage */
+    uint32_t gap = 0;
+    bool synced = true;
+
+    encode_flight();
+    radio_codec_init(&codec);
+    for(uint32_t n = 0; n < FLIGHT_FRAMES; n++)
+    {
+        bool key = (n % KEYFRAME_PERIOD) == 0u;
+        ENUM_RADIO_DECODE_t result;
+
+        if(n > 0u && (random32() % 10u) == 0u)
+        {
+            lost++;
+            synced = false;
+            gap++;
+            continue;
+        }
+
+        result = radio_codec_decode(&codec, frames[n], lengths[n], samples, &nb);
+        if(key == true) synced = true;
+
+        if(synced == true)
+        {
+            if(result != E_RADIO_DECODE_OK) { errors++; continue; }
+            for(uint32_t s = 0; s < nb; s++)
+            {
+                if(same(&samples[s], &flight[n * FRAME_SAMPLES + s]) == false) errors++;
+            }
+            if(gap > resume_max) resume_max = gap;
+            gap = 0;
+        }
+        else
+        {
+            if(result != E_RADIO_DECODE_NO_KEY) errors++;
+            refused++;
+            gap++;
+        }
+    }
+    CHECK(errors == 0u);
+    CHECK(lost > 0u);
+
+    /* the longest outage is longer than a keyframe period when a
+     * keyframe is lost */
+    printf("lost frames  : %u lost, %u refused, longest outage %u frames (%u ms)\n",
+           lost, refused, resume_max, resume_max * FRAME_SAMPLES * SAMPLE_PERIOD);
+}
+
+/** ************************************************************* *
+ * @brief       every single bit flip is detected, every truncation
+ *              is refused
+ * 
+ * ************************************************************* **/
+static void test_corrupted(void)
+{
+    STRUCT_RADIO_CODEC_t codec;
+    STRUCT_RADIO_SAMPLE_t samples[RADIO_CODEC_MAX_SAMPLES];
+    uint8_t frame[RADIO_CODEC_FRAME_MAX(FRAME_SAMPLES)];
+    uint32_t nb;
+    uint32_t accepted = 0;
+
+    encode_flight();
+    for(uint32_t n = 0; n < KEYFRAME_PERIOD; n++)
+    {
+        for(uint32_t bit = 0; bit < lengths[n] * 8u; bit++)
+        {
+            memcpy(frame, frames[n], lengths[n]);
+            frame[bit / 8u] ^= (uint8_t)(1u << (bit % 8u));
+
+            radio_codec_init(&codec);
+            if(radio_codec_decode(&codec, frame, lengths[n], samples, &nb) == E_RADIO_DECODE_OK) accepted++;
+        }
+
+        for(uint32_t len = 0; len < lengths[n]; len++)
+        {
+            radio_codec_init(&codec);
+            if(radio_codec_decode(&codec, frames[n], len, samples, &nb) == E_RADIO_DECODE_OK) accepted++;
+        }
+    }
+    CHECK(accepted == 0u);
+}
+
+/** ************************************************************* *
+ * @brief       size of the frames over the flight and time of the
+ *              encoder and of the decoder
+ * 
+ * ************************************************************* **/
+static void bench(void)
+{
+    STRUCT_RADIO_CODEC_t codec;
+    STRUCT_RADIO_SAMPLE_t samples[RADIO_CODEC_MAX_SAMPLES];
+    uint32_t key_bytes = 0;
+    uint32_t delta_bytes = 0;
+    uint32_t keys = 0;
+    uint32_t total;
+    uint32_t nb;
+    uint32_t raw = FRAME_SAMPLES * RAW_SAMPLE_SIZE;
+    struct timespec t0;
+    struct timespec t1;
+    double enc_ns;
+    double dec_ns;
+
+    total = encode_flight();
+    for(uint32_t n = 0; n < FLIGHT_FRAMES; n++)
+    {
+        if((n % KEYFRAME_PERIOD) == 0u) { key_bytes += lengths[n]; keys++; }
+        else                            { delta_bytes += lengths[n]; }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for(uint32_t l = 0; l < BENCH_LOOPS; l++) encode_flight();
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    enc_ns = ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / (BENCH_LOOPS * FLIGHT_FRAMES);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for(uint32_t l = 0; l < BENCH_LOOPS; l++)
+    {
+        radio_codec_init(&codec);
+        for(uint32_t n = 0; n < FLIGHT_FRAMES; n++) (void)radio_codec_decode(&codec, frames[n], lengths[n], samples, &nb);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    dec_ns = ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / (BENCH_LOOPS * FLIGHT_FRAMES);
+
+    printf("frames       : %u (%u keyframes) of %u samples\n", FLIGHT_FRAMES, keys, FRAME_SAMPLES);
+    printf("keyframe     : %.1f byte\n", (double)key_bytes / keys);
+    printf("delta frame  : %.1f byte\n", (double)delta_bytes / (FLIGHT_FRAMES - keys));
+    printf("mean         : %.1f byte/frame, raw samples %u byte (%.0f %%)\n",
+           (double)total / FLIGHT_FRAMES, raw, 100.0 * total / ((double)raw * FLIGHT_FRAMES));
+    printf("bandwidth    : %.0f byte/s (raw %u byte/s)\n",
+           (double)total / (FLIGHT_DURATION / 1000u), raw * 1000u / (FRAME_SAMPLES * SAMPLE_PERIOD));
+    printf("ratio        : %.2f\n", (double)raw * FLIGHT_FRAMES / total);
+    printf("encode       : %.0f ns/frame, decode %.0f ns/frame\n", enc_ns, dec_ns);
+
+    CHECK(total * RATIO_MIN < raw * FLIGHT_FRAMES);
+}
+
+/* ============================================================= ==
+   main
+== ============================================================= */
+int main(void)
+{
+    simulate();
+
+    test_round_trip();
+    test_extremes();
+    test_lost();
+    test_corrupted();
+    bench();
+
+    printf("%s (%u failures)\n", failures == 0u ? "PASS" : "FAIL", failures);
+    return failures == 0u ? 0 : 1;
+}
+
+/* ------------------------------------------------------------- --
+   end of file
+-- ------------------------------------------------------------- */